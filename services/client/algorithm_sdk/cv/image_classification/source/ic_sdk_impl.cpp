@@ -15,8 +15,6 @@
 
 #include "ic_sdk_impl.h"
 
-#include <algorithm>
-
 #include "aie_guard.h"
 #include "aie_retcode_inner.h"
 #include "encdec_facade.h"
@@ -25,9 +23,6 @@
 #include "plugin_helper.h"
 
 using namespace OHOS::AI;
-namespace {
-    const uint32_t MAX_IPC_BUFFER_SIZE = 25600;
-}
 
 IMPLEMENT_SINGLE_INSTANCE(IcSdkImpl);
 
@@ -87,38 +82,28 @@ int32_t IcSdkImpl::OnSyncExecute(const IcInput &inputData, DataInfo &outputInfo)
         HILOGE("[IcSdkImpl]Empty input");
         return IC_RETCODE_NULL_PARAM;
     }
+    // The whole image is sent at once, the plugin still accepts it as the slice at offset 0.
     DataInfo inputInfo = {
         .data = nullptr,
         .length = 0
     };
-    IcInput tmpImage = {
-        .data = nullptr,
-        .size = MAX_IPC_BUFFER_SIZE
-    };
     uint32_t offset = 0;
-    int32_t retCode = RETCODE_SUCCESS;
-    while (offset < inputData.size) {
-        tmpImage.data = &inputData.data[offset];
-        tmpImage.size = std::min(inputData.size - offset, MAX_IPC_BUFFER_SIZE);
-        inputInfo.data = nullptr;
-        inputInfo.length = 0;
-        outputInfo.data = nullptr;
-        outputInfo.length = 0;
-        retCode = EncdecFacade::ProcessEncode(inputInfo, icHandle_, offset, tmpImage);
-        if (retCode != RETCODE_SUCCESS) {
-            (callback_ != nullptr) ? (callback_->OnError(IC_RETCODE_SERIALIZATION_ERROR))
-                                   : HILOGD("[IcSdkImpl]No callback");
-            HILOGE("[IcSdkImpl]Failed to UnSerializeHandle");
-            return IC_RETCODE_SERIALIZATION_ERROR;
-        }
-        retCode = AieClientSyncProcess(clientInfo_, algorithmInfo_, inputInfo, outputInfo);
-        if (retCode != RETCODE_SUCCESS) {
-            (callback_ != nullptr) ? (callback_->OnError(IC_RETCODE_FAILURE))
-                                   : HILOGD("[IcSdkImpl]No callback");
-            HILOGE("[IcSdkImpl]SyncExecute AieClientSyncProcess failed");
-            return IC_RETCODE_FAILURE;
-        }
-        offset += tmpImage.size;
+    outputInfo.data = nullptr;
+    outputInfo.length = 0;
+    int32_t retCode = EncdecFacade::ProcessEncode(inputInfo, icHandle_, offset, inputData);
+    if (retCode != RETCODE_SUCCESS) {
+        (callback_ != nullptr) ? (callback_->OnError(IC_RETCODE_SERIALIZATION_ERROR))
+                               : HILOGD("[IcSdkImpl]No callback");
+        HILOGE("[IcSdkImpl]Failed to UnSerializeHandle");
+        return IC_RETCODE_SERIALIZATION_ERROR;
+    }
+    MallocPointerGuard<unsigned char> pointerGuard(inputInfo.data);
+    retCode = AieClientSyncProcess(clientInfo_, algorithmInfo_, inputInfo, outputInfo);
+    if (retCode != RETCODE_SUCCESS) {
+        (callback_ != nullptr) ? (callback_->OnError(IC_RETCODE_FAILURE))
+                               : HILOGD("[IcSdkImpl]No callback");
+        HILOGE("[IcSdkImpl]SyncExecute AieClientSyncProcess failed");
+        return IC_RETCODE_FAILURE;
     }
     return IC_RETCODE_SUCCESS;
 }
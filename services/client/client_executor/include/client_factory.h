@@ -116,6 +116,23 @@ public:
     int ClientSyncProcess(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
         const DataInfo &inputInfo, DataInfo &outputInfo);
 
+    /**
+     * Algorithmic inference interface for several inputs sent to the server in one call.
+     *
+     * Input i is executed as request algorithmInfo.requestId + i. Results of asynchronous tasks are notified
+     * to the client through callback function as {@link ClientAsyncProcess(ClientInfo, AlgorithmInfo, DataInfo)}.
+     *
+     * @param [in] clientInfo Client information.
+     * @param [in] algorithmInfo Algorithm information.
+     * @param [in] inputInfos Data information of every inference.
+     * @param [in] num Number of inputs, no more than MAX_BATCH_EXECUTE_NUM of the ipc interface.
+     * @param [out] outputInfos Algorithm inference results of synchronous tasks.
+     * @param [out] retCodes Result of every inference.
+     * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+     */
+    int ClientBatchProcess(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
+        const DataInfo *inputInfos, int num, DataInfo *outputInfos, int *retCodes);
+
     /**
      * Unload model and plugin.
      *
@@ -155,6 +172,8 @@ private:
         const DataInfo &inputInfo) = 0;
     virtual int SyncExecute(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
         const DataInfo &inputInfo, DataInfo &outputInfo) = 0;
+    virtual int BatchExecute(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
+        const DataInfo *inputInfos, int num, DataInfo *outputInfos, int *retCodes) = 0;
     virtual int SetOption(const ClientInfo &clientInfo, int optionType, const DataInfo &inputInfo) = 0;
     virtual int GetOption(const ClientInfo &clientInfo, int optionType, const DataInfo &inputInfo,
         DataInfo &outputInfo) = 0;
@@ -96,6 +96,19 @@ inline int AieClientSyncProcess(const ClientInfo &clientInfo, const AlgorithmInf
     CHK_RET(client == nullptr, RETCODE_NULL_PARAM);
     return client->ClientSyncProcess(clientInfo, algorithmInfo, inputInfo, outputInfo);
 }
+
+inline int AieClientBatchProcess(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
+    const std::vector<DataInfo> &inputInfos, std::vector<DataInfo> &outputInfos, std::vector<int> &retCodes)
+{
+    HILOGI("[IAieClient]AieClientBatchProcess.");
+    ClientFactory *client = GetClient();
+    CHK_RET(client == nullptr, RETCODE_NULL_PARAM);
+    CHK_RET(inputInfos.empty(), RETCODE_INVALID_PARAM);
+    outputInfos.assign(inputInfos.size(), DataInfo {nullptr, 0});
+    retCodes.assign(inputInfos.size(), RETCODE_FAILURE);
+    return client->ClientBatchProcess(clientInfo, algorithmInfo, inputInfos.data(), static_cast<int>(inputInfos.size()),
+        outputInfos.data(), retCodes.data());
+}
 } // namespace AI
 } // namespace OHOS
 
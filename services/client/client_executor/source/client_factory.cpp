@@ -187,6 +187,25 @@ int ClientFactory::ClientSyncProcess(const ClientInfo &clientInfo, const Algorit
     return SyncExecute(clientInfo, algorithmInfo, inputInfo, outputInfo);
 }
 
+int ClientFactory::ClientBatchProcess(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
+    const DataInfo *inputInfos, int num, DataInfo *outputInfos, int *retCodes)
+{
+    HILOGI("[ClientFactory]Begin to call ClientBatchProcess, num is %d.", num);
+    if (clientInfo.sessionId == INVALID_SESSION_ID) {
+        HILOGE("[ClientFactory]SessionId is invalid, please call Init firstly.");
+        return RETCODE_SERVER_NOT_INIT;
+    }
+    if (inputInfos == nullptr || outputInfos == nullptr || retCodes == nullptr || num <= 0) {
+        HILOGE("[ClientFactory]The batch of %d inputs is invalid.", num);
+        return RETCODE_INVALID_PARAM;
+    }
+
+    int retCode = BatchExecute(clientInfo, algorithmInfo, inputInfos, num, outputInfos, retCodes);
+    HILOGD("[ClientFactory][clientId:%d,sessionId:%d]End to call BatchExecute, result code[%d]",
+        clientId_, clientInfo.sessionId, retCode);
+    return retCode;
+}
+
 int ClientFactory::ClientRelease(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
     const DataInfo &inputInfo)
 {
@@ -129,6 +129,20 @@ public:
     int AsyncExecuteAlgorithm(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
         const DataInfo &inputInfo);
 
+    /**
+     * Call SA proxy, to execute algorithm inference of several inputs in one call.
+     *
+     * @param [in] clientInfo Client information.
+     * @param [in] algorithmInfo Algorithm information, input i is executed as request algorithmInfo.requestId + i.
+     * @param [in] inputInfos Data information of every inference.
+     * @param [in] num Number of inputs.
+     * @param [out] outputInfos Algorithm inference results of synchronous execution.
+     * @param [out] retCodes Result of every inference.
+     * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+     */
+    int BatchExecuteAlgorithm(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
+        const DataInfo *inputInfos, int num, DataInfo *outputInfos, int *retCodes);
+
     /**
      * Call SA proxy, to disconnect the client from the server, release and destroy information of the client.
      *
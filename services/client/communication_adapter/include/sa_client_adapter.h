@@ -121,6 +121,20 @@ private:
     int AsyncExecute(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
         const DataInfo &inputInfo) override;
 
+    /**
+     * Call SA client, to execute algorithm inference of several inputs in one call.
+     *
+     * @param [in] clientInfo Client information.
+     * @param [in] algorithmInfo Algorithm information.
+     * @param [in] inputInfos Data information of every inference.
+     * @param [in] num Number of inputs.
+     * @param [out] outputInfos Algorithm inference results of synchronous execution.
+     * @param [out] retCodes Result of every inference.
+     * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+     */
+    int BatchExecute(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
+        const DataInfo *inputInfos, int num, DataInfo *outputInfos, int *retCodes) override;
+
     /**
      * Call SA client, to set the configuration parameters of the engine or plugin.
      *
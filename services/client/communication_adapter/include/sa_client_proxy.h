@@ -84,6 +84,21 @@ int SyncExecAlgorithmProxy(IClientProxy &proxy, const ClientInfo &clientInfo, co
 int AsyncExecuteAlgorithmProxy(IClientProxy &proxy, const ClientInfo &clientInfo, const AlgorithmInfo &algoInfo,
     const DataInfo &inputInfo);
 
+/**
+ * Invoke SA server, to execute algorithm inference of several inputs in one call.
+ *
+ * @param [in] proxy SA proxy to call ai server interfaces.
+ * @param [in] clientInfo Client information.
+ * @param [in] algorithmInfo Algorithm information, input i is executed as request algoInfo.requestId + i.
+ * @param [in] inputInfos Data information of every inference.
+ * @param [in] num Number of inputs, no more than MAX_BATCH_EXECUTE_NUM.
+ * @param [out] outputInfos Algorithm inference results of synchronous execution.
+ * @param [out] retCodes Result of every inference.
+ * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+ */
+int BatchExecuteAlgorithmProxy(IClientProxy &proxy, const ClientInfo &clientInfo, const AlgorithmInfo &algoInfo,
+    const DataInfo *inputInfos, int num, DataInfo *outputInfos, int *retCodes);
+
 /**
  * Invoke SA server, to unload algorithm plugin and model based on algorithm information and client information.
  *
@@ -105,6 +120,16 @@ int UnloadAlgorithmProxy(IClientProxy &proxy, const ClientInfo &clientInfo, cons
  */
 int DestroyEngineProxy(IClientProxy &proxy, const ClientInfo &clientInfo);
 
+/**
+ * Invoke SA server, to register the shared memory ring of the client, once after it is initialized.
+ *
+ * @param [in] proxy SA proxy to call ai server interfaces.
+ * @param [in] clientInfo Client information.
+ * @param [in] shmId ID of the shared memory segment of the ring.
+ * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+ */
+int RegisterShmRingProxy(IClientProxy &proxy, const ClientInfo &clientInfo, int shmId);
+
 /**
  * Release SA client proxy.
  *
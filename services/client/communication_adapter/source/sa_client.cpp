@@ -28,7 +28,25 @@
 namespace OHOS {
 namespace AI {
 namespace {
-int32_t AsyncCallback(uint32_t code, IpcIo *data, IpcIo *reply, MessageOption option)
+CallbackHandle GetResultCallback()
+{
+    SaClient *client = SaClient::GetInstance();
+    if (client == nullptr) {
+        HILOGE("[SaClient]The client is nullptr, maybe out of memory.");
+        return nullptr;
+    }
+    CallbackHandle callback = client->GetSaClientResultCb();
+    if (callback == nullptr) {
+        HILOGE("[SaClient]SA client callback is nullptr, maybe Release interface is called or the callback is deleted");
+    }
+    return callback;
+}
+
+/**
+ * Read one async result from the callback message and deliver it, the result is read even without a callback
+ * to release the memory it may hold. Returns the ipc result of reading it.
+ */
+int DeliverAsyncResult(IpcIo *data, CallbackHandle callback, int &retCode)
 {
     int asyncCallbackRet;
     ReadInt32(data, &asyncCallbackRet);
@@ -41,32 +59,47 @@ int32_t AsyncCallback(uint32_t code, IpcIo *data, IpcIo *reply, MessageOption op
         .length = 0,
     };
     int ipcUnParcelRet = UnParcelDataInfo(data, &outputInfo);
-    SaClient *client = SaClient::GetInstance();
-    if (client == nullptr) {
-        HILOGE("[SaClient]The client is nullptr, maybe out of memory.");
-        FreeDataInfo(&outputInfo);
-        return RETCODE_FAILURE;
-    }
-    CallbackHandle callback = client->GetSaClientResultCb();
-    if (callback == nullptr) {
-        HILOGE("[SaClient]SA client callback is nullptr, maybe Release interface is called or the callback is deleted");
-        FreeDataInfo(&outputInfo);
-        return RETCODE_FAILURE;
-    }
     // The asynchronous callback retCode is used only when the IPC is normal.
-    int retCode = asyncCallbackRet;
+    retCode = asyncCallbackRet;
     if (ipcUnParcelRet != RETCODE_SUCCESS) {
         HILOGE("[SaClient]AsyncCallback failed, UnParcelDataInfo retCode[%d].", ipcUnParcelRet);
         // The IPC is abnormal.
         retCode = RETCODE_FAILURE;
     }
-    callback(sessionId, outputInfo, retCode, requestId);
+    if (callback == nullptr) {
+        retCode = RETCODE_FAILURE;
+    } else {
+        callback(sessionId, outputInfo, retCode, requestId);
+    }
     FreeDataInfo(&outputInfo);
-    return retCode;
+    return ipcUnParcelRet;
+}
+
+int32_t AsyncCallback(uint32_t code, IpcIo *data, IpcIo *reply, MessageOption option)
+{
+    CallbackHandle callback = GetResultCallback();
+    int retCode = RETCODE_FAILURE;
+    if (code != ON_ASYNC_PROCESS_BATCH_CODE) {
+        DeliverAsyncResult(data, callback, retCode);
+        return retCode;
+    }
+
+    // Results packed by the server are delivered in the order they were sent.
+    int num = 0;
+    ReadInt32(data, &num);
+    for (int i = 0; i < num; ++i) {
+        if (DeliverAsyncResult(data, callback, retCode) != RETCODE_SUCCESS) {
+            HILOGE("[SaClient]Fail to read async result %d of %d, the rest of them are dropped.", i, num);
+            return RETCODE_FAILURE;
+        }
+    }
+    return (callback == nullptr) ? RETCODE_FAILURE : RETCODE_SUCCESS;
 }
 
 void OnAiDead(void *arg)
 {
+    // The ring is registered with the dead server only.
+    DestroyShmRing();
     SaClient *client = SaClient::GetInstance();
     if (client == nullptr) {
         HILOGE("[SaClient]callback is null.");
@@ -128,6 +161,14 @@ int SaClient::Init(const ConfigInfo &configInfo, ClientInfo &clientInfo)
         return RETCODE_FAILURE;
     }
 
+    // Large payloads go through a ring set up once, a client without it falls back to a shm segment per payload.
+    if (CreateShmRing(clientInfo.serverUid) != RETCODE_SUCCESS) {
+        HILOGW("[SaClient]Failed to create shm ring, clientId: %d.", clientInfo.clientId);
+    } else if (RegisterShmRingProxy(*proxy_, clientInfo, GetShmRingId()) != RETCODE_SUCCESS) {
+        HILOGW("[SaClient]Failed to register shm ring, clientId: %d.", clientInfo.clientId);
+        DestroyShmRing();
+    }
+
     // Register SA Death Callback
     svc_ = SAMGR_GetRemoteIdentity(AI_SERVICE, nullptr);
     int32_t resultCode = AddDeathRecipient(svc_, OnAiDead, &clientInfo.clientId, &deadId_);
@@ -169,6 +210,17 @@ int SaClient::AsyncExecuteAlgorithm(const ClientInfo &clientInfo, const Algorith
     return AsyncExecuteAlgorithmProxy(*proxy_, clientInfo, algorithmInfo, inputInfo);
 }
 
+int SaClient::BatchExecuteAlgorithm(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
+    const DataInfo *inputInfos, int num, DataInfo *outputInfos, int *retCodes)
+{
+    if (proxy_ == nullptr) {
+        HILOGE("[SaClient]Service is nullptr, need reconnect server.");
+        return RETCODE_SA_SERVICE_EXCEPTION;
+    }
+
+    return BatchExecuteAlgorithmProxy(*proxy_, clientInfo, algorithmInfo, inputInfos, num, outputInfos, retCodes);
+}
+
 int SaClient::UnloadAlgorithm(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
     const DataInfo &inputInfo)
 {
@@ -188,6 +240,7 @@ int SaClient::Destroy(const ClientInfo &clientInfo)
     }
 
     int retCode = DestroyEngineProxy(*proxy_, clientInfo);
+    DestroyShmRing();
     (void)RemoveDeathRecipient(svc_, deadId_);
     ReleaseIUnknown(*((IUnknown *)proxy_));
     proxy_ = nullptr;
@@ -221,6 +221,15 @@ int SaClientAdapter::AsyncExecute(const ClientInfo &clientInfo, const AlgorithmI
     return saClient->AsyncExecuteAlgorithm(clientInfo, algorithmInfo, inputInfo);
 }
 
+int SaClientAdapter::BatchExecute(const ClientInfo &clientInfo, const AlgorithmInfo &algorithmInfo,
+    const DataInfo *inputInfos, int num, DataInfo *outputInfos, int *retCodes)
+{
+    HILOGI("[SaClientAdapter]Begin to call BatchExecute.");
+    SaClient *saClient = SaClient::GetInstance();
+    CHK_RET(saClient == nullptr, RETCODE_NULL_PARAM);
+    return saClient->BatchExecuteAlgorithm(clientInfo, algorithmInfo, inputInfos, num, outputInfos, retCodes);
+}
+
 int SaClientAdapter::SetOption(const ClientInfo &clientInfo, int optionType, const DataInfo &inputInfo)
 {
     HILOGI("[SaClientAdapter]Begin to call SetOption.");
@@ -18,6 +18,7 @@
 #include <pthread.h>
 
 #include "iproxy_client.h"
+#include "ohos_errno.h"
 #include "samgr_lite.h"
 
 #include "platform/os_wrapper/ipc/include/aie_ipc.h"
@@ -84,7 +85,47 @@ int CallbackBuff(void *owner, int code, IpcIo *reply)
     return notify->ipcRetCode;
 }
 
-void ParcelClientInfo(IpcIo *request, const ClientInfo &clientInfo)
+struct NotifyBatch {
+    int ipcRetCode;
+    int retCode;
+    bool isAsync;
+    int num;
+    DataInfo *outputInfos;
+    int *retCodes;
+};
+
+int CallbackBatch(void *owner, int code, IpcIo *reply)
+{
+    HILOGI("[SaClientProxy]CallbackBatch start.");
+    if (owner == nullptr) {
+        HILOGE("[SaClientProxy]CallbackBatch owner is nullptr.");
+        return RETCODE_NULL_PARAM;
+    }
+    auto notify = reinterpret_cast<struct NotifyBatch *>(owner);
+    ReadInt32(reply, &(notify->retCode));
+    int num = 0;
+    ReadInt32(reply, &num);
+    if (num != notify->num) {
+        // The server refused the batch before executing any input of it.
+        HILOGE("[SaClientProxy]The batch of %d inputs is answered with %d results.", notify->num, num);
+        notify->ipcRetCode = (notify->retCode != RETCODE_SUCCESS) ? notify->retCode : RETCODE_FAILURE;
+        return notify->ipcRetCode;
+    }
+    for (int i = 0; i < num; ++i) {
+        ReadInt32(reply, &(notify->retCodes[i]));
+        if (notify->isAsync) {
+            continue;
+        }
+        int ipcRetCode = UnParcelDataInfo(reply, &(notify->outputInfos[i]));
+        if (ipcRetCode != RETCODE_SUCCESS) {
+            notify->ipcRetCode = ipcRetCode;
+            notify->retCodes[i] = ipcRetCode;
+        }
+    }
+    return notify->ipcRetCode;
+}
+
+void ParcelClientInfo(IpcIo *request, const ClientInfo &clientInfo, RingPayloads &payloads)
 {
     WriteInt64(request, clientInfo.clientVersion);
     WriteInt32(request, clientInfo.clientId);
@@ -93,10 +134,11 @@ void ParcelClientInfo(IpcIo *request, const ClientInfo &clientInfo)
     WriteUint32(request, clientInfo.clientUid);
 
     DataInfo dataInfo {clientInfo.extendMsg, clientInfo.extendLen};
-    ParcelDataInfo(request, &dataInfo, clientInfo.serverUid);
+    ParcelRequestDataInfo(request, &dataInfo, clientInfo.serverUid, &payloads);
 }
 
-void ParcelAlgorithmInfo(IpcIo *request, const AlgorithmInfo &algorithmInfo, const uid_t serverUid)
+void ParcelAlgorithmInfo(IpcIo *request, const AlgorithmInfo &algorithmInfo, const uid_t serverUid,
+    RingPayloads &payloads)
 {
     WriteInt64(request, algorithmInfo.clientVersion);
     WriteBool(request, algorithmInfo.isAsync);
@@ -105,9 +147,33 @@ void ParcelAlgorithmInfo(IpcIo *request, const AlgorithmInfo &algorithmInfo, con
     WriteBool(request, algorithmInfo.isCloud);
     WriteInt32(request, algorithmInfo.operateId);
     WriteInt32(request, algorithmInfo.requestId);
+    WriteInt32(request, algorithmInfo.priority);
+    WriteInt32(request, algorithmInfo.timeOut);
 
     DataInfo dataInfo {algorithmInfo.extendMsg, algorithmInfo.extendLen};
-    ParcelDataInfo(request, &dataInfo, serverUid);
+    ParcelRequestDataInfo(request, &dataInfo, serverUid, &payloads);
+}
+
+/**
+ * Send a request to the server, the ring slots of its payloads are released if it does not reach the server.
+ *
+ * @return Returns 0 if the request is sent, returns a non-zero value otherwise.
+ */
+int InvokeRequest(IClientProxy &proxy, int funcId, IpcIo &request, RingPayloads &payloads, void *owner,
+    INotify notify)
+{
+    if (proxy.Invoke == nullptr) {
+        HILOGE("[SaClientProxy]Function pointer proxy.Invoke is nullptr.");
+        ReleaseRingPayloads(&payloads);
+        return RETCODE_NULL_PARAM;
+    }
+    int retCode = proxy.Invoke(&proxy, funcId, &request, owner, notify);
+    if (retCode != EC_SUCCESS) {
+        HILOGE("[SaClientProxy]Failed to send request %d, error code is [%d].", funcId, retCode);
+        ReleaseRingPayloads(&payloads);
+        return RETCODE_FAILURE;
+    }
+    return RETCODE_SUCCESS;
 }
 } // anonymous namespace
 
@@ -164,19 +230,38 @@ int DestroyEngineProxy(IClientProxy &proxy, const ClientInfo &clientInfo)
     IpcIo request;
     char data[MAX_IO_SIZE];
     IpcIoInit(&request, data, MAX_IO_SIZE, IPC_OBJECT_COUNTS);
-    ParcelClientInfo(&request, clientInfo);
+    RingPayloads payloads {};
+    ParcelClientInfo(&request, clientInfo, payloads);
 
-    if (proxy.Invoke == nullptr) {
-        HILOGE("[SaClientProxy]Function pointer proxy.Invoke is nullptr.");
-        return RETCODE_NULL_PARAM;
+    int retCode = InvokeRequest(proxy, ID_DESTROY_ENGINE, request, payloads, &owner, Callback);
+    if (retCode != RETCODE_SUCCESS) {
+        return retCode;
     }
-    proxy.Invoke(&proxy, ID_DESTROY_ENGINE, &request, &owner, Callback);
     if (owner.retCode != RETCODE_SUCCESS) {
         HILOGE("[SaClientProxy]IPC data processing failed, error code is [%d].", owner.retCode);
     }
     return owner.retCode;
 }
 
+int RegisterShmRingProxy(IClientProxy &proxy, const ClientInfo &clientInfo, int shmId)
+{
+    HILOGI("[SaClientProxy]Begin to call RegisterShmRingProxy.");
+
+    struct Notify owner = {.retCode = RETCODE_FAILURE};
+    IpcIo request;
+    char data[MAX_IO_SIZE];
+    IpcIoInit(&request, data, MAX_IO_SIZE, IPC_OBJECT_COUNTS);
+    RingPayloads payloads {};
+    ParcelClientInfo(&request, clientInfo, payloads);
+    WriteInt32(&request, shmId);
+
+    int retCode = InvokeRequest(proxy, ID_REGISTER_SHM_RING, request, payloads, &owner, Callback);
+    if (retCode != RETCODE_SUCCESS) {
+        return retCode;
+    }
+    return owner.retCode;
+}
+
 void ReleaseIUnknown(IUnknown &proxy)
 {
     HILOGI("[SaClientProxy]Begin to call ReleaseIUnknown.");
@@ -195,10 +280,11 @@ int SyncExecAlgorithmProxy(IClientProxy &proxy, const ClientInfo &clientInfo, co
     IpcIo request;
     char data[MAX_IO_SIZE];
     IpcIoInit(&request, data, MAX_IO_SIZE, IPC_OBJECT_COUNTS);
+    RingPayloads payloads {};
 
-    ParcelClientInfo(&request, clientInfo);
-    ParcelAlgorithmInfo(&request, algoInfo, clientInfo.serverUid);
-    ParcelDataInfo(&request, &inputInfo, clientInfo.serverUid);
+    ParcelClientInfo(&request, clientInfo, payloads);
+    ParcelAlgorithmInfo(&request, algoInfo, clientInfo.serverUid, payloads);
+    ParcelRequestDataInfo(&request, &inputInfo, clientInfo.serverUid, &payloads);
 
     struct NotifyBuff owner = {
         .ipcRetCode = RETCODE_SUCCESS,
@@ -206,11 +292,10 @@ int SyncExecAlgorithmProxy(IClientProxy &proxy, const ClientInfo &clientInfo, co
         .outLen = 0,
         .outBuff = nullptr,
     };
-    if (proxy.Invoke == nullptr) {
-        HILOGE("[SaClientProxy]Function pointer proxy.Invoke is nullptr.");
-        return RETCODE_NULL_PARAM;
+    int retCode = InvokeRequest(proxy, ID_SYNC_EXECUTE_ALGORITHM, request, payloads, &owner, CallbackBuff);
+    if (retCode != RETCODE_SUCCESS) {
+        return retCode;
     }
-    proxy.Invoke(&proxy, ID_SYNC_EXECUTE_ALGORITHM, &request, &owner, CallbackBuff);
 
     if (owner.ipcRetCode != RETCODE_SUCCESS) {
         HILOGE("[SaClientProxy]IPC data processing failed, error code is [%d].", owner.ipcRetCode);
@@ -229,16 +314,63 @@ int AsyncExecuteAlgorithmProxy(IClientProxy &proxy, const ClientInfo &clientInfo
     IpcIo request;
     char data[MAX_IO_SIZE];
     IpcIoInit(&request, data, MAX_IO_SIZE, IPC_OBJECT_COUNTS);
-    ParcelClientInfo(&request, clientInfo);
-    ParcelAlgorithmInfo(&request, algoInfo, clientInfo.serverUid);
-    ParcelDataInfo(&request, &inputInfo, clientInfo.serverUid);
+    RingPayloads payloads {};
+    ParcelClientInfo(&request, clientInfo, payloads);
+    ParcelAlgorithmInfo(&request, algoInfo, clientInfo.serverUid, payloads);
+    ParcelRequestDataInfo(&request, &inputInfo, clientInfo.serverUid, &payloads);
 
     struct Notify owner = {.retCode = RETCODE_FAILURE};
-    if (proxy.Invoke == nullptr) {
-        HILOGE("[SaClientProxy]Function pointer proxy.Invoke is nullptr.");
-        return RETCODE_NULL_PARAM;
+    int retCode = InvokeRequest(proxy, ID_ASYNC_EXECUTE_ALGORITHM, request, payloads, &owner, Callback);
+    if (retCode != RETCODE_SUCCESS) {
+        return retCode;
+    }
+    return owner.retCode;
+}
+
+int BatchExecuteAlgorithmProxy(IClientProxy &proxy, const ClientInfo &clientInfo, const AlgorithmInfo &algoInfo,
+    const DataInfo *inputInfos, int num, DataInfo *outputInfos, int *retCodes)
+{
+    HILOGI("[SaClientProxy]Begin to call BatchExecuteAlgorithmProxy, num is %d.", num);
+    if (inputInfos == nullptr || outputInfos == nullptr || retCodes == nullptr ||
+        num <= 0 || num > MAX_BATCH_EXECUTE_NUM) {
+        HILOGE("[SaClientProxy]The batch of %d inputs is invalid.", num);
+        return RETCODE_INVALID_PARAM;
+    }
+    for (int i = 0; i < num; ++i) {
+        outputInfos[i].data = nullptr;
+        outputInfos[i].length = 0;
+        retCodes[i] = RETCODE_FAILURE;
+    }
+
+    IpcIo request;
+    char data[MAX_IO_SIZE];
+    IpcIoInit(&request, data, MAX_IO_SIZE, IPC_OBJECT_COUNTS);
+    RingPayloads payloads {};
+
+    // The client and algorithm information is parcelled once for the whole batch.
+    ParcelClientInfo(&request, clientInfo, payloads);
+    ParcelAlgorithmInfo(&request, algoInfo, clientInfo.serverUid, payloads);
+    WriteInt32(&request, num);
+    for (int i = 0; i < num; ++i) {
+        ParcelRequestDataInfo(&request, &inputInfos[i], clientInfo.serverUid, &payloads);
+    }
+
+    struct NotifyBatch owner = {
+        .ipcRetCode = RETCODE_SUCCESS,
+        .retCode = RETCODE_FAILURE,
+        .isAsync = algoInfo.isAsync,
+        .num = num,
+        .outputInfos = outputInfos,
+        .retCodes = retCodes,
+    };
+    int retCode = InvokeRequest(proxy, ID_BATCH_EXECUTE_ALGORITHM, request, payloads, &owner, CallbackBatch);
+    if (retCode != RETCODE_SUCCESS) {
+        return retCode;
+    }
+    if (owner.ipcRetCode != RETCODE_SUCCESS) {
+        HILOGE("[SaClientProxy]IPC data processing failed, error code is [%d].", owner.ipcRetCode);
+        return owner.ipcRetCode;
     }
-    proxy.Invoke(&proxy, ID_ASYNC_EXECUTE_ALGORITHM, &request, &owner, Callback);
     return owner.retCode;
 }
 
@@ -249,21 +381,21 @@ int LoadAlgorithmProxy(IClientProxy &proxy, const ClientInfo &clientInfo, const
     IpcIo request;
     char data[MAX_IO_SIZE];
     IpcIoInit(&request, data, MAX_IO_SIZE, IPC_OBJECT_COUNTS);
+    RingPayloads payloads {};
 
-    ParcelClientInfo(&request, clientInfo);
-    ParcelAlgorithmInfo(&request, algoInfo, clientInfo.serverUid);
-    ParcelDataInfo(&request, &inputInfo, clientInfo.serverUid);
+    ParcelClientInfo(&request, clientInfo, payloads);
+    ParcelAlgorithmInfo(&request, algoInfo, clientInfo.serverUid, payloads);
+    ParcelRequestDataInfo(&request, &inputInfo, clientInfo.serverUid, &payloads);
     struct NotifyBuff owner = {
         .ipcRetCode = RETCODE_SUCCESS,
         .retCode = RETCODE_FAILURE,
         .outLen = 0,
         .outBuff = nullptr,
     };
-    if (proxy.Invoke == nullptr) {
-        HILOGE("[SaClientProxy]Function pointer proxy.Invoke is nullptr.");
-        return RETCODE_NULL_PARAM;
+    int retCode = InvokeRequest(proxy, ID_LOAD_ALGORITHM, request, payloads, &owner, CallbackBuff);
+    if (retCode != RETCODE_SUCCESS) {
+        return retCode;
     }
-    proxy.Invoke(&proxy, ID_LOAD_ALGORITHM, &request, &owner, CallbackBuff);
     if (owner.ipcRetCode != RETCODE_SUCCESS) {
         HILOGE("[SaClientProxy]IPC data processing failed, error code is [%d].", owner.ipcRetCode);
         return owner.ipcRetCode;
@@ -281,17 +413,17 @@ int UnloadAlgorithmProxy(IClientProxy &proxy, const ClientInfo &clientInfo, cons
     IpcIo request;
     char data[MAX_IO_SIZE];
     IpcIoInit(&request, data, MAX_IO_SIZE, IPC_OBJECT_COUNTS);
+    RingPayloads payloads {};
 
-    ParcelClientInfo(&request, clientInfo);
-    ParcelAlgorithmInfo(&request, algoInfo, clientInfo.serverUid);
-    ParcelDataInfo(&request, &inputInfo, clientInfo.serverUid);
+    ParcelClientInfo(&request, clientInfo, payloads);
+    ParcelAlgorithmInfo(&request, algoInfo, clientInfo.serverUid, payloads);
+    ParcelRequestDataInfo(&request, &inputInfo, clientInfo.serverUid, &payloads);
 
     struct Notify owner = {.retCode = RETCODE_FAILURE};
-    if (proxy.Invoke == nullptr) {
-        HILOGE("[SaClientProxy]Function pointer proxy.Invoke is nullptr.");
-        return RETCODE_NULL_PARAM;
+    int retCode = InvokeRequest(proxy, ID_UNLOAD_ALGORITHM, request, payloads, &owner, Callback);
+    if (retCode != RETCODE_SUCCESS) {
+        return retCode;
     }
-    proxy.Invoke(&proxy, ID_UNLOAD_ALGORITHM, &request, &owner, Callback);
     return owner.retCode;
 }
 
@@ -302,17 +434,17 @@ int SetOptionProxy(IClientProxy &proxy, const ClientInfo &clientInfo, int option
     IpcIo request;
     char data[MAX_IO_SIZE];
     IpcIoInit(&request, data, MAX_IO_SIZE, IPC_OBJECT_COUNTS);
+    RingPayloads payloads {};
 
-    ParcelClientInfo(&request, clientInfo);
+    ParcelClientInfo(&request, clientInfo, payloads);
     WriteInt32(&request, optionType);
-    ParcelDataInfo(&request, &inputInfo, clientInfo.serverUid);
+    ParcelRequestDataInfo(&request, &inputInfo, clientInfo.serverUid, &payloads);
 
     struct Notify owner = {.retCode = RETCODE_FAILURE};
-    if (proxy.Invoke == nullptr) {
-        HILOGE("[SaClientProxy]Function pointer proxy.Invoke is nullptr.");
-        return RETCODE_NULL_PARAM;
+    int retCode = InvokeRequest(proxy, ID_SET_OPTION, request, payloads, &owner, Callback);
+    if (retCode != RETCODE_SUCCESS) {
+        return retCode;
     }
-    proxy.Invoke(&proxy, ID_SET_OPTION, &request, &owner, Callback);
     return owner.retCode;
 }
 
@@ -324,10 +456,11 @@ int GetOptionProxy(IClientProxy &proxy, const ClientInfo &clientInfo, int option
     IpcIo request;
     char data[MAX_IO_SIZE];
     IpcIoInit(&request, data, MAX_IO_SIZE, IPC_OBJECT_COUNTS);
+    RingPayloads payloads {};
 
-    ParcelClientInfo(&request, clientInfo);
+    ParcelClientInfo(&request, clientInfo, payloads);
     WriteInt32(&request, optionType);
-    ParcelDataInfo(&request, &inputInfo, clientInfo.serverUid);
+    ParcelRequestDataInfo(&request, &inputInfo, clientInfo.serverUid, &payloads);
 
     struct NotifyBuff owner = {
         .ipcRetCode = RETCODE_SUCCESS,
@@ -335,11 +468,10 @@ int GetOptionProxy(IClientProxy &proxy, const ClientInfo &clientInfo, int option
         .outLen = 0,
         .outBuff = nullptr,
     };
-    if (proxy.Invoke == nullptr) {
-        HILOGE("[SaClientProxy]Function pointer proxy.Invoke is nullptr.");
-        return RETCODE_NULL_PARAM;
+    int retCode = InvokeRequest(proxy, ID_GET_OPTION, request, payloads, &owner, CallbackBuff);
+    if (retCode != RETCODE_SUCCESS) {
+        return retCode;
     }
-    proxy.Invoke(&proxy, ID_GET_OPTION, &request, &owner, CallbackBuff);
 
     if (owner.ipcRetCode != RETCODE_SUCCESS) {
         HILOGE("[SaClientProxy]IPC data processing failed, error code is [%d].", owner.ipcRetCode);
@@ -366,17 +498,17 @@ int RegisterCallbackProxy(IClientProxy &proxy, const ClientInfo &clientInfo, OnR
     IpcIo request;
     char data[MAX_IO_SIZE];
     IpcIoInit(&request, data, MAX_IO_SIZE, IPC_OBJECT_COUNTS);
+    RingPayloads payloads {};
     bool writeRemote = WriteRemoteObject(&request, &g_sid);
     if (!writeRemote) {
         HILOGE("WriteRemoteObject failed.");
         return RETCODE_FAILURE;
     }
-    ParcelClientInfo(&request, clientInfo);
-    if (proxy.Invoke == nullptr) {
-        HILOGE("[SaClientProxy]Function pointer proxy.Invoke is nullptr.");
-        return RETCODE_NULL_PARAM;
+    ParcelClientInfo(&request, clientInfo, payloads);
+    int retCode = InvokeRequest(proxy, ID_REGISTER_CALLBACK, request, payloads, &owner, Callback);
+    if (retCode != RETCODE_SUCCESS) {
+        return retCode;
     }
-    proxy.Invoke(&proxy, ID_REGISTER_CALLBACK, &request, &owner, Callback);
     return owner.retCode;
 }
 
@@ -387,14 +519,14 @@ int UnregisterCallbackProxy(IClientProxy &proxy, const ClientInfo &clientInfo)
     IpcIo request;
     char data[MAX_IO_SIZE];
     IpcIoInit(&request, data, MAX_IO_SIZE, IPC_OBJECT_COUNTS);
+    RingPayloads payloads {};
 
-    ParcelClientInfo(&request, clientInfo);
+    ParcelClientInfo(&request, clientInfo, payloads);
     struct Notify owner = {.retCode = RETCODE_FAILURE};
-    if (proxy.Invoke == nullptr) {
-        HILOGE("[SaClientProxy]Function pointer proxy.Invoke is nullptr.");
-        return RETCODE_NULL_PARAM;
+    int retCode = InvokeRequest(proxy, ID_UNREGISTER_CALLBACK, request, payloads, &owner, Callback);
+    if (retCode != RETCODE_SUCCESS) {
+        return retCode;
     }
-    proxy.Invoke(&proxy, ID_UNREGISTER_CALLBACK, &request, &owner, Callback);
     return owner.retCode;
 }
 } // namespace AI
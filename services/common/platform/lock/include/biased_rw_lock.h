@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BIASED_RW_LOCK_H
+#define BIASED_RW_LOCK_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "platform/lock/include/rw_lock.h"
+#include "utils/aie_macros.h"
+
+namespace OHOS {
+namespace AI {
+/**
+ * Reader-biased reader-writer lock, used with {@code ReadGuard} and {@code WriteGuard} like {@code RwLock}.
+ *
+ * Readers only touch the counter of their own thread slot, so concurrent readers do not contend on a shared
+ * mutex or cache line. A writer raises a pending flag, which sends new readers to the slow path, and waits for
+ * the counters of all slots to drain. Writes are meant to be rare, they cost a scan over every slot.
+ */
+class BiasedRwLock {
+    FORBID_COPY_AND_ASSIGN(BiasedRwLock);
+public:
+    BiasedRwLock();
+    ~BiasedRwLock();
+
+public:
+    /**
+     * Lock the reading operation.
+     */
+    void LockRead();
+
+    /**
+     * Lock the writing operation.
+     */
+    void LockWrite();
+
+    /**
+     * Unlock the reading operation.
+     */
+    void UnLockRead();
+
+    /**
+     * Unlock the writing operation.
+     */
+    void UnLockWrite();
+
+private:
+    static const size_t READER_SLOT_NUM = 64U;
+    static const size_t READER_SLOT_SIZE = 64U;
+
+    // Reader count of the threads mapped to one slot, each slot starts and fills its own cache line.
+    struct alignas(READER_SLOT_SIZE) ReaderSlot {
+        std::atomic<size_t> readCnt;
+    };
+
+    /**
+     * Get the slot of the calling thread, a thread keeps its slot for life so that unlock finds its count.
+     */
+    static size_t GetSlotIndex();
+
+    bool IsReadersDrained() const;
+
+    void NotifyWriter();
+
+private:
+    // operator new only guarantees the default alignment before C++17, so the slots are aligned by hand
+    // inside a buffer one slot larger than needed, whatever the alignment of the lock itself.
+    unsigned char slotBuffer_[(READER_SLOT_NUM + 1) * READER_SLOT_SIZE];
+    ReaderSlot *slots_;
+
+    // Set while a writer waits for or holds the lock.
+    std::atomic<bool> writeFlag_;
+
+    // Serializes writers.
+    std::mutex writeMutex_;
+
+    // Slow path of readers backing off a writer, and of the writer waiting for readers to drain.
+    std::mutex mutex_;
+    std::condition_variable cond_;
+};
+} // namespace AI
+} // namespace OHOS
+
+#endif // BIASED_RW_LOCK_H
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/lock/include/biased_rw_lock.h"
+
+#include <cstdint>
+#include <new>
+
+namespace OHOS {
+namespace AI {
+BiasedRwLock::BiasedRwLock()
+    : slots_(nullptr), writeFlag_(false)
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(slotBuffer_);
+    address = (address + READER_SLOT_SIZE - 1) & ~static_cast<uintptr_t>(READER_SLOT_SIZE - 1);
+    slots_ = reinterpret_cast<ReaderSlot *>(address);
+    for (size_t i = 0; i < READER_SLOT_NUM; ++i) {
+        ReaderSlot *slot = new (&slots_[i]) ReaderSlot;
+        slot->readCnt.store(0);
+    }
+}
+
+BiasedRwLock::~BiasedRwLock()
+{
+    for (size_t i = 0; i < READER_SLOT_NUM; ++i) {
+        slots_[i].~ReaderSlot();
+    }
+}
+
+size_t BiasedRwLock::GetSlotIndex()
+{
+    static std::atomic<size_t> nextIndex(0);
+    static thread_local size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed) % READER_SLOT_NUM;
+    return index;
+}
+
+void BiasedRwLock::LockRead()
+{
+    ReaderSlot &slot = slots_[GetSlotIndex()];
+    while (true) {
+        // Publish the read before checking for a writer, a writer raises its flag before scanning the slots,
+        // so either the writer sees this count or this reader sees the flag.
+        slot.readCnt.fetch_add(1);
+        if (!writeFlag_.load()) {
+            return;
+        }
+
+        // Back off so the writer can drain, and retry once it is gone.
+        slot.readCnt.fetch_sub(1);
+        NotifyWriter();
+        std::unique_lock<std::mutex> guard(mutex_);
+        cond_.wait(guard, [this]()->bool { return !writeFlag_.load(); });
+    }
+}
+
+void BiasedRwLock::UnLockRead()
+{
+    slots_[GetSlotIndex()].readCnt.fetch_sub(1);
+    if (writeFlag_.load()) {
+        NotifyWriter();
+    }
+}
+
+void BiasedRwLock::LockWrite()
+{
+    writeMutex_.lock();
+    writeFlag_.store(true);
+    std::unique_lock<std::mutex> guard(mutex_);
+    cond_.wait(guard, [this]()->bool { return IsReadersDrained(); });
+}
+
+void BiasedRwLock::UnLockWrite()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        writeFlag_.store(false);
+    }
+    cond_.notify_all();
+    writeMutex_.unlock();
+}
+
+bool BiasedRwLock::IsReadersDrained() const
+{
+    for (size_t i = 0; i < READER_SLOT_NUM; ++i) {
+        if (slots_[i].readCnt.load() != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BiasedRwLock::NotifyWriter()
+{
+    // Notify under the mutex, the writer checks the counters under it and cannot miss the wakeup.
+    std::lock_guard<std::mutex> guard(mutex_);
+    cond_.notify_all();
+}
+} // namespace AI
+} // namespace OHOS
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+#include "utils/aie_macros.h"
+
+namespace OHOS {
+namespace AI {
+// Number of free blocks a thread keeps before handing half of them to the shared depot.
+const size_t OBJECT_POOL_LOCAL_CACHE_SIZE = 64U;
+
+// Number of free blocks a thread takes from the shared depot at once.
+const size_t OBJECT_POOL_REFILL_SIZE = 32U;
+
+/**
+ * Free-list pool of memory blocks for objects of TYPE.
+ *
+ * Each thread allocates from and frees to its own list without locking, a shared depot balances
+ * blocks between threads which create objects and threads which destroy them. Blocks are recycled,
+ * never returned to the system, so the steady state does not call malloc.
+ */
+template<class TYPE>
+class ObjectPool {
+    FORBID_COPY_AND_ASSIGN(ObjectPool);
+    FORBID_CREATE_BY_SELF(ObjectPool);
+public:
+    /**
+     * Allocate memory for one object.
+     *
+     * @param [in] size Size of the object, blocks are only pooled for sizeof(TYPE).
+     * @return Pointer to uninitialized memory, nullptr if out of memory.
+     */
+    static void *Allocate(size_t size);
+
+    /**
+     * Free the memory returned by {@link Allocate}.
+     *
+     * @param [in] ptr Pointer to the memory, the object has been destructed.
+     * @param [in] size Size passed to {@link Allocate}.
+     */
+    static void Free(void *ptr, size_t size);
+
+    /**
+     * Query the number of allocations served by a recycled block.
+     *
+     * @return Number of pool hits.
+     */
+    static size_t HitNum();
+
+    /**
+     * Query the number of allocations falling back to the system allocator.
+     *
+     * @return Number of pool misses.
+     */
+    static size_t MissNum();
+
+private:
+    union Block {
+        Block *next;
+        alignas(TYPE) unsigned char storage[sizeof(TYPE)];
+    };
+
+    struct FreeList {
+        Block *head = nullptr;
+        size_t count = 0;
+
+        void Push(Block *block);
+        Block *Pop();
+    };
+
+    struct Depot {
+        std::mutex mutex;
+        FreeList blocks;
+
+        ~Depot();
+    };
+
+    struct LocalCache {
+        FreeList blocks;
+
+        ~LocalCache();
+    };
+
+    static Depot &GetDepot();
+    static LocalCache &GetLocalCache();
+
+    static std::atomic<size_t> hitNum_;
+    static std::atomic<size_t> missNum_;
+};
+} // namespace AI
+} // namespace OHOS
+
+/**
+ * Route new(std::nothrow) and delete of the class to {@link ObjectPool}, so that AIE_NEW and AIE_DELETE
+ * reuse pooled memory. Put it in the public section of the class.
+ */
+#define DECLARE_OBJECT_POOL_ALLOCATION(ClassName) \
+    static void *operator new(size_t size, const std::nothrow_t &) noexcept \
+    { \
+        return OHOS::AI::ObjectPool<ClassName>::Allocate(size); \
+    } \
+    static void operator delete(void *ptr, const std::nothrow_t &) noexcept \
+    { \
+        OHOS::AI::ObjectPool<ClassName>::Free(ptr, sizeof(ClassName)); \
+    } \
+    static void operator delete(void *ptr, size_t size) noexcept \
+    { \
+        OHOS::AI::ObjectPool<ClassName>::Free(ptr, size); \
+    }
+
+#include "platform/objectpool/object_pool.inl"
+
+#endif // OBJECT_POOL_H
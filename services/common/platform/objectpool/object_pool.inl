@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace OHOS {
+namespace AI {
+template<class TYPE>
+std::atomic<size_t> ObjectPool<TYPE>::hitNum_(0);
+
+template<class TYPE>
+std::atomic<size_t> ObjectPool<TYPE>::missNum_(0);
+
+template<class TYPE>
+void ObjectPool<TYPE>::FreeList::Push(Block *block) {
+    block->next = head;
+    head = block;
+    ++count;
+}
+
+template<class TYPE>
+typename ObjectPool<TYPE>::Block *ObjectPool<TYPE>::FreeList::Pop() {
+    Block *block = head;
+    if (block != nullptr) {
+        head = block->next;
+        --count;
+    }
+    return block;
+}
+
+template<class TYPE>
+ObjectPool<TYPE>::Depot::~Depot() {
+    Block *block = nullptr;
+    while ((block = blocks.Pop()) != nullptr) {
+        ::operator delete(block);
+    }
+}
+
+template<class TYPE>
+ObjectPool<TYPE>::LocalCache::~LocalCache() {
+    // The blocks of an exiting thread are left to the others.
+    Depot &depot = GetDepot();
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    Block *block = nullptr;
+    while ((block = blocks.Pop()) != nullptr) {
+        depot.blocks.Push(block);
+    }
+}
+
+template<class TYPE>
+typename ObjectPool<TYPE>::Depot &ObjectPool<TYPE>::GetDepot() {
+    static Depot depot;
+    return depot;
+}
+
+template<class TYPE>
+typename ObjectPool<TYPE>::LocalCache &ObjectPool<TYPE>::GetLocalCache() {
+    // The depot is constructed first, so that it outlives the caches of all threads.
+    static Depot &depot = GetDepot();
+    (void)depot;
+    static thread_local LocalCache cache;
+    return cache;
+}
+
+template<class TYPE>
+void *ObjectPool<TYPE>::Allocate(size_t size) {
+    if (size != sizeof(TYPE)) {
+        missNum_.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size, std::nothrow);
+    }
+
+    LocalCache &cache = GetLocalCache();
+    if (cache.blocks.head == nullptr) {
+        Depot &depot = GetDepot();
+        std::lock_guard<std::mutex> lock(depot.mutex);
+        for (size_t i = 0; i < OBJECT_POOL_REFILL_SIZE && depot.blocks.head != nullptr; ++i) {
+            cache.blocks.Push(depot.blocks.Pop());
+        }
+    }
+
+    Block *block = cache.blocks.Pop();
+    if (block == nullptr) {
+        missNum_.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(sizeof(Block), std::nothrow);
+    }
+    hitNum_.fetch_add(1, std::memory_order_relaxed);
+    return block;
+}
+
+template<class TYPE>
+void ObjectPool<TYPE>::Free(void *ptr, size_t size) {
+    CHK_RET_NONE(ptr == nullptr);
+    if (size != sizeof(TYPE)) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    LocalCache &cache = GetLocalCache();
+    cache.blocks.Push(static_cast<Block*>(ptr));
+    if (cache.blocks.count <= OBJECT_POOL_LOCAL_CACHE_SIZE) {
+        return;
+    }
+    Depot &depot = GetDepot();
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    while (cache.blocks.count > OBJECT_POOL_LOCAL_CACHE_SIZE / 2) {
+        depot.blocks.Push(cache.blocks.Pop());
+    }
+}
+
+template<class TYPE>
+size_t ObjectPool<TYPE>::HitNum() {
+    return hitNum_;
+}
+
+template<class TYPE>
+size_t ObjectPool<TYPE>::MissNum() {
+    return missNum_;
+}
+} // namespace AI
+} // namespace OHOS
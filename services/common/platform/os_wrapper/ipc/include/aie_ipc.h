@@ -18,14 +18,45 @@
 
 #include "protocol/struct_definition/aie_info_define.h"
 #include "serializer.h"
+
+/**
+ * Maximum size in bytes of one memory transferred by ipc, larger memory is refused by both sides.
+ * It is configured by gn arg ai_engine_max_transfer_size.
+ */
+#ifndef AIE_MAX_TRANSFER_SIZE
+#define AIE_MAX_TRANSFER_SIZE 16777216
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * Shared memory a dataInfo unparceled in place is left in, released by {@link FreeLentDataInfo}.
+ */
+typedef struct LentPayload LentPayload;
+
+/**
+ * Most payloads one request puts in a shared memory ring, each of them takes at least one of its 64 slots.
+ */
+#define SHM_RING_MAX_PAYLOADS 64
+
+/**
+ * Payloads a request has put in the shared memory ring of this process, on the sender side.
+ * They are given back by {@link ReleaseRingPayloads} if the request does not reach the receiver.
+ */
+typedef struct {
+    int shmId;
+    int num;
+    uint32_t offsets[SHM_RING_MAX_PAYLOADS];
+    int lengths[SHM_RING_MAX_PAYLOADS];
+} RingPayloads;
+
 /**
  * Use ipc to transfer memory.
  *
  * Memory larger than IPC_MAX_TRANS_CAPACITY(200) would be transferred by shared memory, otherwise by ipc.
+ * Memory of any size up to AIE_MAX_TRANSFER_SIZE is transferred at once.
  *
  * @param [in] request Ipc handle.
  * @param [in] dataInfo Data to transfer.
@@ -34,7 +65,27 @@ extern "C" {
 void ParcelDataInfo(IpcIo *request, const DataInfo *dataInfo, const uid_t receiverUid);
 
 /**
- * Use ipc to receive memory.
+ * Use ipc to transfer memory of a request, the same as {@link ParcelDataInfo}, and keep the payload put in the
+ * shared memory ring.
+ *
+ * @param [in] request Ipc handle.
+ * @param [in] dataInfo Data to transfer.
+ * @param [in] receiverUid receiver's uid.
+ * @param [in,out] payloads Payloads of the request, zero-initialized before the first data of the request.
+ */
+void ParcelRequestDataInfo(IpcIo *request, const DataInfo *dataInfo, const uid_t receiverUid,
+    RingPayloads *payloads);
+
+/**
+ * Release the slots of the payloads a request has put in the shared memory ring, once the request has failed to
+ * reach the receiver, which would otherwise release them.
+ *
+ * @param [in,out] payloads Payloads of the request, emptied.
+ */
+void ReleaseRingPayloads(RingPayloads *payloads);
+
+/**
+ * Use ipc to receive memory, memory transferred by a shared memory ring is refused as its sender is unknown.
  * Note: the returned dataInfo must release by {@link FreeDataInfo}.
  *
  * @param [in] request Ipc handle.
@@ -43,6 +94,83 @@ void ParcelDataInfo(IpcIo *request, const DataInfo *dataInfo, const uid_t receiv
  */
 int UnParcelDataInfo(IpcIo *request, DataInfo *dataInfo);
 
+/**
+ * Use ipc to receive memory from a client, memory transferred by shared memory ring is read from the ring the client
+ * has registered by {@link RegisterShmRing}.
+ * Note: the returned dataInfo must release by {@link FreeDataInfo}.
+ *
+ * @param [in] request Ipc handle.
+ * @param [out] dataInfo Data received.
+ * @param [in] clientId ID of the client which sent the request.
+ * @param [in] clientUid calling uid of the request.
+ * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+ */
+int UnParcelClientDataInfo(IpcIo *request, DataInfo *dataInfo, int clientId, uid_t clientUid);
+
+/**
+ * Use ipc to receive memory from a client, memory transferred by shared memory is not copied but left in place.
+ * Note: the returned dataInfo must release by {@link FreeLentDataInfo} with the returned lent,
+ * the shared memory is held until then.
+ *
+ * @param [in] request Ipc handle.
+ * @param [out] dataInfo Data received.
+ * @param [in] clientId ID of the client which sent the request.
+ * @param [in] clientUid calling uid of the request.
+ * @param [out] lent Shared memory the data is left in, NULL if the data is copied.
+ * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+ */
+int UnParcelDataInfoInPlace(IpcIo *request, DataInfo *dataInfo, int clientId, uid_t clientUid, LentPayload **lent);
+
+/**
+ * Create the shared memory ring of this process for the data transferred to the receiver.
+ *
+ * Memory larger than IPC_MAX_TRANS_CAPACITY(200) is then written into the slots of the ring, and only its position
+ * is transferred by ipc. Memory which does not fit in the free slots still uses a shared memory segment of its own.
+ * The receiver only reads the ring once it is registered by {@link RegisterShmRing}.
+ *
+ * @param [in] receiverUid receiver's uid.
+ * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+ */
+int CreateShmRing(const uid_t receiverUid);
+
+/**
+ * Get the ID of the shared memory segment of the ring of this process.
+ *
+ * @return The shmId, or -1 if this process has no ring.
+ */
+int GetShmRingId(void);
+
+/**
+ * Destroy the shared memory ring of this process, if any.
+ */
+void DestroyShmRing(void);
+
+/**
+ * Accept a shared memory ring from a client, on the receiver side. The client is bound to the uid which added it.
+ *
+ * @param [in] clientId ID of the client.
+ * @param [in] clientUid calling uid of the client.
+ */
+void AddShmRingClient(int clientId, uid_t clientUid);
+
+/**
+ * Attach the shared memory ring of a client, on the receiver side. A client registers one ring, created by its uid.
+ *
+ * @param [in] clientId ID of the client.
+ * @param [in] clientUid calling uid of the request, it must be the uid the client is bound to.
+ * @param [in] shmId ID of the shared memory segment of the ring.
+ * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+ */
+int RegisterShmRing(int clientId, uid_t clientUid, int shmId);
+
+/**
+ * Detach the shared memory ring of a client and forget the client, on the receiver side.
+ * Payloads of the ring not yet freed keep it attached until {@link FreeLentDataInfo}.
+ *
+ * @param [in] clientId ID of the client.
+ */
+void RemoveShmRingClient(int clientId);
+
 /**
  * Free dataInfo.
  *
@@ -50,6 +178,14 @@ int UnParcelDataInfo(IpcIo *request, DataInfo *dataInfo);
  */
 void FreeDataInfo(DataInfo *dataInfo);
 
+/**
+ * Free dataInfo unparceled by {@link UnParcelDataInfoInPlace}, and release the shared memory it is left in.
+ *
+ * @param [in] dataInfo data to be freed.
+ * @param [in] lent Shared memory the data is left in, NULL if the data is copied.
+ */
+void FreeLentDataInfo(DataInfo *dataInfo, LentPayload *lent);
+
 #ifdef __cplusplus
 }
 #endif
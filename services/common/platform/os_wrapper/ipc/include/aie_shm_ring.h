@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AIE_SHM_RING_H
+#define AIE_SHM_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <sys/types.h>
+
+#include "utils/aie_macros.h"
+
+namespace OHOS {
+namespace AI {
+/**
+ * Shared memory segment set up once between a sender and a receiver, and reused for every payload.
+ *
+ * The data area is cut into fixed-size slots, a payload takes consecutive slots and only its offset and length go
+ * over ipc. The sender allocates slots at the head index and moves the tail index over the slots the receiver has
+ * released, so the two sides share no lock. A payload that does not fit in the free slots is left to the caller.
+ */
+class ShmRing {
+    FORBID_COPY_AND_ASSIGN(ShmRing);
+public:
+    ~ShmRing();
+
+    /**
+     * Create a ring as its sender, the receiver gets the privilege to attach it.
+     *
+     * @param [in] receiverUid receiver's uid.
+     * @return The ring, or nullptr if the shared memory cannot be set up.
+     */
+    static ShmRing *Create(uid_t receiverUid);
+
+    /**
+     * Attach a ring created by the sender, as its receiver. The segment is marked removed once attached, so that it
+     * goes away with the last of the two sides to detach it, even if the sender exits without destroying the ring.
+     *
+     * @param [in] shmId ID of the shared memory segment of the ring.
+     * @param [in] senderUid sender's uid, a segment created by any other uid is refused.
+     * @return The ring, or nullptr if the segment is not a valid ring of the sender.
+     */
+    static ShmRing *Attach(int shmId, uid_t senderUid);
+
+    int GetShmId() const;
+
+    uid_t GetReceiverUid() const;
+
+    /**
+     * Whether the sender has destroyed the ring or exited without destroying it, the receiver then only needs to
+     * detach it.
+     */
+    bool IsClosed() const;
+
+    /**
+     * Copy a payload into free slots of the ring, on the sender side.
+     *
+     * @param [in] data Payload to send.
+     * @param [in] length Length of the payload.
+     * @param [out] offset Offset of the payload in the data area of the ring.
+     * @return Returns true if the payload is written, returns false if it does not fit in the free slots.
+     */
+    bool Write(const unsigned char *data, int length, uint32_t &offset);
+
+    /**
+     * Copy a payload out of the ring and release its slots, on the receiver side.
+     * Note: the returned data must be released by free().
+     *
+     * @param [in] offset Offset of the payload in the data area of the ring.
+     * @param [in] length Length of the payload.
+     * @param [out] data Payload received.
+     * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+     */
+    int Read(uint32_t offset, int length, unsigned char *&data);
+
+    /**
+     * Get a payload in place in the ring, on the receiver side. Its slots stay busy until {@link Release}.
+     * Note: the sender may still write the memory, the receiver must not trust what it checked once to stay the same.
+     *
+     * @param [in] offset Offset of the payload in the data area of the ring.
+     * @param [in] length Length of the payload.
+     * @param [out] data Payload in the mapped ring, valid until the payload is released and the ring destroyed.
+     * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+     */
+    int Lend(uint32_t offset, int length, unsigned char *&data) const;
+
+    /**
+     * Release the slots of a payload got by {@link Lend}, on the receiver side. The sender releases those of a payload
+     * the receiver never got the same way.
+     *
+     * @param [in] offset Offset of the payload in the data area of the ring.
+     * @param [in] length Length of the payload.
+     */
+    void Release(uint32_t offset, int length);
+
+private:
+    struct Header;
+
+    ShmRing(int shmId, char *shared, bool isOwner, uid_t receiverUid);
+    bool GetSlotRange(uint32_t offset, int length, uint32_t &begin, uint32_t &num) const;
+    void ReclaimSlots();
+
+private:
+    int shmId_;
+    char *shared_;
+    Header *header_;
+    unsigned char *dataArea_;
+    bool isOwner_;
+    uid_t receiverUid_;
+
+    // Only used by the sender, the receiver releases slots through their states in the shared header.
+    std::mutex mutex_;
+    uint64_t head_;
+    uint64_t tail_;
+};
+} // namespace AI
+} // namespace OHOS
+
+#endif // AIE_SHM_RING_H
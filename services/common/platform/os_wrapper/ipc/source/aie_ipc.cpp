@@ -16,24 +16,54 @@
 #include "platform/os_wrapper/ipc/include/aie_ipc.h"
 
 #include <cstdlib>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <sys/shm.h>
 
 #include "securec.h"
 
+#include "platform/os_wrapper/ipc/include/aie_shm_ring.h"
 #include "protocol/retcode_inner/aie_retcode_inner.h"
 #include "utils/aie_guard.h"
+#include "utils/aie_macros.h"
 #include "utils/log/aie_log.h"
 
+// Memory unparceled in place in a ring or a shared memory segment, it is released by FreeLentDataInfo.
+struct LentPayload {
+    // nullptr if the memory is a shared memory segment of its own, which is removed once detached.
+    std::shared_ptr<OHOS::AI::ShmRing> ring;
+    uint32_t offset;
+    int length;
+};
+
 namespace {
 constexpr int IPC_MAX_TRANS_CAPACITY = 200; // memory beyond this limit will use shared memory
 constexpr int SHM_KEY_START = 200000; // chosen randomly
 constexpr int SHM_KEY_END   = 300000; // chosen randomly
 constexpr unsigned int SHM_READ_WRITE_PERMISSIONS = 0600U;
-constexpr int MAX_SHM_DATA_SIZE = 1024 * 1024;
+constexpr int SHM_RING_TAG = -2; // written in place of the shmId of memory transferred by the shared memory ring.
 static std::mutex g_shmKeyMutex;
 static int g_shmKey = SHM_KEY_START;
 
+// Ring this process writes into, replaced as a whole so that senders only copy it under the lock.
+std::mutex g_sendRingMutex;
+std::shared_ptr<OHOS::AI::ShmRing> g_sendRing;
+
+// Client a request comes from, the ring is found by the client and never by what the request carries.
+struct Sender {
+    int clientId;
+    uid_t uid;
+};
+
+// Client bound to the uid which added it, and the ring it has registered, nullptr until then.
+struct RecvRing {
+    uid_t uid;
+    std::shared_ptr<OHOS::AI::ShmRing> ring;
+};
+std::mutex g_recvRingMutex;
+std::map<int, RecvRing> g_recvRings;
+
 void ReleaseShmId(const int shmId)
 {
     if (shmId == -1) {
@@ -88,6 +118,10 @@ int AcquireShmSegment(int size)
  */
 void IpcIoPushSharedMemory(IpcIo *request, const DataInfo *dataInfo, const uid_t receiverUid)
 {
+    if (dataInfo->length > AIE_MAX_TRANSFER_SIZE) {
+        HILOGE("[AieIpc]Data length %d exceeds the limit %d.", dataInfo->length, AIE_MAX_TRANSFER_SIZE);
+        return;
+    }
     int shmId = AcquireShmSegment(dataInfo->length);
     if (shmId < 0) {
         HILOGE("[AieIpc]AcquireShmSegment failed.");
@@ -133,25 +167,145 @@ void IpcIoPushSharedMemory(IpcIo *request, const DataInfo *dataInfo, const uid_t
     WriteInt32(request, dataInfo->length);
 }
 
+/**
+ * Use the shared memory ring of this process to push large memory.
+ *
+ * @param [in] request Ipc handle.
+ * @param [in] dataInfo Data need to transfer.
+ * @param receiverUid receiver's uid.
+ * @param [in,out] payloads Payloads the request has put in the ring, nullptr if they are not kept.
+ * @return Returns true if the memory is pushed, returns false if the ring is missing or full.
+ */
+bool IpcIoPushShmRing(IpcIo *request, const DataInfo *dataInfo, const uid_t receiverUid, RingPayloads *payloads)
+{
+    std::shared_ptr<OHOS::AI::ShmRing> ring;
+    {
+        std::lock_guard<std::mutex> lock(g_sendRingMutex);
+        ring = g_sendRing;
+    }
+    if (ring == nullptr || ring->GetReceiverUid() != receiverUid) {
+        return false;
+    }
+    // The payloads of a request are all kept in one ring.
+    if (payloads != nullptr && (payloads->num >= SHM_RING_MAX_PAYLOADS ||
+        (payloads->num > 0 && payloads->shmId != ring->GetShmId()))) {
+        return false;
+    }
+    uint32_t offset = 0;
+    if (!ring->Write(dataInfo->data, dataInfo->length, offset)) {
+        HILOGI("[AieIpc]No free slots in the ring for length %d, use a shm segment.", dataInfo->length);
+        return false;
+    }
+    if (payloads != nullptr) {
+        payloads->shmId = ring->GetShmId();
+        payloads->offsets[payloads->num] = offset;
+        payloads->lengths[payloads->num] = dataInfo->length;
+        ++payloads->num;
+    }
+
+    WriteInt32(request, SHM_RING_TAG);
+    WriteUint32(request, offset);
+    WriteInt32(request, dataInfo->length);
+    return true;
+}
+
+/**
+ * Find the ring registered by the client of a request.
+ *
+ * @param [in] sender Client of the request, nullptr if unknown.
+ * @return The ring, or nullptr if the client has registered none or the uid is not the one it is bound to.
+ */
+std::shared_ptr<OHOS::AI::ShmRing> FindRecvRing(const Sender *sender)
+{
+    if (sender == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(g_recvRingMutex);
+    auto iter = g_recvRings.find(sender->clientId);
+    if (iter == g_recvRings.end() || iter->second.uid != sender->uid) {
+        return nullptr;
+    }
+    return iter->second.ring;
+}
+
+/**
+ * Use the shared memory ring of the sender to pop large memory.
+ *
+ * @param [in] request Ipc handle.
+ * @param [out] dataInfo Data received.
+ * @param [in] sender Client of the request, nullptr if unknown.
+ * @param [out] lent Payload the data is left in, nullptr if the data is to be copied out of the ring.
+ * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+ */
+int IpcIoPopShmRing(IpcIo *request, DataInfo *dataInfo, const Sender *sender, LentPayload **lent)
+{
+    // internal call, no need to check null.
+    uint32_t offset = 0;
+    int length = 0;
+    ReadUint32(request, &offset);
+    ReadInt32(request, &length); // make sure all data are popped out.
+
+    std::shared_ptr<OHOS::AI::ShmRing> ring = FindRecvRing(sender);
+    if (ring == nullptr) {
+        // The sender only writes into a ring the server has accepted, see RegisterShmRing.
+        HILOGE("[AieIpc]No ring is registered by the sender of the ring data.");
+        return RETCODE_FAILURE;
+    }
+    if (length != dataInfo->length || length > AIE_MAX_TRANSFER_SIZE) {
+        HILOGE("[AieIpc]Ring data length %d is invalid, %d expected.", length, dataInfo->length);
+        ring->Release(offset, length);
+        return RETCODE_FAILURE;
+    }
+    if (lent == nullptr) {
+        return ring->Read(offset, length, dataInfo->data);
+    }
+
+    // The payload holds the ring, so that it stays mapped even if the sender destroys it meanwhile.
+    LentPayload *payload = nullptr;
+    AIE_NEW(payload, LentPayload);
+    if (payload == nullptr) {
+        HILOGE("[AieIpc]Failed to new lent payload.");
+        ring->Release(offset, length);
+        return RETCODE_OUT_OF_MEMORY;
+    }
+    payload->ring = ring;
+    payload->offset = offset;
+    payload->length = length;
+    int retCode = ring->Lend(offset, length, dataInfo->data);
+    if (retCode != RETCODE_SUCCESS) {
+        AIE_DELETE(payload);
+        return retCode;
+    }
+    *lent = payload;
+    return RETCODE_SUCCESS;
+}
+
 /**
  * Use shared memory to pop large memory.
  *
  * @param [in] request Ipc handle.
  * @param [out] dataInfo Data received.
+ * @param [in] sender Client of the request, nullptr if unknown.
+ * @param [out] lent Payload the data is left in, nullptr if the data is to be copied out of the shared memory.
  * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
  */
-int IpcIoPopSharedMemory(IpcIo *request, DataInfo *dataInfo)
+int IpcIoPopSharedMemory(IpcIo *request, DataInfo *dataInfo, const Sender *sender, LentPayload **lent)
 {
     // internal call, no need to check null.
-    int shmId;
+    int shmId = -1;
     ReadInt32(request, &shmId);
+    if (shmId == SHM_RING_TAG) {
+        return IpcIoPopShmRing(request, dataInfo, sender, lent);
+    }
     ReadInt32(request, &(dataInfo->length)); // make sure all data are popped out.
 
     if (shmId == -1) {
         HILOGE("[AieIpc]shmId is invalid: %d.", shmId);
         return RETCODE_FAILURE;
     }
-    if (dataInfo->length <= 0 || dataInfo->length > MAX_SHM_DATA_SIZE) {
+    struct shmid_ds shmidDs {};
+    if (dataInfo->length <= 0 || dataInfo->length > AIE_MAX_TRANSFER_SIZE || shmctl(shmId, IPC_STAT, &shmidDs) == -1 ||
+        shmidDs.shm_segsz < static_cast<size_t>(dataInfo->length)) {
         HILOGE("[AieIpc]dataInfo->length is invalid: %d.", dataInfo->length);
         ReleaseShmId(shmId);
         return RETCODE_FAILURE;
@@ -164,6 +318,21 @@ int IpcIoPopSharedMemory(IpcIo *request, DataInfo *dataInfo)
         return RETCODE_FAILURE;
     }
 
+    if (lent != nullptr) {
+        // The segment is only marked removed, it stays mapped until FreeLentDataInfo detaches it.
+        ReleaseShmId(shmId);
+        AIE_NEW(*lent, LentPayload);
+        if (*lent == nullptr) {
+            shmdt(shared);
+            HILOGE("[AieIpc]Failed to new lent payload.");
+            return RETCODE_OUT_OF_MEMORY;
+        }
+        (*lent)->offset = 0;
+        (*lent)->length = dataInfo->length;
+        dataInfo->data = reinterpret_cast<unsigned char *>(shared);
+        return RETCODE_SUCCESS;
+    }
+
     dataInfo->data = reinterpret_cast<unsigned char *>(malloc(dataInfo->length));
     if (dataInfo->data == nullptr) {
         shmdt(shared);
@@ -229,9 +398,53 @@ int IpcIoPopMemory(IpcIo *request, DataInfo *dataInfo)
     }
     return RETCODE_SUCCESS;
 }
-} // anonymous namespace
 
-void ParcelDataInfo(IpcIo *request, const DataInfo *dataInfo, const uid_t receiverUid)
+/**
+ * Use ipc to receive memory.
+ *
+ * @param [in] request Ipc handle.
+ * @param [out] dataInfo Data received.
+ * @param [in] sender Client of the request, nullptr if unknown.
+ * @param [out] lent Payload data in shared memory is left in, nullptr if the data is to be copied out.
+ * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+ */
+int UnParcel(IpcIo *request, DataInfo *dataInfo, const Sender *sender, LentPayload **lent)
+{
+    if (request == nullptr) {
+        HILOGE("[AieIpc]The request is nullptr.");
+        return RETCODE_FAILURE;
+    }
+    if (dataInfo == nullptr) {
+        HILOGE("[AieIpc]The dataInfo is nullptr.");
+        return RETCODE_FAILURE;
+    }
+
+    ReadInt32(request, &(dataInfo->length));
+    if (dataInfo->length < 0) {
+        HILOGE("[AieIpc]The dataInfo length is invalid.");
+        return RETCODE_FAILURE;
+    }
+    if (dataInfo->length == 0) { // no following buffer to unparcel.
+        dataInfo->data = nullptr;
+        return RETCODE_SUCCESS;
+    }
+
+    if (dataInfo->length < IPC_MAX_TRANS_CAPACITY) {
+        return IpcIoPopMemory(request, dataInfo);
+    } else {
+        return IpcIoPopSharedMemory(request, dataInfo, sender, lent);
+    }
+}
+
+/**
+ * Use ipc to transfer memory.
+ *
+ * @param [in] request Ipc handle.
+ * @param [in] dataInfo Data to transfer.
+ * @param [in] receiverUid receiver's uid.
+ * @param [in,out] payloads Payloads the request has put in the ring, nullptr if they are not kept.
+ */
+void Parcel(IpcIo *request, const DataInfo *dataInfo, const uid_t receiverUid, RingPayloads *payloads)
 {
     if (dataInfo == nullptr) {
         HILOGE("[AieIpc]The dataInfo is invalid.");
@@ -259,36 +472,141 @@ void ParcelDataInfo(IpcIo *request, const DataInfo *dataInfo, const uid_t receiv
     if (dataInfo->length < IPC_MAX_TRANS_CAPACITY) {
         WriteUint32(request, static_cast<uint32_t>(dataInfo->length));
         WriteBuffer(request, dataInfo->data, static_cast<uint32_t>(dataInfo->length));
-    } else {
+    } else if (!IpcIoPushShmRing(request, dataInfo, receiverUid, payloads)) {
         IpcIoPushSharedMemory(request, dataInfo, receiverUid);
     }
 }
+} // anonymous namespace
+
+void ParcelDataInfo(IpcIo *request, const DataInfo *dataInfo, const uid_t receiverUid)
+{
+    Parcel(request, dataInfo, receiverUid, nullptr);
+}
+
+void ParcelRequestDataInfo(IpcIo *request, const DataInfo *dataInfo, const uid_t receiverUid,
+    RingPayloads *payloads)
+{
+    if (payloads == nullptr) {
+        HILOGE("[AieIpc]The payloads is nullptr.");
+        return;
+    }
+    Parcel(request, dataInfo, receiverUid, payloads);
+}
+
+void ReleaseRingPayloads(RingPayloads *payloads)
+{
+    if (payloads == nullptr || payloads->num <= 0) {
+        return;
+    }
+    std::shared_ptr<OHOS::AI::ShmRing> ring;
+    {
+        std::lock_guard<std::mutex> lock(g_sendRingMutex);
+        ring = g_sendRing;
+    }
+    // The payloads of a ring destroyed meanwhile are gone with it.
+    if (ring != nullptr && ring->GetShmId() == payloads->shmId) {
+        for (int i = 0; i < payloads->num; ++i) {
+            ring->Release(payloads->offsets[i], payloads->lengths[i]);
+        }
+    }
+    payloads->num = 0;
+}
 
 int UnParcelDataInfo(IpcIo *request, DataInfo *dataInfo)
 {
-    if (request == nullptr) {
-        HILOGE("[AieIpc]The request is nullptr.");
+    return UnParcel(request, dataInfo, nullptr, nullptr);
+}
+
+int UnParcelClientDataInfo(IpcIo *request, DataInfo *dataInfo, int clientId, uid_t clientUid)
+{
+    Sender sender = {clientId, clientUid};
+    return UnParcel(request, dataInfo, &sender, nullptr);
+}
+
+int UnParcelDataInfoInPlace(IpcIo *request, DataInfo *dataInfo, int clientId, uid_t clientUid, LentPayload **lent)
+{
+    if (lent == nullptr) {
+        HILOGE("[AieIpc]The lent is nullptr.");
         return RETCODE_FAILURE;
     }
-    if (dataInfo == nullptr) {
-        HILOGE("[AieIpc]The dataInfo is nullptr.");
+    *lent = nullptr;
+    Sender sender = {clientId, clientUid};
+    return UnParcel(request, dataInfo, &sender, lent);
+}
+
+int CreateShmRing(const uid_t receiverUid)
+{
+    std::shared_ptr<OHOS::AI::ShmRing> ring(OHOS::AI::ShmRing::Create(receiverUid));
+    if (ring == nullptr) {
+        HILOGE("[AieIpc]Failed to create shm ring.");
         return RETCODE_FAILURE;
     }
+    std::lock_guard<std::mutex> lock(g_sendRingMutex);
+    g_sendRing = ring;
+    return RETCODE_SUCCESS;
+}
 
-    ReadInt32(request, &(dataInfo->length));
-    if (dataInfo->length < 0) {
-        HILOGE("[AieIpc]The dataInfo length is invalid.");
+int GetShmRingId(void)
+{
+    std::lock_guard<std::mutex> lock(g_sendRingMutex);
+    return (g_sendRing == nullptr) ? -1 : g_sendRing->GetShmId();
+}
+
+void DestroyShmRing(void)
+{
+    // Senders still holding the ring finish with it, the last one destroys it.
+    std::shared_ptr<OHOS::AI::ShmRing> ring;
+    std::lock_guard<std::mutex> lock(g_sendRingMutex);
+    g_sendRing.swap(ring);
+}
+
+void AddShmRingClient(int clientId, uid_t clientUid)
+{
+    std::lock_guard<std::mutex> lock(g_recvRingMutex);
+    // Clients which exited without removing themselves are forgotten on the way.
+    for (auto iter = g_recvRings.begin(); iter != g_recvRings.end();) {
+        if (iter->second.ring != nullptr && iter->second.ring->IsClosed()) {
+            iter = g_recvRings.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    g_recvRings[clientId] = {clientUid, nullptr};
+}
+
+int RegisterShmRing(int clientId, uid_t clientUid, int shmId)
+{
+    std::lock_guard<std::mutex> lock(g_recvRingMutex);
+    auto iter = g_recvRings.find(clientId);
+    if (iter == g_recvRings.end() || iter->second.uid != clientUid) {
+        HILOGE("[AieIpc]Client %d is not added by uid %u.", clientId, clientUid);
         return RETCODE_FAILURE;
     }
-    if (dataInfo->length == 0) { // no following buffer to unparcel.
-        dataInfo->data = nullptr;
-        return RETCODE_SUCCESS;
+    if (iter->second.ring != nullptr) {
+        HILOGE("[AieIpc]Client %d has registered ring %d already.", clientId, iter->second.ring->GetShmId());
+        return RETCODE_FAILURE;
     }
+    std::shared_ptr<OHOS::AI::ShmRing> ring(OHOS::AI::ShmRing::Attach(shmId, clientUid));
+    if (ring == nullptr) {
+        HILOGE("[AieIpc]Failed to attach ring %d of client %d.", shmId, clientId);
+        return RETCODE_FAILURE;
+    }
+    iter->second.ring = ring;
+    return RETCODE_SUCCESS;
+}
 
-    if (dataInfo->length < IPC_MAX_TRANS_CAPACITY) {
-        return IpcIoPopMemory(request, dataInfo);
-    } else {
-        return IpcIoPopSharedMemory(request, dataInfo);
+void RemoveShmRingClient(int clientId)
+{
+    // Detached out of the lock, unless payloads of the ring still hold it.
+    std::shared_ptr<OHOS::AI::ShmRing> ring;
+    {
+        std::lock_guard<std::mutex> lock(g_recvRingMutex);
+        auto iter = g_recvRings.find(clientId);
+        if (iter == g_recvRings.end()) {
+            return;
+        }
+        ring = std::move(iter->second.ring);
+        g_recvRings.erase(iter);
     }
 }
 
@@ -299,4 +617,22 @@ void FreeDataInfo(DataInfo *dataInfo)
         dataInfo->data = nullptr;
         dataInfo->length = 0;
     }
+}
+
+void FreeLentDataInfo(DataInfo *dataInfo, LentPayload *lent)
+{
+    if (lent == nullptr) {
+        FreeDataInfo(dataInfo);
+        return;
+    }
+    if (lent->ring != nullptr) {
+        lent->ring->Release(lent->offset, lent->length);
+    } else if (dataInfo != nullptr && dataInfo->data != nullptr && shmdt(dataInfo->data) == -1) {
+        HILOGE("[AieIpc]shmdt failed: %d.", errno);
+    }
+    AIE_DELETE(lent);
+    if (dataInfo != nullptr) {
+        dataInfo->data = nullptr;
+        dataInfo->length = 0;
+    }
 }
\ No newline at end of file
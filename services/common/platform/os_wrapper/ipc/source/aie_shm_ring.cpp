@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/os_wrapper/ipc/include/aie_shm_ring.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+#include <sys/shm.h>
+#include <unistd.h>
+
+#include "securec.h"
+
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "utils/log/aie_log.h"
+
+namespace OHOS {
+namespace AI {
+namespace {
+constexpr uint32_t SHM_RING_MAGIC = 0x4149524EU;
+constexpr uint32_t SHM_RING_SLOT_NUM = 64U;
+constexpr uint32_t SHM_RING_SLOT_SIZE = 16U * 1024U; // 64 slots make a data area of 1 MB.
+constexpr uint32_t SLOT_FREE = 0U;
+constexpr uint32_t SLOT_BUSY = 1U;
+// The header takes the first page, the data area starts page aligned.
+constexpr size_t DATA_AREA_OFFSET = 4096U;
+constexpr size_t SHM_RING_SIZE = DATA_AREA_OFFSET + static_cast<size_t>(SHM_RING_SLOT_NUM) * SHM_RING_SLOT_SIZE;
+constexpr unsigned int SHM_READ_WRITE_PERMISSIONS = 0600U;
+}
+
+struct ShmRing::Header {
+    uint32_t magic;
+    uint32_t slotNum;
+    uint32_t slotSize;
+    std::atomic<uint32_t> isClosed;
+    // Set busy by the sender when a payload takes the slot, and free by the receiver once it is copied out.
+    std::atomic<uint32_t> slotStates[SHM_RING_SLOT_NUM];
+};
+
+ShmRing::ShmRing(int shmId, char *shared, bool isOwner, uid_t receiverUid)
+    : shmId_(shmId),
+      shared_(shared),
+      header_(reinterpret_cast<Header *>(shared)),
+      dataArea_(reinterpret_cast<unsigned char *>(shared) + DATA_AREA_OFFSET),
+      isOwner_(isOwner),
+      receiverUid_(receiverUid),
+      head_(0),
+      tail_(0)
+{
+    static_assert(sizeof(Header) <= DATA_AREA_OFFSET, "The ring header overlaps the data area.");
+}
+
+ShmRing::~ShmRing()
+{
+    // Removed while still attached, the segment may already be marked removed by the receiver.
+    if (isOwner_) {
+        header_->isClosed.store(1U);
+        if (shmctl(shmId_, IPC_RMID, nullptr) == -1) {
+            HILOGE("[ShmRing]shmctl IPC_RMID failed: %d.", errno);
+        }
+    }
+    if (shmdt(shared_) == -1) {
+        HILOGE("[ShmRing]shmdt failed: %d.", errno);
+    }
+}
+
+ShmRing *ShmRing::Create(uid_t receiverUid)
+{
+    int shmId = shmget(IPC_PRIVATE, SHM_RING_SIZE, SHM_READ_WRITE_PERMISSIONS | IPC_CREAT);
+    if (shmId < 0) {
+        HILOGE("[ShmRing]shmget failed: %d.", errno);
+        return nullptr;
+    }
+
+    char *shared = reinterpret_cast<char *>(shmat(shmId, nullptr, 0));
+    if (shared == reinterpret_cast<char *>(-1)) {
+        HILOGE("[ShmRing]shmat failed: %d.", errno);
+        shmctl(shmId, IPC_RMID, nullptr);
+        return nullptr;
+    }
+
+    // The creator keeps its access, the receiver becomes the owner so that it can attach the ring.
+    struct shmid_ds shmidDs {};
+    bool isPermitted = (shmctl(shmId, IPC_STAT, &shmidDs) != -1);
+    if (isPermitted) {
+        shmidDs.shm_perm.uid = receiverUid;
+        isPermitted = (shmctl(shmId, IPC_SET, &shmidDs) != -1);
+    }
+    if (!isPermitted) {
+        HILOGE("[ShmRing]shmctl failed to share the ring: %d.", errno);
+        shmdt(shared);
+        shmctl(shmId, IPC_RMID, nullptr);
+        return nullptr;
+    }
+
+    Header *header = new (shared) Header;
+    header->magic = SHM_RING_MAGIC;
+    header->slotNum = SHM_RING_SLOT_NUM;
+    header->slotSize = SHM_RING_SLOT_SIZE;
+    header->isClosed.store(0U);
+    for (auto &state : header->slotStates) {
+        state.store(SLOT_FREE);
+    }
+
+    ShmRing *ring = nullptr;
+    AIE_NEW(ring, ShmRing(shmId, shared, true, receiverUid));
+    if (ring == nullptr) {
+        HILOGE("[ShmRing]Failed to new ring.");
+        shmdt(shared);
+        shmctl(shmId, IPC_RMID, nullptr);
+        return nullptr;
+    }
+    HILOGI("[ShmRing]Create ring succeed, shmId = %d.", shmId);
+    return ring;
+}
+
+ShmRing *ShmRing::Attach(int shmId, uid_t senderUid)
+{
+    struct shmid_ds shmidDs {};
+    if (shmId < 0 || shmctl(shmId, IPC_STAT, &shmidDs) == -1) {
+        HILOGE("[ShmRing]shmctl IPC_STAT of [%d] failed: %d.", shmId, errno);
+        return nullptr;
+    }
+    // The creator uid cannot be changed, unlike the owner uid the sender hands over to the receiver.
+    if (shmidDs.shm_perm.cuid != senderUid) {
+        HILOGE("[ShmRing]Segment [%d] is not created by uid [%u].", shmId, senderUid);
+        return nullptr;
+    }
+    if (shmidDs.shm_segsz < SHM_RING_SIZE) {
+        HILOGE("[ShmRing]Segment [%d] is too small for a ring.", shmId);
+        return nullptr;
+    }
+
+    char *shared = reinterpret_cast<char *>(shmat(shmId, nullptr, 0));
+    if (shared == reinterpret_cast<char *>(-1)) {
+        HILOGE("[ShmRing]shmat failed: %d.", errno);
+        return nullptr;
+    }
+    const Header *header = reinterpret_cast<const Header *>(shared);
+    if (header->magic != SHM_RING_MAGIC || header->slotNum != SHM_RING_SLOT_NUM ||
+        header->slotSize != SHM_RING_SLOT_SIZE) {
+        HILOGE("[ShmRing]Segment [%d] is not a ring of this version.", shmId);
+        shmdt(shared);
+        return nullptr;
+    }
+
+    ShmRing *ring = nullptr;
+    AIE_NEW(ring, ShmRing(shmId, shared, false, getuid()));
+    if (ring == nullptr) {
+        HILOGE("[ShmRing]Failed to new ring.");
+        shmdt(shared);
+        return nullptr;
+    }
+    // Both sides are attached now, nobody else needs to find the segment.
+    if (shmctl(shmId, IPC_RMID, nullptr) == -1) {
+        HILOGW("[ShmRing]shmctl IPC_RMID of [%d] failed: %d.", shmId, errno);
+    }
+    return ring;
+}
+
+int ShmRing::GetShmId() const
+{
+    return shmId_;
+}
+
+uid_t ShmRing::GetReceiverUid() const
+{
+    return receiverUid_;
+}
+
+bool ShmRing::IsClosed() const
+{
+    if (header_->isClosed.load() != 0U) {
+        return true;
+    }
+    if (isOwner_) {
+        return false;
+    }
+    // A sender which exited without destroying the ring left the receiver alone attached to it.
+    struct shmid_ds shmidDs {};
+    return shmctl(shmId_, IPC_STAT, &shmidDs) != -1 && shmidDs.shm_nattch <= 1;
+}
+
+bool ShmRing::GetSlotRange(uint32_t offset, int length, uint32_t &begin, uint32_t &num) const
+{
+    if (length <= 0 || offset % SHM_RING_SLOT_SIZE != 0) {
+        return false;
+    }
+    begin = offset / SHM_RING_SLOT_SIZE;
+    num = (static_cast<uint32_t>(length) + SHM_RING_SLOT_SIZE - 1) / SHM_RING_SLOT_SIZE;
+    return begin < SHM_RING_SLOT_NUM && num <= SHM_RING_SLOT_NUM - begin;
+}
+
+void ShmRing::ReclaimSlots()
+{
+    // Slots are released out of order, the tail stops at the oldest one still being read.
+    while (tail_ < head_ && header_->slotStates[tail_ % SHM_RING_SLOT_NUM].load(std::memory_order_acquire) ==
+        SLOT_FREE) {
+        ++tail_;
+    }
+}
+
+bool ShmRing::Write(const unsigned char *data, int length, uint32_t &offset)
+{
+    uint32_t begin = 0;
+    uint32_t num = 0;
+    if (!isOwner_ || data == nullptr || !GetSlotRange(0, length, begin, num)) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        ReclaimSlots();
+        // A payload never wraps around, the slots left at the end are skipped and stay free.
+        uint64_t headIndex = head_ % SHM_RING_SLOT_NUM;
+        uint64_t skipNum = (headIndex + num > SHM_RING_SLOT_NUM) ? (SHM_RING_SLOT_NUM - headIndex) : 0;
+        if (head_ - tail_ + skipNum + num > SHM_RING_SLOT_NUM) {
+            return false;
+        }
+        head_ += skipNum;
+        begin = static_cast<uint32_t>(head_ % SHM_RING_SLOT_NUM);
+        for (uint32_t i = 0; i < num; ++i) {
+            header_->slotStates[begin + i].store(SLOT_BUSY, std::memory_order_relaxed);
+        }
+        head_ += num;
+    }
+
+    offset = begin * SHM_RING_SLOT_SIZE;
+    errno_t retCode = memcpy_s(dataArea_ + offset, num * SHM_RING_SLOT_SIZE, data, length);
+    if (retCode != EOK) {
+        HILOGE("[ShmRing]memcpy_s failed: %d.", retCode);
+        for (uint32_t i = 0; i < num; ++i) {
+            header_->slotStates[begin + i].store(SLOT_FREE, std::memory_order_release);
+        }
+        return false;
+    }
+    return true;
+}
+
+int ShmRing::Read(uint32_t offset, int length, unsigned char *&data)
+{
+    unsigned char *lent = nullptr;
+    int retCode = Lend(offset, length, lent);
+    if (retCode != RETCODE_SUCCESS) {
+        return retCode;
+    }
+
+    data = reinterpret_cast<unsigned char *>(malloc(length));
+    if (data == nullptr) {
+        HILOGE("[ShmRing]Failed to malloc memory.");
+        retCode = RETCODE_OUT_OF_MEMORY;
+    } else if (memcpy_s(data, length, lent, length) != EOK) {
+        HILOGE("[ShmRing]Failed to memory copy.");
+        free(data);
+        data = nullptr;
+        retCode = RETCODE_MEMORY_COPY_FAILURE;
+    }
+
+    // Release the slots even if the payload is lost, or the sender would never get them back.
+    Release(offset, length);
+    return retCode;
+}
+
+int ShmRing::Lend(uint32_t offset, int length, unsigned char *&data) const
+{
+    uint32_t begin = 0;
+    uint32_t num = 0;
+    if (!GetSlotRange(offset, length, begin, num)) {
+        HILOGE("[ShmRing]Payload at [%u] of length [%d] is out of the ring.", offset, length);
+        return RETCODE_FAILURE;
+    }
+    data = dataArea_ + offset;
+    return RETCODE_SUCCESS;
+}
+
+void ShmRing::Release(uint32_t offset, int length)
+{
+    uint32_t begin = 0;
+    uint32_t num = 0;
+    if (!GetSlotRange(offset, length, begin, num)) {
+        HILOGE("[ShmRing]Payload at [%u] of length [%d] is out of the ring.", offset, length);
+        return;
+    }
+    for (uint32_t i = 0; i < num; ++i) {
+        header_->slotStates[begin + i].store(SLOT_FREE, std::memory_order_release);
+    }
+}
+} // namespace AI
+} // namespace OHOS
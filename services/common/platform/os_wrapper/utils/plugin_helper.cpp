@@ -105,6 +105,25 @@ ARRAY_DATA_ENCODE_IMPL(int32_t);
 
 ARRAY_DATA_DECODE_IMPL(uint8_t);
 
+template<>
+int32_t DataDecoder::DecodeOneParameter(Array<const uint8_t> &val)
+{
+    if (val.size != 0 || val.data != nullptr) {
+        HILOGE("[PluginHelper]Fail to decode with non-empty data");
+        return RETCODE_FAILURE;
+    }
+    size_t arraySize = 0;
+    if (RecursiveDecode(arraySize) != RETCODE_SUCCESS || !Ensure(arraySize)) {
+        HILOGE("[PluginHelper]Fail to decode with illegal arraySize");
+        return RETCODE_FAILURE;
+    }
+    // Bytes are encoded one after another, so the array is the encoded data itself.
+    val.data = buffer_ + pos_;
+    val.size = arraySize;
+    pos_ += arraySize;
+    return RETCODE_SUCCESS;
+}
+
 ARRAY_DATA_DECODE_IMPL(uint16_t);
 
 ARRAY_DATA_DECODE_IMPL(uint32_t);
@@ -53,6 +53,13 @@ int32_t DataEncoder::EncodeOneParameter(const std::vector<std::pair<int32_t, int
 template<>
 int32_t DataDecoder::DecodeOneParameter(Array<uint8_t> &val);
 
+/**
+ * Decode an array of bytes without copying it, the array points into the data being decoded.
+ * Note: the array is only valid as long as that data, and must not be released.
+ */
+template<>
+int32_t DataDecoder::DecodeOneParameter(Array<const uint8_t> &val);
+
 template<>
 int32_t DataDecoder::DecodeOneParameter(Array<uint16_t> &val);
 
@@ -17,12 +17,21 @@
 #define QUEUE_H
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 #include "protocol/retcode_inner/aie_retcode_inner.h"
 #include "utils/aie_macros.h"
 
 namespace OHOS {
 namespace AI {
+// Indices written by different threads are kept on separate cache lines.
+const size_t CACHE_LINE_SIZE = 64U;
+
+/**
+ * Bounded lock-free MPMC queue, each node carries a sequence number telling whether it is readable or writable.
+ */
 template<class TYPE>
 class Queue {
     FORBID_COPY_AND_ASSIGN(Queue);
@@ -50,7 +59,7 @@ public:
      * Push a message at the rear.
      *
      * @param [in] msgBlock message to push.
-     * @return 1011 if the queue is full or 0 if success.
+     * @return 1500 if the queue is full or 0 if success.
      */
     int PushBack(TYPE &msgBlock);
 
@@ -58,10 +67,56 @@ public:
      * Pop a message from the head.
      *
      * @param [out] msgBlock message from the head.
-     * @return 1012 if the queue is empty or 0 if success.
+     * @return 1501 if the queue is empty or 0 if success.
      */
     int PopFront(TYPE &msgBlock);
 
+    /**
+     * Pop a message from the head, blocking until a message is pushed, the queue is woken up or time out.
+     *
+     * @param [out] msgBlock message from the head.
+     * @param [in] timeOut Maximum time to wait in milliseconds, wait forever if it is not greater than 0.
+     * @return 1501 if the queue is still empty or 0 if success.
+     */
+    int PopFront(TYPE &msgBlock, int timeOut);
+
+    /**
+     * Push up to num messages at the rear with a single reservation, they stay contiguous in the queue.
+     *
+     * @param [in] msgBlocks messages to push.
+     * @param [in] num number of messages in msgBlocks.
+     * @param [out] pushNum number of messages pushed, less than num if the queue gets full.
+     * @return 1500 if nothing is pushed because the queue is full or 0 if success.
+     */
+    int PushBulk(TYPE *msgBlocks, size_t num, size_t &pushNum);
+
+    /**
+     * Pop up to maxNum messages from the head with a single reservation.
+     *
+     * @param [out] msgBlocks buffer holding at least maxNum messages.
+     * @param [in] maxNum maximum number of messages to pop.
+     * @param [out] popNum number of messages popped.
+     * @return 1501 if the queue is empty or 0 if success.
+     */
+    int PopBulk(TYPE *msgBlocks, size_t maxNum, size_t &popNum);
+
+    /**
+     * Pop up to maxNum messages from the head, blocking until a message is pushed, the queue is woken up or time out.
+     *
+     * @param [out] msgBlocks buffer holding at least maxNum messages.
+     * @param [in] maxNum maximum number of messages to pop.
+     * @param [out] popNum number of messages popped.
+     * @param [in] timeOut Maximum time to wait in milliseconds, wait forever if it is not greater than 0.
+     * @return 1501 if the queue is still empty or 0 if success.
+     */
+    int PopBulk(TYPE *msgBlocks, size_t maxNum, size_t &popNum, int timeOut);
+
+    /**
+     * Wake up the consumer blocked in {@link PopFront(TYPE &msgBlock, int timeOut)} without pushing a message.
+     * It is used to stop the consumer thread promptly.
+     */
+    void Wakeup();
+
     /**
      * Query the number of elements in the queue.
      *
@@ -69,43 +124,72 @@ public:
      */
     size_t Count() const;
 
+    /**
+     * Query the maximum number of elements in the queue.
+     *
+     * @return the capacity of the queue.
+     */
+    size_t Capacity() const;
+
+    /**
+     * Estimate the memory held by a queue.
+     *
+     * @param [in] maxQueueSize Capacity of the queue.
+     * @return the number of bytes.
+     */
+    static size_t MemorySize(size_t maxQueueSize);
+
     /**
      * Reset the queue.
      */
     void Reset();
 
 private:
+    struct QueueNode {
+        /**
+         * Equals the push position when the node is writable, and push position + 1 when it is readable.
+         */
+        std::atomic<size_t> sequence;
+        TYPE node;
+    };
+
+    void NotifyWaiter();
+    void WaitReadable(int timeOut);
+
+private:
+    char padding0_[CACHE_LINE_SIZE];
+
     /**
-     * Next position to push elements to.
+     * Next position to push elements to, claimed by producers.
      */
     std::atomic<size_t> pushPos_;
+    char padding1_[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
 
     /**
-     * Next position to pop message from.
+     * Next position to pop message from, claimed by consumers.
      */
     std::atomic<size_t> popPos_;
+    char padding2_[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
 
     /**
      * Maximum message of the queue.
      */
     size_t totalNum_;
 
+    QueueNode *queue_;
+
     /**
-     * Writable message number.
+     * Number of consumers blocked in PopFront, producers only notify when it is not zero.
      */
-    std::atomic<size_t> writeAbleCount_;
+    std::atomic<size_t> waiterCount_;
 
     /**
-     * Readable message number.
+     * Set by Wakeup, cleared by Reset.
      */
-    std::atomic<size_t> readAbleCount_;
+    bool wakeup_;
 
-    struct QueueNode {
-        bool empty = true;
-        TYPE node;
-    };
-
-    QueueNode *queue_;
+    std::mutex waitMutex_;
+    std::condition_variable waitCond_;
 };
 } // namespace AI
 } // namespace OHOS
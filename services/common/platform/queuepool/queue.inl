@@ -17,9 +17,12 @@ namespace OHOS {
 namespace AI {
 template<class TYPE>
 Queue<TYPE>::Queue(size_t maxQueueSize)
-        : pushPos_(0), popPos_(0), totalNum_(maxQueueSize), writeAbleCount_(totalNum_), readAbleCount_(0) {
+        : pushPos_(0), popPos_(0), totalNum_(maxQueueSize), queue_(nullptr), waiterCount_(0), wakeup_(false) {
     AIE_NEW(queue_, QueueNode[maxQueueSize]);
     CHK_RET_NONE(queue_ == nullptr);
+    for (size_t i = 0; i < totalNum_; ++i) {
+        queue_[i].sequence.store(i, std::memory_order_relaxed);
+    }
 }
 
 template<class TYPE>
@@ -29,66 +32,216 @@ Queue<TYPE>::~Queue() {
 
 template<class TYPE>
 bool Queue<TYPE>::IsEmpty() const {
-    return readAbleCount_ == 0;
+    size_t popPos = popPos_.load(std::memory_order_acquire);
+    return queue_[popPos % totalNum_].sequence.load(std::memory_order_acquire) != popPos + 1;
 }
 
 template<class TYPE>
 bool Queue<TYPE>::IsFull() const {
-    return totalNum_ == readAbleCount_;
+    return Count() >= totalNum_;
 }
 
 template<class TYPE>
 int Queue<TYPE>::PushBack(TYPE &msgBlock) {
-    CHK_RET(writeAbleCount_ == 0, RETCODE_QUEUE_FULL);
+    size_t pushPos = pushPos_.load(std::memory_order_relaxed);
+    QueueNode *queueNode = nullptr;
+    while (true) {
+        queueNode = &queue_[pushPos % totalNum_];
+        size_t sequence = queueNode->sequence.load(std::memory_order_acquire);
+        if (sequence == pushPos) {
+            if (pushPos_.compare_exchange_weak(pushPos, pushPos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (sequence < pushPos) {
+            // The node still holds the message pushed one round before.
+            return RETCODE_QUEUE_FULL;
+        } else {
+            pushPos = pushPos_.load(std::memory_order_relaxed);
+        }
+    }
 
-    --writeAbleCount_;
-    size_t pushPos = pushPos_++ % totalNum_;
+    queueNode->node = msgBlock;
+    queueNode->sequence.store(pushPos + 1, std::memory_order_release);
+
+    NotifyWaiter();
+    return RETCODE_SUCCESS;
+}
 
-    queue_[pushPos].node = msgBlock;
-    queue_[pushPos].empty = false;
+template<class TYPE>
+int Queue<TYPE>::PopFront(TYPE &msgBlock) {
+    size_t popPos = popPos_.load(std::memory_order_relaxed);
+    QueueNode *queueNode = nullptr;
+    while (true) {
+        queueNode = &queue_[popPos % totalNum_];
+        size_t sequence = queueNode->sequence.load(std::memory_order_acquire);
+        if (sequence == popPos + 1) {
+            if (popPos_.compare_exchange_weak(popPos, popPos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (sequence < popPos + 1) {
+            // The node is not pushed yet.
+            return RETCODE_QUEUE_EMPTY;
+        } else {
+            popPos = popPos_.load(std::memory_order_relaxed);
+        }
+    }
 
-    ++readAbleCount_;
+    msgBlock = queueNode->node;
+    queueNode->sequence.store(popPos + totalNum_, std::memory_order_release);
 
     return RETCODE_SUCCESS;
 }
 
 template<class TYPE>
-int Queue<TYPE>::PopFront(TYPE &msgBlock) {
-    CHK_RET(readAbleCount_ == 0, RETCODE_QUEUE_EMPTY);
-    --readAbleCount_;
+void Queue<TYPE>::NotifyWaiter() {
+    // Pairs with the fence in PopFront(msgBlock, timeOut), either the waiter sees the message or we see the waiter.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiterCount_.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        waitCond_.notify_one();
+    }
+}
 
-    size_t popPos = popPos_ % totalNum_;
+template<class TYPE>
+int Queue<TYPE>::PushBulk(TYPE *msgBlocks, size_t num, size_t &pushNum) {
+    pushNum = 0;
+    CHK_RET(msgBlocks == nullptr || num == 0, RETCODE_NULL_PARAM);
+
+    size_t pushPos = pushPos_.load(std::memory_order_relaxed);
+    size_t claimNum = 0;
+    while (true) {
+        // Writable nodes following pushPos, a node only turns unwritable by a producer claiming it.
+        claimNum = 0;
+        while (claimNum < num && claimNum < totalNum_ &&
+            queue_[(pushPos + claimNum) % totalNum_].sequence.load(std::memory_order_acquire) == pushPos + claimNum) {
+            ++claimNum;
+        }
+        if (claimNum == 0) {
+            size_t sequence = queue_[pushPos % totalNum_].sequence.load(std::memory_order_acquire);
+            if (sequence < pushPos) {
+                return RETCODE_QUEUE_FULL;
+            }
+            pushPos = pushPos_.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (pushPos_.compare_exchange_weak(pushPos, pushPos + claimNum, std::memory_order_relaxed)) {
+            break;
+        }
+    }
 
-    if (queue_[popPos].empty) {
-        ++readAbleCount_;
-        return RETCODE_QUEUE_NODE_INVALID;
+    for (size_t i = 0; i < claimNum; ++i) {
+        QueueNode &queueNode = queue_[(pushPos + i) % totalNum_];
+        queueNode.node = msgBlocks[i];
+        queueNode.sequence.store(pushPos + i + 1, std::memory_order_release);
     }
+    pushNum = claimNum;
 
-    ++popPos_;
+    NotifyWaiter();
+    return RETCODE_SUCCESS;
+}
 
-    msgBlock = queue_[popPos].node;
-    queue_[popPos].empty = true;
+template<class TYPE>
+int Queue<TYPE>::PopBulk(TYPE *msgBlocks, size_t maxNum, size_t &popNum) {
+    popNum = 0;
+    CHK_RET(msgBlocks == nullptr || maxNum == 0, RETCODE_NULL_PARAM);
+
+    size_t popPos = popPos_.load(std::memory_order_relaxed);
+    size_t claimNum = 0;
+    while (true) {
+        // Readable nodes following popPos, a node only turns unreadable by a consumer claiming it.
+        claimNum = 0;
+        while (claimNum < maxNum && claimNum < totalNum_ &&
+            queue_[(popPos + claimNum) % totalNum_].sequence.load(std::memory_order_acquire) ==
+            popPos + claimNum + 1) {
+            ++claimNum;
+        }
+        if (claimNum == 0) {
+            size_t sequence = queue_[popPos % totalNum_].sequence.load(std::memory_order_acquire);
+            if (sequence < popPos + 1) {
+                return RETCODE_QUEUE_EMPTY;
+            }
+            popPos = popPos_.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (popPos_.compare_exchange_weak(popPos, popPos + claimNum, std::memory_order_relaxed)) {
+            break;
+        }
+    }
 
-    ++writeAbleCount_;
+    for (size_t i = 0; i < claimNum; ++i) {
+        QueueNode &queueNode = queue_[(popPos + i) % totalNum_];
+        msgBlocks[i] = queueNode.node;
+        queueNode.sequence.store(popPos + i + totalNum_, std::memory_order_release);
+    }
+    popNum = claimNum;
 
     return RETCODE_SUCCESS;
 }
 
+template<class TYPE>
+void Queue<TYPE>::WaitReadable(int timeOut) {
+    CHK_RET_NONE(!IsEmpty());
+
+    std::unique_lock<std::mutex> lock(waitMutex_);
+    ++waiterCount_;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto isReady = [this] { return !IsEmpty() || wakeup_; };
+    if (timeOut <= 0) {
+        waitCond_.wait(lock, isReady);
+    } else {
+        (void)waitCond_.wait_for(lock, std::chrono::milliseconds(timeOut), isReady);
+    }
+    --waiterCount_;
+}
+
+template<class TYPE>
+int Queue<TYPE>::PopFront(TYPE &msgBlock, int timeOut) {
+    WaitReadable(timeOut);
+    return PopFront(msgBlock);
+}
+
+template<class TYPE>
+int Queue<TYPE>::PopBulk(TYPE *msgBlocks, size_t maxNum, size_t &popNum, int timeOut) {
+    WaitReadable(timeOut);
+    return PopBulk(msgBlocks, maxNum, popNum);
+}
+
+template<class TYPE>
+void Queue<TYPE>::Wakeup() {
+    std::lock_guard<std::mutex> lock(waitMutex_);
+    wakeup_ = true;
+    waitCond_.notify_all();
+}
+
 template<class TYPE>
 size_t Queue<TYPE>::Count() const {
-    return readAbleCount_;
+    size_t popPos = popPos_.load(std::memory_order_acquire);
+    size_t pushPos = pushPos_.load(std::memory_order_acquire);
+    return (pushPos > popPos) ? (pushPos - popPos) : 0;
+}
+
+template<class TYPE>
+size_t Queue<TYPE>::Capacity() const {
+    return totalNum_;
+}
+
+template<class TYPE>
+size_t Queue<TYPE>::MemorySize(size_t maxQueueSize) {
+    return sizeof(Queue<TYPE>) + maxQueueSize * sizeof(QueueNode);
 }
 
 template<class TYPE>
 void Queue<TYPE>::Reset() {
     pushPos_ = 0;
     popPos_ = 0;
-    writeAbleCount_ = totalNum_;
-    readAbleCount_ = 0;
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        wakeup_ = false;
+    }
 
     for (size_t i = 0; i < totalNum_; ++i) {
-        queue_[i].empty = true;
+        queue_[i].sequence.store(i, std::memory_order_relaxed);
     }
 }
 } // namespace AI
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -17,6 +17,7 @@
 #define QUEUE_POOL_H
 
 #include <atomic>
+#include <chrono>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -26,14 +27,23 @@
 namespace OHOS {
 namespace AI {
 const size_t MAX_QUEUE_LENGTH = 1024U;
-const size_t MAX_QUEUE_COUNT = 10U;
+
+// Default upper limit of memory held by the busy and idle queues of a pool.
+const size_t QUEUE_POOL_MEMORY_BUDGET = 1024U * 1024U;
+
+// Queues returned to the pool are released after being idle for this long.
+const int QUEUE_IDLE_TIMEOUT_MS = 60 * 1000;
 
 template<class TYPE>
 class QueuePool {
     FORBID_COPY_AND_ASSIGN(QueuePool);
     FORBID_CREATE_BY_SELF(QueuePool);
 
-    typedef std::list<std::shared_ptr<Queue<TYPE>>> Queues;
+    struct IdleQueue {
+        std::shared_ptr<Queue<TYPE>> queue;
+        std::chrono::steady_clock::time_point idleTime;
+    };
+    typedef std::list<IdleQueue> Queues;
 public:
     /**
      * Acquire singleton instance.
@@ -49,19 +59,43 @@ public:
     static void ReleaseInstance();
 
     /**
-     * Obtain a queue from the available queue pool.
+     * Obtain a queue of the default capacity from the available queue pool.
      *
-     * @return A shared pointer to the queue obtained.
+     * @return A shared pointer to the queue obtained, nullptr if the memory budget is exhausted.
      */
     std::shared_ptr<Queue<TYPE>> Pop();
 
     /**
-     * Return the queue to the pool for management.
+     * Obtain a queue of the given capacity, an idle queue of the same capacity is reused first.
+     * Idle queues of other capacities are released if a new queue does not fit in the memory budget.
+     *
+     * @param [in] capacity Capacity of the queue.
+     * @return A shared pointer to the queue obtained, nullptr if the memory budget is exhausted.
+     */
+    std::shared_ptr<Queue<TYPE>> Pop(size_t capacity);
+
+    /**
+     * Return the queue to the pool for management, and release the queues idle for too long.
      *
      * @param [in] queue A queue to push back.
      */
     void Push(std::shared_ptr<Queue<TYPE>> &queue);
 
+    /**
+     * Release the idle queues.
+     *
+     * @param [in] idleTimeOut Only release queues idle for at least idleTimeOut milliseconds, 0 releases all.
+     * @return The number of released queues.
+     */
+    size_t Trim(int idleTimeOut);
+
+    /**
+     * Set the upper limit of memory held by the queues of the pool.
+     *
+     * @param [in] memoryBudget Number of bytes.
+     */
+    void SetMemoryBudget(size_t memoryBudget);
+
     /**
      * Query the number of currently used queues.
      *
@@ -69,6 +103,23 @@ public:
      */
     size_t BusyQueueNum() const;
 
+    /**
+     * Query the number of queues cached for reuse.
+     *
+     * @return The number of idle queues.
+     */
+    size_t IdleQueueNum();
+
+    /**
+     * Query the memory held by the busy and idle queues.
+     *
+     * @return The number of bytes.
+     */
+    size_t MemoryUsage() const;
+
+private:
+    size_t TrimLocked(int idleTimeOut, size_t requiredMemory);
+
 private:
     static std::mutex mutex_;
     static QueuePool *instance_;
@@ -78,6 +129,8 @@ private:
     std::mutex mutex4Inner_;
     Queues queues_;
     std::atomic<size_t> busyQueueNum_;
+    std::atomic<size_t> memoryUsage_;
+    size_t memoryBudget_;
 };
 } // namespace AI
 } // namespace OHOS
@@ -46,7 +46,7 @@ void QueuePool<TYPE>::ReleaseInstance() {
 
 template<class TYPE>
 QueuePool<TYPE>::QueuePool()
-        : busyQueueNum_(0) {
+        : busyQueueNum_(0), memoryUsage_(0), memoryBudget_(QUEUE_POOL_MEMORY_BUDGET) {
 }
 
 template<class TYPE>
@@ -54,46 +54,102 @@ QueuePool<TYPE>::~QueuePool() = default;
 
 template<class TYPE>
 std::shared_ptr<Queue<TYPE>> QueuePool<TYPE>::Pop() {
-    std::shared_ptr <Queue<TYPE>> queue = nullptr;
-
-    if (busyQueueNum_ >= MAX_QUEUE_COUNT) {
-        return queue;
-    }
+    return Pop(singleQueueCapacity_);
+}
 
-    ++busyQueueNum_;
+template<class TYPE>
+std::shared_ptr<Queue<TYPE>> QueuePool<TYPE>::Pop(size_t capacity) {
+    std::shared_ptr<Queue<TYPE>> queue = nullptr;
+    CHK_RET(capacity == 0, queue);
 
-    if (queues_.empty()) {
-        Queue<TYPE> *ptr = nullptr;
-        AIE_NEW(ptr, Queue<TYPE>(singleQueueCapacity_));
-        CHK_RET(ptr == nullptr, nullptr);
-        queue.reset(ptr);
+    std::lock_guard<std::mutex> guard(mutex4Inner_);
+    // Reuse the most recently returned queue of the same capacity.
+    for (auto iter = queues_.rbegin(); iter != queues_.rend(); ++iter) {
+        if (iter->queue->Capacity() == capacity) {
+            queue = iter->queue;
+            queues_.erase(std::next(iter).base());
+            ++busyQueueNum_;
+            return queue;
+        }
+    }
 
-        return queue;
+    size_t requiredMemory = Queue<TYPE>::MemorySize(capacity);
+    if (memoryUsage_ + requiredMemory > memoryBudget_) {
+        (void)TrimLocked(QUEUE_IDLE_TIMEOUT_MS, requiredMemory);
+        CHK_RET(memoryUsage_ + requiredMemory > memoryBudget_, queue);
     }
 
-    std::lock_guard<std::mutex> guard(mutex4Inner_);
-    queue = queues_.front();
-    queues_.pop_front();
+    Queue<TYPE> *ptr = nullptr;
+    AIE_NEW(ptr, Queue<TYPE>(capacity));
+    CHK_RET(ptr == nullptr, queue);
+    queue.reset(ptr);
+    memoryUsage_ += requiredMemory;
+    ++busyQueueNum_;
 
     return queue;
 }
 
 template<class TYPE>
 void QueuePool<TYPE>::Push(std::shared_ptr<Queue<TYPE>> &queue) {
+    CHK_RET_NONE(queue == nullptr);
+
+    std::lock_guard<std::mutex> guard(mutex4Inner_);
     if (busyQueueNum_ <= 0) {
         return;
     }
 
     busyQueueNum_--;
 
-    std::lock_guard<std::mutex> guard(mutex4Inner_);
     queue->Reset();
-    queues_.push_back(queue);
+    queues_.push_back({queue, std::chrono::steady_clock::now()});
+    (void)TrimLocked(QUEUE_IDLE_TIMEOUT_MS, 0);
+}
+
+template<class TYPE>
+size_t QueuePool<TYPE>::Trim(int idleTimeOut) {
+    std::lock_guard<std::mutex> guard(mutex4Inner_);
+    return TrimLocked(idleTimeOut, 0);
+}
+
+template<class TYPE>
+size_t QueuePool<TYPE>::TrimLocked(int idleTimeOut, size_t requiredMemory) {
+    // Idle queues are ordered by idle time, the oldest ones are released first.
+    size_t trimNum = 0;
+    auto now = std::chrono::steady_clock::now();
+    while (!queues_.empty()) {
+        IdleQueue &idleQueue = queues_.front();
+        bool isExpired = (now - idleQueue.idleTime) >= std::chrono::milliseconds(idleTimeOut);
+        bool isOverBudget = requiredMemory > 0 && memoryUsage_ + requiredMemory > memoryBudget_;
+        if (!isExpired && !isOverBudget) {
+            break;
+        }
+        memoryUsage_ -= Queue<TYPE>::MemorySize(idleQueue.queue->Capacity());
+        queues_.pop_front();
+        ++trimNum;
+    }
+    return trimNum;
+}
+
+template<class TYPE>
+void QueuePool<TYPE>::SetMemoryBudget(size_t memoryBudget) {
+    std::lock_guard<std::mutex> guard(mutex4Inner_);
+    memoryBudget_ = memoryBudget;
 }
 
 template<class TYPE>
 size_t QueuePool<TYPE>::BusyQueueNum() const {
     return busyQueueNum_;
 }
+
+template<class TYPE>
+size_t QueuePool<TYPE>::IdleQueueNum() {
+    std::lock_guard<std::mutex> guard(mutex4Inner_);
+    return queues_.size();
+}
+
+template<class TYPE>
+size_t QueuePool<TYPE>::MemoryUsage() const {
+    return memoryUsage_;
+}
 } // namespace AI
 } // namespace OHOS
\ No newline at end of file
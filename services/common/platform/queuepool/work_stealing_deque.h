@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "platform/queuepool/queue.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "utils/aie_macros.h"
+
+namespace OHOS {
+namespace AI {
+/**
+ * Unbounded lock-free work-stealing deque (Chase-Lev). Only the owner thread pushes and pops at the bottom,
+ * any other thread steals from the top. TYPE must be trivially copyable, e.g. a pointer.
+ */
+template<class TYPE>
+class WorkStealingDeque {
+    FORBID_COPY_AND_ASSIGN(WorkStealingDeque);
+public:
+    /**
+     * Constructor.
+     *
+     * @param [in] capacity Initial capacity, rounded up to a power of 2, the deque grows when it is full.
+     */
+    explicit WorkStealingDeque(size_t capacity);
+
+    ~WorkStealingDeque();
+
+    /**
+     * Push an element at the bottom, called by the owner thread only.
+     *
+     * @param [in] item element to push.
+     * @return 1001 if the deque fails to grow or 0 if success.
+     */
+    int Push(const TYPE &item);
+
+    /**
+     * Pop the newest element from the bottom, called by the owner thread only.
+     *
+     * @param [out] item element from the bottom.
+     * @return 1501 if the deque is empty or 0 if success.
+     */
+    int Pop(TYPE &item);
+
+    /**
+     * Steal the oldest element from the top, called by any thread.
+     *
+     * @param [out] item element from the top.
+     * @return 1501 if the deque is empty or another thread takes the element first, 0 if success.
+     */
+    int Steal(TYPE &item);
+
+    /**
+     * Check if the deque is empty, the result may be outdated when other threads are using it.
+     *
+     * @return true if empty or false if not empty.
+     */
+    bool IsEmpty() const;
+
+    /**
+     * Query the number of elements in the deque, the result may be outdated when other threads are using it.
+     *
+     * @return the number of elements in the deque.
+     */
+    size_t Count() const;
+
+private:
+    struct Buffer {
+        explicit Buffer(size_t capacity);
+        ~Buffer();
+
+        TYPE Get(int64_t pos) const;
+        void Put(int64_t pos, const TYPE &item);
+
+        size_t capacity;
+        std::atomic<TYPE> *items;
+    };
+
+    Buffer *Grow(Buffer *buffer, int64_t top, int64_t bottom);
+
+private:
+    char padding0_[CACHE_LINE_SIZE];
+
+    /**
+     * Position of the oldest element, advanced by thieves and by the owner taking the last element.
+     */
+    std::atomic<int64_t> top_;
+    char padding1_[CACHE_LINE_SIZE - sizeof(std::atomic<int64_t>)];
+
+    /**
+     * Position after the newest element, written by the owner only.
+     */
+    std::atomic<int64_t> bottom_;
+    char padding2_[CACHE_LINE_SIZE - sizeof(std::atomic<int64_t>)];
+
+    std::atomic<Buffer*> buffer_;
+
+    /**
+     * Buffers replaced by Grow, thieves may still read them so they are released with the deque.
+     */
+    std::vector<std::unique_ptr<Buffer>> retiredBuffers_;
+};
+} // namespace AI
+} // namespace OHOS
+
+#include "platform/queuepool/work_stealing_deque.inl"
+
+#endif // WORK_STEALING_DEQUE_H
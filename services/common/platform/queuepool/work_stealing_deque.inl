@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace OHOS {
+namespace AI {
+template<class TYPE>
+WorkStealingDeque<TYPE>::Buffer::Buffer(size_t capacity) : capacity(capacity), items(nullptr) {
+    AIE_NEW(items, std::atomic<TYPE>[capacity]);
+    if (items == nullptr) {
+        this->capacity = 0;
+    }
+}
+
+template<class TYPE>
+WorkStealingDeque<TYPE>::Buffer::~Buffer() {
+    AIE_DELETE_ARRAY(items);
+}
+
+template<class TYPE>
+TYPE WorkStealingDeque<TYPE>::Buffer::Get(int64_t pos) const {
+    // The capacity is a power of 2, the mask keeps wrapped positions in range.
+    return items[static_cast<size_t>(pos) & (capacity - 1)].load(std::memory_order_relaxed);
+}
+
+template<class TYPE>
+void WorkStealingDeque<TYPE>::Buffer::Put(int64_t pos, const TYPE &item) {
+    items[static_cast<size_t>(pos) & (capacity - 1)].store(item, std::memory_order_relaxed);
+}
+
+template<class TYPE>
+WorkStealingDeque<TYPE>::WorkStealingDeque(size_t capacity) : top_(0), bottom_(0), buffer_(nullptr) {
+    size_t roundedCapacity = 1;
+    while (roundedCapacity < capacity) {
+        roundedCapacity <<= 1;
+    }
+    Buffer *buffer = nullptr;
+    AIE_NEW(buffer, Buffer(roundedCapacity));
+    buffer_.store(buffer, std::memory_order_relaxed);
+}
+
+template<class TYPE>
+WorkStealingDeque<TYPE>::~WorkStealingDeque() {
+    Buffer *buffer = buffer_.load(std::memory_order_relaxed);
+    AIE_DELETE(buffer);
+}
+
+template<class TYPE>
+int WorkStealingDeque<TYPE>::Push(const TYPE &item) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Buffer *buffer = buffer_.load(std::memory_order_relaxed);
+    if (buffer == nullptr || bottom - top >= static_cast<int64_t>(buffer->capacity)) {
+        buffer = Grow(buffer, top, bottom);
+        CHK_RET(buffer == nullptr, RETCODE_OUT_OF_MEMORY);
+    }
+    buffer->Put(bottom, item);
+    // Publish the element before the new bottom, thieves reading the bottom see it.
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return RETCODE_SUCCESS;
+}
+
+template<class TYPE>
+int WorkStealingDeque<TYPE>::Pop(TYPE &item) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer *buffer = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    // Reserve the bottom element before reading the top, thieves reading the top after it skip the element.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return RETCODE_QUEUE_EMPTY;
+    }
+
+    item = buffer->Get(bottom);
+    if (top < bottom) {
+        return RETCODE_SUCCESS;
+    }
+    // The last element, race with thieves for it.
+    bool isTaken = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+        std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return isTaken ? RETCODE_SUCCESS : RETCODE_QUEUE_EMPTY;
+}
+
+template<class TYPE>
+int WorkStealingDeque<TYPE>::Steal(TYPE &item) {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    CHK_RET(top >= bottom, RETCODE_QUEUE_EMPTY);
+
+    Buffer *buffer = buffer_.load(std::memory_order_acquire);
+    item = buffer->Get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return RETCODE_QUEUE_EMPTY;
+    }
+    return RETCODE_SUCCESS;
+}
+
+template<class TYPE>
+bool WorkStealingDeque<TYPE>::IsEmpty() const {
+    return Count() == 0;
+}
+
+template<class TYPE>
+size_t WorkStealingDeque<TYPE>::Count() const {
+    int64_t top = top_.load(std::memory_order_acquire);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    return (bottom > top) ? static_cast<size_t>(bottom - top) : 0;
+}
+
+template<class TYPE>
+typename WorkStealingDeque<TYPE>::Buffer *WorkStealingDeque<TYPE>::Grow(Buffer *buffer, int64_t top,
+    int64_t bottom) {
+    size_t capacity = (buffer == nullptr || buffer->capacity == 0) ? 1 : (buffer->capacity << 1);
+    Buffer *newBuffer = nullptr;
+    AIE_NEW(newBuffer, Buffer(capacity));
+    CHK_RET(newBuffer == nullptr, nullptr);
+    if (newBuffer->capacity == 0) {
+        AIE_DELETE(newBuffer);
+        return nullptr;
+    }
+
+    for (int64_t pos = top; pos < bottom; ++pos) {
+        newBuffer->Put(pos, buffer->Get(pos));
+    }
+    if (buffer != nullptr) {
+        retiredBuffers_.emplace_back(buffer);
+    }
+    buffer_.store(newBuffer, std::memory_order_release);
+    return newBuffer;
+}
+} // namespace AI
+} // namespace OHOS
@@ -35,6 +35,21 @@ public:
      */
     static std::shared_ptr<ISemaphore> MakeShared(unsigned int count);
 
+    /**
+     * Create a semaphore from the object pool, without the control block of a shared pointer.
+     *
+     * @param [in] count Initial count of the semaphore.
+     * @return Pointer to the semaphore, nullptr if out of memory.
+     */
+    static ISemaphore *Create(unsigned int count);
+
+    /**
+     * Destroy a semaphore created by {@link Create}.
+     *
+     * @param [in, out] semaphore Semaphore to destroy, set to nullptr.
+     */
+    static void Destroy(ISemaphore *&semaphore);
+
     /**
      * wait method
      *
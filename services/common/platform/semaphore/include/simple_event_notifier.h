@@ -25,8 +25,13 @@ class SimpleEventNotifier {
 public:
     using FPDestruct = void(*) (T *&t);
     explicit SimpleEventNotifier(FPDestruct destruct = nullptr);
+    SimpleEventNotifier(SimpleEventNotifier &&other) noexcept;
     ~SimpleEventNotifier();
 
+    SimpleEventNotifier(const SimpleEventNotifier &) = delete;
+    SimpleEventNotifier &operator=(const SimpleEventNotifier &) = delete;
+    SimpleEventNotifier &operator=(SimpleEventNotifier &&) = delete;
+
     /**
      * Return the execution result to the waiting party
      *
@@ -46,7 +51,7 @@ public:
 private:
     T *value_;
     FPDestruct destruct_;
-    std::shared_ptr<ISemaphore> producer_;
+    ISemaphore *producer_;
 };
 } // namespace AI
 } // namespace OHOS
@@ -19,13 +19,22 @@ namespace OHOS {
 namespace AI {
 template<class T>
 SimpleEventNotifier<T>::SimpleEventNotifier(FPDestruct destruct)
-    : value_(nullptr), destruct_(destruct), producer_(ISemaphore::MakeShared(0))
+    : value_(nullptr), destruct_(destruct), producer_(ISemaphore::Create(0))
 {
 }
 
+template<class T>
+SimpleEventNotifier<T>::SimpleEventNotifier(SimpleEventNotifier &&other) noexcept
+    : value_(other.value_), destruct_(other.destruct_), producer_(other.producer_)
+{
+    other.value_ = nullptr;
+    other.producer_ = nullptr;
+}
+
 template<class T>
 SimpleEventNotifier<T>::~SimpleEventNotifier()
 {
+    ISemaphore::Destroy(producer_);
     CHK_RET_NONE(value_ == nullptr || destruct_ == nullptr);
     destruct_(value_);
 }
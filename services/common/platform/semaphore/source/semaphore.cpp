@@ -18,6 +18,7 @@
 #include <condition_variable>
 #include <mutex>
 
+#include "platform/objectpool/object_pool.h"
 #include "utils/constants/constants.h"
 #include "utils/inf_cast_impl.h"
 
@@ -33,6 +34,8 @@ public:
     {
     }
 
+    DECLARE_OBJECT_POOL_ALLOCATION(Semaphore);
+
     inline void Wait()
     {
         std::unique_lock<std::mutex> lock(mutex_);
@@ -80,6 +83,16 @@ std::shared_ptr<ISemaphore> ISemaphore::MakeShared(unsigned int count)
     return sp;
 }
 
+ISemaphore *ISemaphore::Create(unsigned int count)
+{
+    return SemaphoreCast::Create(count);
+}
+
+void ISemaphore::Destroy(ISemaphore *&semaphore)
+{
+    SemaphoreCast::Destroy(semaphore);
+}
+
 bool ISemaphore::Wait(const int milliSeconds)
 {
     if (milliSeconds <= 0) {
@@ -24,6 +24,14 @@ namespace AI {
 void StepSleepMs(uint32_t milliseconds);
 time_t GetCurTimeSec();
 time_t GetCurTimeMillSec();
+
+/**
+ * Get the time of a monotonic clock, which does not jump when the wall clock is changed.
+ * It is only meaningful to compare it with another value of this clock, e.g. for deadlines.
+ *
+ * @return Time in milliseconds since an unspecified point.
+ */
+long long GetSteadyTimeMillSec();
 } // namespace AI
 } // namespace OHOS
 
@@ -35,5 +35,12 @@ time_t GetCurTimeMillSec()
     std::chrono::milliseconds sec = std::chrono::duration_cast<std::chrono::milliseconds>(d);
     return sec.count();
 }
+
+long long GetSteadyTimeMillSec()
+{
+    std::chrono::steady_clock::duration d = std::chrono::steady_clock::now().time_since_epoch();
+    std::chrono::milliseconds msec = std::chrono::duration_cast<std::chrono::milliseconds>(d);
+    return msec.count();
+}
 } // namespace AI
 } // namespace OHOS
\ No newline at end of file
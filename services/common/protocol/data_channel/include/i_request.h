@@ -26,6 +26,12 @@ class IRequest {
     FORBID_COPY_AND_ASSIGN(IRequest);
     FORBID_CREATE_BY_SELF(IRequest);
 public:
+    /**
+     * Releases the message body of a request, instead of free().
+     * The lender is the one passed to {@link SetMsgReleaser} together with the releaser.
+     */
+    using MsgReleaser = void (*)(DataInfo *msg, void *lender);
+
     /**
      * Plugins prohibit the use of new, so add a create method here.
      *
@@ -112,6 +118,34 @@ public:
      */
     void SetAlgoPluginType(int type);
 
+    /**
+     * Get scheduling priority of the request.
+     *
+     * @return AlgorithmPriority of the request.
+     */
+    int GetPriority() const;
+
+    /**
+     * Set scheduling priority of the request.
+     *
+     * @param [in] priority AlgorithmPriority of the request.
+     */
+    void SetPriority(int priority);
+
+    /**
+     * Get the deadline of the request.
+     *
+     * @return Time in milliseconds as GetSteadyTimeMillSec, 0 if the request has no deadline.
+     */
+    long long GetDeadline() const;
+
+    /**
+     * Set the deadline of the request, it fails without being processed once the deadline passes.
+     *
+     * @param [in] deadline Time in milliseconds as GetSteadyTimeMillSec, 0 if the request has no deadline.
+     */
+    void SetDeadline(long long deadline);
+
     /**
      * Get the message body carried by this request.
      *
@@ -125,6 +159,22 @@ public:
      * @param [in] msg Message.
      */
     void SetMsg(const DataInfo &msg);
+
+    /**
+     * Set how the message body is released with the request, for a message not allocated by malloc().
+     *
+     * @param [in] releaser Message releaser, nullptr to release the message by free().
+     * @param [in] lender Owner of the message memory, passed back to the releaser.
+     */
+    void SetMsgReleaser(MsgReleaser releaser, void *lender);
+
+    /**
+     * Replace a message body released by a releaser with a copy allocated by malloc(), and release the original.
+     * Nothing is done for a message released by free().
+     *
+     * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+     */
+    int CopyLentMsg();
 };
 } // namespace AI
 } // namespace OHOS
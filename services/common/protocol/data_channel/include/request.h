@@ -16,6 +16,7 @@
 #ifndef REQUEST_H
 #define REQUEST_H
 
+#include "platform/objectpool/object_pool.h"
 #include "protocol/data_channel/include/i_request.h"
 
 namespace OHOS {
@@ -25,6 +26,8 @@ public:
     Request();
     ~Request();
 
+    DECLARE_OBJECT_POOL_ALLOCATION(Request);
+
     /**
      * Get inner sequence Id, which is globally unique.
      * Inner sequence Id indicates the future class, which is used to process asynchronous tasks.
@@ -110,6 +113,34 @@ public:
      */
     void SetAlgoPluginType(int type);
 
+    /**
+     * Get scheduling priority of the request.
+     *
+     * @return AlgorithmPriority of the request.
+     */
+    int GetPriority() const;
+
+    /**
+     * Set scheduling priority of the request.
+     *
+     * @param [in] priority AlgorithmPriority of the request.
+     */
+    void SetPriority(int priority);
+
+    /**
+     * Get the deadline of the request.
+     *
+     * @return Time in milliseconds as GetSteadyTimeMillSec, 0 if the request has no deadline.
+     */
+    long long GetDeadline() const;
+
+    /**
+     * Set the deadline of the request, it fails without being processed once the deadline passes.
+     *
+     * @param [in] deadline Time in milliseconds as GetSteadyTimeMillSec, 0 if the request has no deadline.
+     */
+    void SetDeadline(long long deadline);
+
     /**
      * Get the message body carried by this request.
      *
@@ -124,6 +155,22 @@ public:
      */
     void SetMsg(const DataInfo &msg);
 
+    /**
+     * Set how the message body is released with the request, for a message not allocated by malloc().
+     *
+     * @param [in] releaser Message releaser, nullptr to release the message by free().
+     * @param [in] lender Owner of the message memory, passed back to the releaser.
+     */
+    void SetMsgReleaser(IRequest::MsgReleaser releaser, void *lender);
+
+    /**
+     * Replace a message body released by a releaser with a copy allocated by malloc(), and release the original.
+     * Nothing is done for a message released by free().
+     *
+     * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+     */
+    int CopyLentMsg();
+
 private:
     long long innerSequenceId_;
     int requestId_;
@@ -131,7 +178,11 @@ private:
     uid_t clientUid_;
     long long transactionId_;
     int algoPluginType_;
+    int priority_;
+    long long deadline_;
     DataInfo msg_;
+    IRequest::MsgReleaser msgReleaser_;
+    void *msgLender_;
 };
 } // namespace AI
 } // namespace OHOS
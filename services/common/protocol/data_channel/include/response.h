@@ -18,6 +18,7 @@
 
 #include <string>
 
+#include "platform/objectpool/object_pool.h"
 #include "protocol/data_channel/include/i_request.h"
 
 namespace OHOS {
@@ -27,6 +28,8 @@ public:
     explicit Response(IRequest *request);
     ~Response();
 
+    DECLARE_OBJECT_POOL_ALLOCATION(Response);
+
     /**
      * Get request Id.
      *
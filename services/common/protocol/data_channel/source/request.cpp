@@ -15,6 +15,11 @@
 
 #include "protocol/data_channel/include/request.h"
 
+#include <cstdlib>
+
+#include "securec.h"
+
+#include "protocol/retcode_inner/aie_retcode_inner.h"
 #include "protocol/struct_definition/aie_info_define.h"
 #include "utils/inf_cast_impl.h"
 
@@ -26,7 +31,11 @@ Request::Request()
       operationId_(0),
       clientUid_(0),
       transactionId_(0),
-      algoPluginType_(0)
+      algoPluginType_(0),
+      priority_(ALGORITHM_PRIORITY_NORMAL),
+      deadline_(0),
+      msgReleaser_(nullptr),
+      msgLender_(nullptr)
 {
     msg_.data = nullptr;
     msg_.length = 0;
@@ -34,7 +43,9 @@ Request::Request()
 
 Request::~Request()
 {
-    if (msg_.data != nullptr) {
+    if (msgReleaser_ != nullptr) {
+        msgReleaser_(&msg_, msgLender_);
+    } else if (msg_.data != nullptr) {
         free(msg_.data);
         msg_.data = nullptr;
         msg_.length = 0;
@@ -101,6 +112,26 @@ void Request::SetAlgoPluginType(int type)
     algoPluginType_ = type;
 }
 
+int Request::GetPriority() const
+{
+    return priority_;
+}
+
+void Request::SetPriority(int priority)
+{
+    priority_ = priority;
+}
+
+long long Request::GetDeadline() const
+{
+    return deadline_;
+}
+
+void Request::SetDeadline(long long deadline)
+{
+    deadline_ = deadline;
+}
+
 const DataInfo &Request::GetMsg() const
 {
     return msg_;
@@ -111,6 +142,34 @@ void Request::SetMsg(const DataInfo &msg)
     msg_ = msg;
 }
 
+void Request::SetMsgReleaser(IRequest::MsgReleaser releaser, void *lender)
+{
+    msgReleaser_ = releaser;
+    msgLender_ = lender;
+}
+
+int Request::CopyLentMsg()
+{
+    if (msgReleaser_ == nullptr || msg_.data == nullptr || msg_.length <= 0) {
+        return RETCODE_SUCCESS;
+    }
+    unsigned char *data = reinterpret_cast<unsigned char *>(malloc(msg_.length));
+    if (data == nullptr) {
+        return RETCODE_OUT_OF_MEMORY;
+    }
+    errno_t retCode = memcpy_s(data, msg_.length, msg_.data, msg_.length);
+    if (retCode != EOK) {
+        free(data);
+        return RETCODE_MEMORY_COPY_FAILURE;
+    }
+    DataInfo copy = {data, msg_.length};
+    msgReleaser_(&msg_, msgLender_);
+    msg_ = copy;
+    msgReleaser_ = nullptr;
+    msgLender_ = nullptr;
+    return RETCODE_SUCCESS;
+}
+
 DEFINE_IMPL_CLASS_CAST(RequestCast, IRequest, Request);
 
 IRequest *IRequest::Create()
@@ -173,6 +232,26 @@ void IRequest::SetAlgoPluginType(int type)
     RequestCast::Ref(this).SetAlgoPluginType(type);
 }
 
+int IRequest::GetPriority() const
+{
+    return RequestCast::Ref(this).GetPriority();
+}
+
+void IRequest::SetPriority(int priority)
+{
+    RequestCast::Ref(this).SetPriority(priority);
+}
+
+long long IRequest::GetDeadline() const
+{
+    return RequestCast::Ref(this).GetDeadline();
+}
+
+void IRequest::SetDeadline(long long deadline)
+{
+    RequestCast::Ref(this).SetDeadline(deadline);
+}
+
 const DataInfo &IRequest::GetMsg() const
 {
     return RequestCast::Ref(this).GetMsg();
@@ -182,5 +261,15 @@ void IRequest::SetMsg(const DataInfo &msg)
 {
     RequestCast::Ref(this).SetMsg(msg);
 }
+
+void IRequest::SetMsgReleaser(MsgReleaser releaser, void *lender)
+{
+    RequestCast::Ref(this).SetMsgReleaser(releaser, lender);
+}
+
+int IRequest::CopyLentMsg()
+{
+    return RequestCast::Ref(this).CopyLentMsg();
+}
 } // namespace AI
 } // namespace OHOS
@@ -19,6 +19,8 @@
 #include "iproxy_client.h"
 #include "iproxy_server.h"
 
+#include "platform/os_wrapper/ipc/include/aie_ipc.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -26,6 +28,12 @@ extern "C" {
 #define AI_SERVICE "ai_service"
 #define AI_FEATURE "ai_feature"
 
+/**
+ * Max inputs of one ID_BATCH_EXECUTE_ALGORITHM call. Small inputs are parcelled inline,
+ * so a batch of them together with its results must still fit the ipc buffer.
+ */
+#define MAX_BATCH_EXECUTE_NUM 32
+
 enum FUNC_ID {
     ID_INIT_ENGINE = 0,
     ID_LOAD_ALGORITHM,
@@ -37,10 +45,13 @@ enum FUNC_ID {
     ID_GET_OPTION,
     ID_REGISTER_CALLBACK,
     ID_UNREGISTER_CALLBACK,
+    ID_BATCH_EXECUTE_ALGORITHM,
+    ID_REGISTER_SHM_RING,
 };
 
 enum CALLBACK_ID {
     ON_ASYNC_PROCESS_CODE = 0,
+    ON_ASYNC_PROCESS_BATCH_CODE,
 };
 
 typedef struct AiInterface {
@@ -72,11 +83,12 @@ typedef struct AiInterface {
      * @param [in] clientInfo Client information.
      * @param [in] algoInfo Algorithm information.
      * @param [in] inputInfo Data information needed to synchronous execution algorithm.
+     * @param [in] inputLent Shared memory the input is left in, NULL if the input is copied.
      * @param [out] outputInfo Algorithm inference results.
      * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
      */
     int (*SyncExecuteAlgorithm)(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo,
-        const DataInfo *inputInfo, DataInfo *outputInfo);
+        const DataInfo *inputInfo, LentPayload *inputLent, DataInfo *outputInfo);
 
     /**
      * @brief Algorithmic inference interface for asynchronous tasks.
@@ -84,10 +96,11 @@ typedef struct AiInterface {
      * @param [in] clientInfo Client information.
      * @param [in] algoInfo Algorithm information.
      * @param [in] inputInfo Data information needed to asynchronous execution algorithm.
+     * @param [in] inputLent Shared memory the input is left in, NULL if the input is copied.
      * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
      */
     int (*AsyncExecuteAlgorithm)(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo,
-        const DataInfo *inputInfo);
+        const DataInfo *inputInfo, LentPayload *inputLent);
 
     /**
      * @brief Unload algorithm model and plugin based on algorithm information and client information.
@@ -137,6 +150,30 @@ typedef struct AiInterface {
      * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
      */
     int (*UnregisterCallback)(const ClientInfo *clientInfo);
+
+    /**
+     * @brief Algorithmic inference interface for several inputs of one session sent together.
+     *
+     * @param [in] clientInfo Client information.
+     * @param [in] algoInfo Algorithm information, input i is executed as request algoInfo->requestId + i.
+     * @param [in] inputInfos Data information of every inference.
+     * @param [in] inputLents Shared memory every input is left in, NULL for an input copied.
+     * @param [in] num Number of inputs.
+     * @param [out] outputInfos Algorithm inference results of synchronous execution.
+     * @param [out] retCodes Result of every inference.
+     * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+     */
+    int (*BatchExecuteAlgorithm)(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo,
+        const DataInfo *inputInfos, LentPayload *const *inputLents, int num, DataInfo *outputInfos, int *retCodes);
+
+    /**
+     * @brief Register the shared memory ring the client writes large inputs into, once after initialization.
+     *
+     * @param [in] clientInfo Client information.
+     * @param [in] shmId ID of the shared memory segment of the ring, created by the calling uid.
+     * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+     */
+    int (*RegisterShmRing)(const ClientInfo *clientInfo, int shmId);
 } AiInterface;
 
 #ifdef __cplusplus
@@ -22,6 +22,8 @@ const int ALGORITHM_TYPE_SAMPLE_PLUGIN_1 = 0; // sync plugin for synchronization
 const int ALGORITHM_TYPE_SAMPLE_PLUGIN_2 = 1; // async plugin for asynchronous algorithm testing
 const int ALGORITHM_TYPE_KWS = 2;
 const int ALGORITHM_TYPE_IC = 3;
+const int ALGORITHM_TYPE_SAMPLE_PLUGIN_3 = 5; // sync plugin for batched inference testing
+const int ALGORITHM_TYPE_SAMPLE_PLUGIN_4 = 6; // sync plugin slow to load for plugin loading testing
 } // namespace AI
 } // namespace OHOS
 
@@ -36,6 +36,12 @@ typedef struct ClientInfo { // initialized by AieClientInit, don't init manually
     unsigned char *extendMsg; // reserved field
 } ClientInfo;
 
+typedef enum AlgorithmPriority { // scheduling class of a request, a higher class is served first.
+    ALGORITHM_PRIORITY_BACKGROUND = -1,
+    ALGORITHM_PRIORITY_NORMAL = 0,
+    ALGORITHM_PRIORITY_REALTIME = 1,
+} AlgorithmPriority;
+
 typedef struct AlgorithmInfo {
     long long clientVersion; // reserved field
     bool isAsync; // indicate asynchronous
@@ -53,6 +59,11 @@ typedef struct AlgorithmInfo {
     int requestId; // identity of algorithm when ClientCallback::OnResult is called. valid only for async algorithm.
     int extendLen; // reserved field
     unsigned char *extendMsg; // reserved field
+    int priority; // AlgorithmPriority of the requests, ALGORITHM_PRIORITY_NORMAL(0) by default.
+
+    // milliseconds a request may wait in server before it is processed, or it fails with RETCODE_SYNC_MSG_TIMEOUT.
+    // 0 means no deadline.
+    int timeOut;
 } AlgorithmInfo;
 
 typedef struct DataInfo {
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ADAPTER_TABLE_H
+#define ADAPTER_TABLE_H
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "communication_adapter/include/sa_server_adapter.h"
+#include "utils/aie_macros.h"
+
+namespace OHOS {
+namespace AI {
+/**
+ * Maximum number of clients connected to the server at the same time.
+ * It is configured by gn arg ai_engine_max_client_num.
+ */
+#ifndef AIE_MAX_CLIENT_NUM
+#define AIE_MAX_CLIENT_NUM 1024
+#endif
+
+/**
+ * Fixed-capacity table of client adapters, looked up by every IPC call without locking.
+ *
+ * A client ID encodes its slot index and the generation of the slot, so the ID of a removed client never matches
+ * the client reusing its slot. Each slot counts the calls using its adapter, a removed adapter is retired and only
+ * deleted once the count of its slot drains, the slot is reused after that. Adding and removing clients is
+ * serialized by a mutex, and also deletes the retired adapters whose calls have finished.
+ */
+class AdapterTable {
+    FORBID_COPY_AND_ASSIGN(AdapterTable);
+public:
+    /**
+     * Constructor.
+     *
+     * @param [in] capacity Maximum number of clients.
+     * @param [in] maxClientId Largest client ID given out, the generation of a slot wraps before exceeding it.
+     */
+    explicit AdapterTable(size_t capacity, int maxClientId = INT_MAX);
+    ~AdapterTable();
+
+    /**
+     * Allocate a slot and an adapter for a new client.
+     *
+     * @return Returns client ID if the operation is successful, returns INVALID_CLIENT_ID otherwise.
+     */
+    int AddAdapter();
+
+    /**
+     * Remove the adapter of a client, the adapter is deleted once no call uses it.
+     *
+     * @param [in] clientId Client ID.
+     * @return Returns true if the client is found, returns false otherwise.
+     */
+    bool RemoveAdapter(int clientId);
+
+    /**
+     * Find the adapter of a client and hold it for a call, {@code Release} must follow if it is found.
+     *
+     * @param [in] clientId Client ID.
+     * @return The adapter of the client, or nullptr if the client is not found.
+     */
+    SaServerAdapter *Acquire(int clientId);
+
+    /**
+     * End the call holding the adapter of a client.
+     *
+     * @param [in] clientId Client ID passed to the successful {@code Acquire}.
+     */
+    void Release(int clientId);
+
+private:
+    struct Slot {
+        // ID of the client owning the slot, INVALID_CLIENT_ID if the slot is free or its client is removed.
+        std::atomic<int> clientId;
+        // Number of calls holding the adapter of the slot.
+        std::atomic<int> refCount;
+        SaServerAdapter *adapter;
+        // Generation given to the next client of the slot, only accessed under the mutex.
+        int generation;
+    };
+
+    bool GetSlotIndex(int clientId, size_t &index) const;
+    void ReclaimRetired();
+
+private:
+    size_t capacity_;
+    int maxClientId_;
+    std::unique_ptr<Slot[]> slots_;
+    std::mutex mutex_;
+    // Free slots, reused oldest first so that client IDs do not come back soon.
+    std::deque<size_t> freeSlots_;
+    // Slots whose client is removed while calls may still use its adapter.
+    std::vector<size_t> retiredSlots_;
+};
+} // namespace AI
+} // namespace OHOS
+
+#endif // ADAPTER_TABLE_H
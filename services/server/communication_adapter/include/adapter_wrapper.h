@@ -18,6 +18,7 @@
 
 #include "protocol/retcode_inner/aie_retcode_inner.h"
 #include "ipc_skeleton.h"
+#include "platform/os_wrapper/ipc/include/aie_ipc.h"
 #include "protocol/struct_definition/aie_info_define.h"
 
 #ifdef __cplusplus
@@ -49,11 +50,12 @@ extern int LoadAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *al
  * @param [in] clientInfo Client information.
  * @param [in] AlgorithmInfo Algorithm information.
  * @param [in] inputInfo Data information needed to synchronous execution algorithm.
+ * @param [in] inputLent Shared memory the input is left in, NULL if the input is copied.
  * @param [out] outputInfo Algorithm inference results.
  * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
  */
 extern int SyncExecAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo,
-    const DataInfo *inputInfo, DataInfo *outputInfo);
+    const DataInfo *inputInfo, LentPayload *inputLent, DataInfo *outputInfo);
 
 /**
  * Execute algorithm inference asynchronously.
@@ -61,9 +63,26 @@ extern int SyncExecAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo
  * @param [in] clientInfo Client information.
  * @param [in] AlgorithmInfo Algorithm information.
  * @param [in] inputInfo Data information needed to synchronous execution algorithm.
+ * @param [in] inputLent Shared memory the input is left in, NULL if the input is copied.
+ * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
+ */
+extern int AsyncExecAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo,
+    const DataInfo *inputInfo, LentPayload *inputLent);
+
+/**
+ * Execute algorithm inference of several inputs in one call, synchronously or asynchronously by the algoInfo.
+ *
+ * @param [in] clientInfo Client information.
+ * @param [in] AlgorithmInfo Algorithm information, input i is executed as request algoInfo->requestId + i.
+ * @param [in] inputInfos Data information of every inference.
+ * @param [in] inputLents Shared memory every input is left in, NULL for an input copied.
+ * @param [in] num Number of inputs.
+ * @param [out] outputInfos Algorithm inference results of synchronous execution.
+ * @param [out] retCodes Result of every inference.
  * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
  */
-extern int AsyncExecAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo, const DataInfo *inputInfo);
+extern int BatchExecAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo,
+    const DataInfo *inputInfos, LentPayload *const *inputLents, int num, DataInfo *outputInfos, int *retCodes);
 
 /**
  * Unload algorithm plugin and model based on algorithm information and client information.
@@ -18,6 +18,7 @@
 
 #include <list>
 #include <mutex>
+#include <vector>
 
 #include "communication_adapter/include/sa_server_adapter.h"
 #include "platform/event/include/i_event.h"
@@ -25,6 +26,22 @@
 #include "protocol/data_channel/include/i_response.h"
 #include "protocol/retcode_inner/aie_retcode_inner.h"
 
+/**
+ * Maximum number of async results packed into one callback message to a client.
+ * It is configured by gn arg ai_engine_callback_batch_num.
+ */
+#ifndef AIE_CALLBACK_BATCH_NUM
+#define AIE_CALLBACK_BATCH_NUM 16
+#endif
+
+/**
+ * Maximum time in milliseconds to wait for more async results to fill a callback message.
+ * It is configured by gn arg ai_engine_callback_batch_wait_time_ms.
+ */
+#ifndef AIE_CALLBACK_BATCH_WAIT_TIME_MS
+#define AIE_CALLBACK_BATCH_WAIT_TIME_MS 0
+#endif
+
 namespace OHOS {
 namespace AI {
 class ClientListenerHandler;
@@ -41,13 +58,24 @@ public:
     bool Initialize() override;
     void Uninitialize() override;
 
+    /**
+     * Parcel responses into one callback message, packed as ON_ASYNC_PROCESS_BATCH_CODE if there are several.
+     *
+     * @param [in] responses Responses to be called back, at least one.
+     * @param [out] io Callback message.
+     * @return Code of the callback message.
+     */
+    uint32_t ParcelResponses(const std::vector<IResponse *> &responses, IpcIo &io);
+
 private:
-    void IpcIoResponse(IResponse *response, IpcIo &io, char *data, int length);
+    void ParcelResponse(IResponse *response, IpcIo &io);
+    bool SendResponses();
 
 private:
     ClientListenerHandler *handler_;
     int clientId_;
     SaServerAdapter *adapter_;
+    std::vector<IResponse *> responses_;
 };
 
 class ClientListenerHandler {
@@ -56,6 +84,15 @@ public:
     ~ClientListenerHandler();
     IResponse *FetchCallbackRecord();
 
+    /**
+     * Fetch the queued responses to be called back together, waiting for the first one as FetchCallbackRecord.
+     *
+     * @param [out] responses Fetched responses are appended to it.
+     * @param [in] maxNum Maximum number of responses to fetch.
+     * @param [in] waitTimeMs Maximum time to wait for more responses after the first one, 0 takes the queued ones.
+     */
+    void FetchCallbackRecords(std::vector<IResponse *> &responses, size_t maxNum, int waitTimeMs);
+
     /**
      * Add response to record callback.
      *
@@ -20,7 +20,7 @@
 #include <mutex>
 
 #include "communication_adapter/include/client_listener_handler.h"
-#include "platform/lock/include/rw_lock.h"
+#include "platform/lock/include/biased_rw_lock.h"
 #include "server_executor/include/i_future_listener.h"
 #include "utils/aie_macros.h"
 
@@ -124,7 +124,7 @@ private:
 private:
     static std::mutex mutex_;
     static SaAsyncHandler *instance_;
-    RwLock rwLock_;
+    BiasedRwLock rwLock_;
 
     using ClientListenerHandlerMap = std::map<int, ClientListenerHandler*>;
     ClientListenerHandlerMap clients_;
@@ -16,10 +16,10 @@
 #ifndef SA_SERVER_ADAPTER_H
 #define SA_SERVER_ADAPTER_H
 
-#include <atomic>
 #include <mutex>
 #include <set>
 
+#include "platform/os_wrapper/ipc/include/aie_ipc.h"
 #include "protocol/data_channel/include/i_request.h"
 #include "protocol/data_channel/include/i_response.h"
 #include "protocol/retcode_inner/aie_retcode_inner.h"
@@ -60,9 +60,11 @@ public:
      * @param [in] clientInfo Client information.
      * @param [in] algorithmInfo Algorithm information.
      * @param [in] inputInfo Data information needed to asynchronous execution algorithm.
+     * @param [in] inputLent Shared memory the input is left in, nullptr if the input is copied.
      * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
      */
-    int AsyncExecute(const ClientInfo &clientInfo, const AlgorithmInfo &algoInfo, const DataInfo &inputInfo);
+    int AsyncExecute(const ClientInfo &clientInfo, const AlgorithmInfo &algoInfo, const DataInfo &inputInfo,
+        LentPayload *inputLent);
 
     /**
      * Get session ID, according to transaction ID.
@@ -72,9 +74,6 @@ public:
      */
     int GetSessionId(long long transactionId) const;
     int GetAdapterId() const;
-    void IncRef();
-    void DecRef();
-    int GetRefCount() const;
 
     /**
      * Get transaction ID, according to session ID.
@@ -132,22 +131,38 @@ public:
      * @param [in] clientInfo Client information.
      * @param [in] AlgorithmInfo Algorithm information.
      * @param [in] inputInfo Data information needed to synchronous execution algorithm.
+     * @param [in] inputLent Shared memory the input is left in, nullptr if the input is copied.
      * @param [out] outputInfo Algorithm inference results.
      * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
      */
     int SyncExecute(const ClientInfo &clientInfo, const AlgorithmInfo &algoInfo, const DataInfo &inputInfo,
-        DataInfo &outputInfo);
+        LentPayload *inputLent, DataInfo &outputInfo);
+
+    /**
+     * Execute algorithm inference of several inputs sharing the client and algorithm information.
+     * Input i is executed as request algoInfo.requestId + i, asynchronously if algoInfo.isAsync.
+     *
+     * @param [in] clientInfo Client information.
+     * @param [in] algoInfo Algorithm information.
+     * @param [in] inputInfos Data information of every inference, taken over by its request.
+     * @param [in] inputLents Shared memory every input is left in, nullptr for an input copied.
+     * @param [in] num Number of inputs.
+     * @param [out] outputInfos Inference results of synchronous execution, not used for asynchronous execution.
+     * @param [out] retCodes Result of every inference, or of sending it for asynchronous execution.
+     * @return Returns 0 if every inference succeeds, returns the error of a failed one otherwise.
+     */
+    int BatchExecute(const ClientInfo &clientInfo, const AlgorithmInfo &algoInfo, const DataInfo *inputInfos,
+        LentPayload *const *inputLents, int num, DataInfo *outputInfos, int *retCodes);
 
 private:
     void Uninitialize();
     void SaveTransaction(long long transactionId);
     void RemoveTransaction(long long transactionId);
     void ConvertToRequest(const ClientInfo &clientInfo, const AlgorithmInfo &algoInfo, const DataInfo &inputInfo,
-        IRequest *&request);
+        LentPayload *inputLent, IRequest *&request);
 
 private:
     int adapterId_;
-    std::atomic<int> refCount_;
     std::mutex mutex_;
     SvcIdentity svcIdentity_ = {};
     using TransactionIds = std::set<long long>;
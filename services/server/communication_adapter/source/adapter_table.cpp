@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "communication_adapter/include/adapter_table.h"
+
+#include "utils/constants/constants.h"
+#include "utils/log/aie_log.h"
+
+namespace OHOS {
+namespace AI {
+namespace {
+const int STARTING_GENERATION = 1;
+}
+
+AdapterTable::AdapterTable(size_t capacity, int maxClientId)
+    : capacity_(capacity), maxClientId_(maxClientId), slots_(new (std::nothrow) Slot[capacity])
+{
+    if (slots_ == nullptr) {
+        HILOGE("[AdapterTable]Failed to allocate %zu slots.", capacity);
+        capacity_ = 0;
+        return;
+    }
+    for (size_t i = 0; i < capacity_; ++i) {
+        slots_[i].clientId.store(INVALID_CLIENT_ID);
+        slots_[i].refCount.store(0);
+        slots_[i].adapter = nullptr;
+        slots_[i].generation = STARTING_GENERATION;
+        freeSlots_.push_back(i);
+    }
+}
+
+AdapterTable::~AdapterTable()
+{
+    for (size_t i = 0; i < capacity_; ++i) {
+        AIE_DELETE(slots_[i].adapter);
+    }
+}
+
+bool AdapterTable::GetSlotIndex(int clientId, size_t &index) const
+{
+    // IDs below the capacity belong to generation 0, which is never given out.
+    if (capacity_ == 0 || clientId <= 0 || static_cast<size_t>(clientId) < capacity_) {
+        return false;
+    }
+    index = static_cast<size_t>(clientId) % capacity_;
+    return true;
+}
+
+int AdapterTable::AddAdapter()
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    ReclaimRetired();
+    if (freeSlots_.empty()) {
+        HILOGE("[AdapterTable]Num of valid clients reaches max.");
+        return INVALID_CLIENT_ID;
+    }
+
+    size_t index = freeSlots_.front();
+    Slot &slot = slots_[index];
+    int clientId = static_cast<int>(static_cast<long long>(slot.generation) * capacity_ + index);
+    SaServerAdapter *adapter = nullptr;
+    AIE_NEW(adapter, SaServerAdapter(clientId));
+    if (adapter == nullptr) {
+        HILOGE("[AdapterTable]Failed to new adapter.");
+        return INVALID_CLIENT_ID;
+    }
+    freeSlots_.pop_front();
+
+    // Wrap the generation before the client ID overflows, a stale ID of a generation that old is long gone.
+    ++slot.generation;
+    if (static_cast<long long>(slot.generation) * capacity_ + index > static_cast<long long>(maxClientId_)) {
+        HILOGI("[AdapterTable]Generation of slot [%zu] reaches max, reset to starting value.", index);
+        slot.generation = STARTING_GENERATION;
+    }
+
+    // Publish the adapter before the ID, a call matching the ID then sees the adapter.
+    slot.adapter = adapter;
+    slot.clientId.store(clientId);
+    return clientId;
+}
+
+bool AdapterTable::RemoveAdapter(int clientId)
+{
+    size_t index = 0;
+    if (!GetSlotIndex(clientId, index)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    Slot &slot = slots_[index];
+    if (slot.clientId.load() != clientId) {
+        return false;
+    }
+    // New calls stop matching the ID, the adapter is deleted once the calls already holding it are done.
+    slot.clientId.store(INVALID_CLIENT_ID);
+    retiredSlots_.push_back(index);
+    ReclaimRetired();
+    return true;
+}
+
+SaServerAdapter *AdapterTable::Acquire(int clientId)
+{
+    size_t index = 0;
+    if (!GetSlotIndex(clientId, index)) {
+        return nullptr;
+    }
+
+    // Count the call before checking the ID, the remover invalidates the ID before checking the count,
+    // so either this call sees the client removed or the remover sees this call.
+    Slot &slot = slots_[index];
+    slot.refCount.fetch_add(1);
+    if (slot.clientId.load() != clientId) {
+        slot.refCount.fetch_sub(1);
+        return nullptr;
+    }
+    return slot.adapter;
+}
+
+void AdapterTable::Release(int clientId)
+{
+    size_t index = 0;
+    if (!GetSlotIndex(clientId, index)) {
+        return;
+    }
+
+    Slot &slot = slots_[index];
+    // The last call of a removed client deletes its adapter, instead of waiting for the next client to come or go.
+    if (slot.refCount.fetch_sub(1) == 1 && slot.clientId.load() == INVALID_CLIENT_ID) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        ReclaimRetired();
+    }
+}
+
+void AdapterTable::ReclaimRetired()
+{
+    for (auto iter = retiredSlots_.begin(); iter != retiredSlots_.end();) {
+        Slot &slot = slots_[*iter];
+        if (slot.refCount.load() != 0) {
+            ++iter;
+            continue;
+        }
+        AIE_DELETE(slot.adapter);
+        freeSlots_.push_back(*iter);
+        iter = retiredSlots_.erase(iter);
+    }
+}
+} // namespace AI
+} // namespace OHOS
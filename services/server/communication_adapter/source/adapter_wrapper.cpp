@@ -15,11 +15,10 @@
 
 #include "communication_adapter/include/adapter_wrapper.h"
 
-#include <cstring>
-#include <map>
-
+#include "communication_adapter/include/adapter_table.h"
 #include "communication_adapter/include/sa_async_handler.h"
 #include "communication_adapter/include/sa_server_adapter.h"
+#include "platform/os_wrapper/ipc/include/aie_ipc.h"
 #include "protocol/retcode_inner/aie_retcode_inner.h"
 #include "utils/aie_macros.h"
 #include "utils/constants/constants.h"
@@ -27,137 +26,136 @@
 
 using namespace OHOS::AI;
 namespace {
-constexpr int STARTING_CLIENT_ID = 1;
-constexpr int MAX_NUM_CLIENTS = 1024;
-using ServerAdapters = std::map<int, SaServerAdapter*>;
-ServerAdapters g_saServerAdapters;
-std::atomic<int> g_clientIdAtomic(0);
-std::mutex g_serverAdapterMutex;
-std::mutex g_connectMutex;
-
-int FindValidClientId()
+AdapterTable g_adapterTable(AIE_MAX_CLIENT_NUM);
+
+/**
+ * Release the input of an execution refused before a request takes it, it may hold shared memory of the client.
+ */
+void ReleaseInput(const DataInfo *inputInfo, LentPayload *inputLent)
 {
-    if (g_saServerAdapters.size() > MAX_NUM_CLIENTS) {
-        HILOGE("[AdapterWrapper]Num of valid clients reaches max.");
-        return INVALID_CLIENT_ID;
+    if (inputInfo != nullptr) {
+        DataInfo input = *inputInfo;
+        FreeLentDataInfo(&input, inputLent);
     }
-
-    do {
-        ++g_clientIdAtomic;
-        if (g_clientIdAtomic < STARTING_CLIENT_ID) {
-            HILOGI("[AdapterWrapper]Client id reaches max, reset to starting value [%d].", STARTING_CLIENT_ID);
-            g_clientIdAtomic = STARTING_CLIENT_ID;
-        }
-    } while (g_saServerAdapters.find(g_clientIdAtomic) != g_saServerAdapters.end());
-
-    return g_clientIdAtomic;
 }
 
-int AllocateClientAdapter()
+void ReleaseInputs(const DataInfo *inputInfos, LentPayload *const *inputLents, int num)
 {
-    SaServerAdapter *adapter = nullptr;
-    AIE_NEW(adapter, SaServerAdapter(g_clientIdAtomic));
-    if (adapter == nullptr) {
-        HILOGE("[AdapterWrapper]Failed to new adapter.");
-        return INVALID_CLIENT_ID;
+    if (inputInfos != nullptr) {
+        for (int i = 0; i < num; ++i) {
+            ReleaseInput(&inputInfos[i], inputLents == nullptr ? nullptr : inputLents[i]);
+        }
     }
-
-    int clientId = adapter->GetAdapterId();
-
-    std::lock_guard<std::mutex> guard(g_serverAdapterMutex);
-    g_saServerAdapters[clientId] = adapter;
-    return clientId;
 }
 }
 
+/**
+ * Holds the adapter of a client for the duration of one call, so that removing the client does not delete it.
+ */
 class AdapterWrapper {
 public:
-    explicit AdapterWrapper(SaServerAdapter *adapter) : adapter_(adapter)
+    explicit AdapterWrapper(int clientId) : clientId_(clientId), adapter_(g_adapterTable.Acquire(clientId))
     {
-        if (adapter_) {
-            adapter_->IncRef();
-        }
     }
 
     ~AdapterWrapper()
     {
         if (adapter_) {
-            adapter_->DecRef();
+            g_adapterTable.Release(clientId_);
             adapter_ = nullptr;
         }
     }
 
+    SaServerAdapter *GetAdapter() const
+    {
+        return adapter_;
+    }
+
 private:
+    int clientId_;
     SaServerAdapter *adapter_ = nullptr;
 };
 
-SaServerAdapter* FindAdapter(const int clientId)
-{
-    std::lock_guard<std::mutex> guard(g_serverAdapterMutex);
-    ServerAdapters::iterator iter = g_saServerAdapters.find(clientId);
-    if (iter != g_saServerAdapters.end()) {
-        return iter->second;
-    }
-    return nullptr;
-}
-
 int GenerateClient()
 {
     HILOGI("[AdapterWrapper]Begin to call GenerateClient.");
-    std::lock_guard<std::mutex> guard(g_connectMutex);
-
-    if (FindValidClientId() == INVALID_CLIENT_ID) {
-        return INVALID_CLIENT_ID;
-    }
-
-    return AllocateClientAdapter();
+    return g_adapterTable.AddAdapter();
 }
 
 int SyncExecAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo, const DataInfo *inputInfo,
-    DataInfo *outputInfo)
+    LentPayload *inputLent, DataInfo *outputInfo)
 {
     HILOGI("[AdapterWrapper]Begin to call SyncExecAlgoWrapper.");
     if (clientInfo == nullptr || algoInfo == nullptr) {
         HILOGE("[AdapterWrapper]The clientInfo or algoInfo is nullptr");
+        ReleaseInput(inputInfo, inputLent);
         return RETCODE_NULL_PARAM;
     }
 
     if (algoInfo->isAsync) {
         HILOGW("[AdapterWrapper]SyncExecute but the algoInfo is AsyncExecute");
+        ReleaseInput(inputInfo, inputLent);
         return RETCODE_WRONG_INFER_MODE;
     }
 
-    SaServerAdapter *adapter = FindAdapter(clientInfo->clientId);
+    AdapterWrapper adapterGuard(clientInfo->clientId);
+    SaServerAdapter *adapter = adapterGuard.GetAdapter();
     if (adapter == nullptr) {
         HILOGE("[AdapterWrapper]No adapter found for client[%d].", clientInfo->clientId);
+        ReleaseInput(inputInfo, inputLent);
         return RETCODE_NO_CLIENT_FOUND;
     }
 
-    AdapterWrapper adapterGuard(adapter);
-    return adapter->SyncExecute(*clientInfo, *algoInfo, *inputInfo, *outputInfo);
+    return adapter->SyncExecute(*clientInfo, *algoInfo, *inputInfo, inputLent, *outputInfo);
 }
 
-int AsyncExecAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo, const DataInfo *inputInfo)
+int AsyncExecAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo, const DataInfo *inputInfo,
+    LentPayload *inputLent)
 {
     HILOGI("[AdapterWrapper]Begin to call AsyncExecAlgoWrapper.");
     if (clientInfo == nullptr || algoInfo == nullptr) {
         HILOGE("[AdapterWrapper]The clientInfo or algoInfo is nullptr.");
+        ReleaseInput(inputInfo, inputLent);
         return RETCODE_NULL_PARAM;
     }
 
     if (!algoInfo->isAsync) {
         HILOGW("[AdapterWrapper]AsyncExecute but the algoInfo is SyncExecute.");
+        ReleaseInput(inputInfo, inputLent);
         return RETCODE_WRONG_INFER_MODE;
     }
 
-    SaServerAdapter *adapter = FindAdapter(clientInfo->clientId);
+    AdapterWrapper adapterGuard(clientInfo->clientId);
+    SaServerAdapter *adapter = adapterGuard.GetAdapter();
+    if (adapter == nullptr) {
+        HILOGE("[AdapterWrapper]No adapter found for client[%d].", clientInfo->clientId);
+        ReleaseInput(inputInfo, inputLent);
+        return RETCODE_NO_CLIENT_FOUND;
+    }
+
+    return adapter->AsyncExecute(*clientInfo, *algoInfo, *inputInfo, inputLent);
+}
+
+int BatchExecAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo, const DataInfo *inputInfos,
+    LentPayload *const *inputLents, int num, DataInfo *outputInfos, int *retCodes)
+{
+    HILOGI("[AdapterWrapper]Begin to call BatchExecAlgoWrapper, num is %d.", num);
+    if (clientInfo == nullptr || algoInfo == nullptr || inputInfos == nullptr || inputLents == nullptr ||
+        outputInfos == nullptr || retCodes == nullptr || num <= 0) {
+        HILOGE("[AdapterWrapper]The clientInfo, algoInfo or batch of inputs is invalid.");
+        ReleaseInputs(inputInfos, inputLents, num);
+        return RETCODE_NULL_PARAM;
+    }
+
+    AdapterWrapper adapterGuard(clientInfo->clientId);
+    SaServerAdapter *adapter = adapterGuard.GetAdapter();
     if (adapter == nullptr) {
         HILOGE("[AdapterWrapper]No adapter found for client[%d].", clientInfo->clientId);
+        ReleaseInputs(inputInfos, inputLents, num);
         return RETCODE_NO_CLIENT_FOUND;
     }
-    AdapterWrapper adapterGuard(adapter);
 
-    return adapter->AsyncExecute(*clientInfo, *algoInfo, *inputInfo);
+    return adapter->BatchExecute(*clientInfo, *algoInfo, inputInfos, inputLents, num, outputInfos, retCodes);
 }
 
 int LoadAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo, const DataInfo *inputInfo,
@@ -169,13 +167,13 @@ int LoadAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo,
         return RETCODE_NULL_PARAM;
     }
 
-    SaServerAdapter *adapter = FindAdapter(clientInfo->clientId);
+    AdapterWrapper adapterGuard(clientInfo->clientId);
+    SaServerAdapter *adapter = adapterGuard.GetAdapter();
     if (adapter == nullptr) {
         HILOGE("[AdapterWrapper]No adapter found for client[%d].", clientInfo->clientId);
         return RETCODE_NO_CLIENT_FOUND;
     }
 
-    AdapterWrapper adapterGuard(adapter);
     long long transactionId = adapter->GetTransactionId(clientInfo->sessionId);
     int retCode = adapter->LoadAlgorithm(transactionId, *algoInfo, *inputInfo, *outputInfo);
     if (retCode != RETCODE_SUCCESS) {
@@ -196,13 +194,13 @@ int LoadAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo,
 int UnloadAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo, const DataInfo *inputInfo)
 {
     HILOGI("[AdapterWrapper]Begin to call UnloadAlgoWrapper.");
-    SaServerAdapter *adapter = FindAdapter(clientInfo->clientId);
+    AdapterWrapper adapterGuard(clientInfo->clientId);
+    SaServerAdapter *adapter = adapterGuard.GetAdapter();
     if (adapter == nullptr) {
         HILOGE("[AdapterWrapper]No adapter found for client[%d].", clientInfo->clientId);
         return RETCODE_NO_CLIENT_FOUND;
     }
 
-    AdapterWrapper adapterGuard(adapter);
     long long transactionId = adapter->GetTransactionId(clientInfo->sessionId);
     if (algoInfo == nullptr) {
         HILOGE("[AdapterWrapper]AlgoInfo is nullptr.");
@@ -221,28 +219,25 @@ int UnloadAlgoWrapper(const ClientInfo *clientInfo, const AlgorithmInfo *algoInf
 int RemoveAdapterWrapper(const ClientInfo *clientInfo)
 {
     HILOGI("[AdapterWrapper]Begin to call RemoveAdapterWrapper.");
-    std::lock_guard<std::mutex> guard(g_serverAdapterMutex);
-    ServerAdapters::iterator iter = g_saServerAdapters.find(clientInfo->clientId);
-    if (iter == g_saServerAdapters.end()) {
+    // The ring of the client is detached even if its adapter is gone already.
+    RemoveShmRingClient(clientInfo->clientId);
+    if (!g_adapterTable.RemoveAdapter(clientInfo->clientId)) {
         HILOGE("[AdapterWrapper]Failed to find serverAdapter for client[%d].", clientInfo->clientId);
         return RETCODE_FAILURE;
     }
-
-    AIE_DELETE(iter->second);
-    g_saServerAdapters.erase(iter);
     return RETCODE_SUCCESS;
 }
 
 int SetOptionWrapper(const ClientInfo *clientInfo, int optionType, const DataInfo *inputInfo)
 {
     HILOGI("[AdapterWrapper]Begin to call SetOptionWrapper.");
-    SaServerAdapter *adapter = FindAdapter(clientInfo->clientId);
+    AdapterWrapper adapterGuard(clientInfo->clientId);
+    SaServerAdapter *adapter = adapterGuard.GetAdapter();
     if (adapter == nullptr) {
         HILOGE("[AdapterWrapper]No adapter found for client[%d].", clientInfo->clientId);
         return RETCODE_NO_CLIENT_FOUND;
     }
 
-    AdapterWrapper adapterGuard(adapter);
     long long transactionId = adapter->GetTransactionId(clientInfo->sessionId);
     return adapter->SetOption(transactionId, optionType, *inputInfo);
 }
@@ -254,13 +249,13 @@ int GetOptionWrapper(const ClientInfo *clientInfo, int optionType, const DataInf
         HILOGE("[AdapterWrapper]ClientInfo is nullptr.");
         return RETCODE_NULL_PARAM;
     }
-    SaServerAdapter *adapter = FindAdapter(clientInfo->clientId);
+    AdapterWrapper adapterGuard(clientInfo->clientId);
+    SaServerAdapter *adapter = adapterGuard.GetAdapter();
     if (adapter == nullptr) {
         HILOGE("[AdapterWrapper]No adapter found for client[%d].", clientInfo->clientId);
         return RETCODE_NO_CLIENT_FOUND;
     }
 
-    AdapterWrapper adapterGuard(adapter);
     long long transactionId = adapter->GetTransactionId(clientInfo->sessionId);
     return adapter->GetOption(transactionId, optionType, *inputInfo, *outputInfo);
 }
@@ -268,12 +263,12 @@ int GetOptionWrapper(const ClientInfo *clientInfo, int optionType, const DataInf
 int RegisterCallbackWrapper(const ClientInfo *clientInfo, SvcIdentity *sid)
 {
     HILOGI("[AdapterWrapper]Begin to call RegisterCallbackWrapper.");
-    SaServerAdapter *adapter = FindAdapter(clientInfo->clientId);
+    AdapterWrapper adapterGuard(clientInfo->clientId);
+    SaServerAdapter *adapter = adapterGuard.GetAdapter();
     if (adapter == nullptr) {
         HILOGE("[AdapterWrapper]No adapter found for client[%d].", clientInfo->clientId);
         return RETCODE_NO_CLIENT_FOUND;
     }
-    AdapterWrapper adapterGuard(adapter);
 
     adapter->SaveEngineListener(sid);
 
@@ -292,13 +287,13 @@ int RegisterCallbackWrapper(const ClientInfo *clientInfo, SvcIdentity *sid)
 int UnregisterCallbackWrapper(const ClientInfo *clientInfo)
 {
     HILOGI("[AdapterWrapper]Begin to call UnregisterCallbackWrapper.");
-    SaServerAdapter *adapter = FindAdapter(clientInfo->clientId);
+    AdapterWrapper adapterGuard(clientInfo->clientId);
+    SaServerAdapter *adapter = adapterGuard.GetAdapter();
     if (adapter == nullptr) {
         HILOGE("[AdapterWrapper]No adapter found for client[%d].", clientInfo->clientId);
         return RETCODE_NO_CLIENT_FOUND;
     }
 
-    AdapterWrapper adapterGuard(adapter);
     SaAsyncHandler *saAsyncHandler = SaAsyncHandler::GetInstance();
     CHK_RET(saAsyncHandler == nullptr, RETCODE_NULL_PARAM);
     saAsyncHandler->StopAsyncProcess(clientInfo->clientId);
@@ -18,10 +18,10 @@
 #include "ipc_skeleton.h"
 #include "rpc_errno.h"
 #include "platform/os_wrapper/ipc/include/aie_ipc.h"
+#include "platform/time/include/time.h"
 #include "protocol/ipc_interface/ai_service.h"
 #include "protocol/retcode_inner/aie_retcode_inner.h"
 #include "protocol/struct_definition/aie_info_define.h"
-#include "utils/aie_guard.h"
 #include "utils/aie_macros.h"
 #include "utils/log/aie_log.h"
 
@@ -35,6 +35,7 @@ const int EVENT_WAIT_TIME_MS = 1000;
 AsyncProcessWorker::AsyncProcessWorker(ClientListenerHandler *handler, int clientId, SaServerAdapter *adapter)
     : handler_(handler), clientId_(clientId), adapter_(adapter)
 {
+    responses_.reserve(AIE_CALLBACK_BATCH_NUM);
 }
 
 const char *AsyncProcessWorker::GetName() const
@@ -42,14 +43,8 @@ const char *AsyncProcessWorker::GetName() const
     return ASYNC_PROCESS_WORKER;
 }
 
-void AsyncProcessWorker::IpcIoResponse(IResponse *response, IpcIo &io, char *data, int length)
+void AsyncProcessWorker::ParcelResponse(IResponse *response, IpcIo &io)
 {
-    if (response == nullptr) {
-        HILOGE("[ClientListenerHandler]Input param response is nullptr.");
-        return;
-    }
-    IpcIoInit(&io, data, length, IPC_OBJECT_COUNTS);
-
     int retCode = response->GetRetCode();
     WriteInt32(&io, retCode);
 
@@ -64,33 +59,58 @@ void AsyncProcessWorker::IpcIoResponse(IResponse *response, IpcIo &io, char *dat
     ParcelDataInfo(&io, &result, response->GetClientUid());
 }
 
-bool AsyncProcessWorker::OneAction()
+uint32_t AsyncProcessWorker::ParcelResponses(const std::vector<IResponse *> &responses, IpcIo &io)
 {
-    IResponse *response = handler_->FetchCallbackRecord();
-    CHK_RET(response == nullptr, true);
-    ResGuard<IResponse> guard(response);
-
-    IpcIo io;
-    char tmpData[MAX_IO_SIZE];
-    IpcIoResponse(response, io, tmpData, MAX_IO_SIZE);
+    // A single result keeps its own message, so that the client of an idle server sees no difference.
+    uint32_t code = ON_ASYNC_PROCESS_CODE;
+    if (responses.size() > 1) {
+        code = ON_ASYNC_PROCESS_BATCH_CODE;
+        WriteInt32(&io, static_cast<int32_t>(responses.size()));
+    }
+    for (auto &response : responses) {
+        ParcelResponse(response, io);
+    }
+    return code;
+}
 
+bool AsyncProcessWorker::SendResponses()
+{
     SvcIdentity *svcIdentity = adapter_->GetEngineListener();
     if (svcIdentity == nullptr) {
         HILOGE("[ClientListenerHandler]Fail to get engine listener, clientId: %d.", clientId_);
         return true;
     }
 
+    IpcIo io;
+    char tmpData[MAX_IO_SIZE];
+    IpcIoInit(&io, tmpData, MAX_IO_SIZE, IPC_OBJECT_COUNTS);
+    uint32_t code = ParcelResponses(responses_, io);
+
     IpcIo reply;
     MessageOption option;
     MessageOptionInit(&option);
     option.flags = TF_OP_ASYNC;
-    int32_t retCode = SendRequest(*svcIdentity, ON_ASYNC_PROCESS_CODE, &io, &reply, option, nullptr);
+    int32_t retCode = SendRequest(*svcIdentity, code, &io, &reply, option, nullptr);
     if (retCode != ERR_NONE) {
-        HILOGI("[ClientListenerHandler]End to deal response, ret is %d, clientId: %d.", retCode, clientId_);
+        HILOGI("[ClientListenerHandler]End to deal %zu responses, ret is %d, clientId: %d.",
+            responses_.size(), retCode, clientId_);
     }
     return retCode == ERR_NONE;
 }
 
+bool AsyncProcessWorker::OneAction()
+{
+    handler_->FetchCallbackRecords(responses_, AIE_CALLBACK_BATCH_NUM, AIE_CALLBACK_BATCH_WAIT_TIME_MS);
+    CHK_RET(responses_.empty(), true);
+
+    bool isSent = SendResponses();
+    for (auto &response : responses_) {
+        IResponse::Destroy(response);
+    }
+    responses_.clear();
+    return isSent;
+}
+
 bool AsyncProcessWorker::Initialize()
 {
     return true;
@@ -140,6 +160,35 @@ IResponse *ClientListenerHandler::FetchCallbackRecord()
     return response;
 }
 
+void ClientListenerHandler::FetchCallbackRecords(std::vector<IResponse *> &responses, size_t maxNum,
+    int waitTimeMs)
+{
+    IResponse *response = FetchCallbackRecord();
+    CHK_RET_NONE(response == nullptr);
+    responses.push_back(response);
+
+    long long deadline = GetSteadyTimeMillSec() + waitTimeMs;
+    while (responses.size() < maxNum) {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            while (!responses_.empty() && responses.size() < maxNum) {
+                responses.push_back(responses_.front());
+                responses_.pop_front();
+            }
+            if (responses_.empty()) { // if it's empty now, block thread.
+                event_->Reset();
+            }
+        }
+        if (responses.size() >= maxNum) {
+            break;
+        }
+        long long remainTime = deadline - GetSteadyTimeMillSec();
+        if (remainTime <= 0 || !event_->Wait(static_cast<int>(remainTime))) {
+            break;
+        }
+    }
+}
+
 void ClientListenerHandler::AddCallbackRecord(IResponse *response)
 {
     std::lock_guard<std::mutex> guard(mutex_);
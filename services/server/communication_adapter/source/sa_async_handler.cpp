@@ -49,7 +49,7 @@ SaAsyncHandler::~SaAsyncHandler()
 
 void SaAsyncHandler::StopClientListenerHandler(int clientId)
 {
-    ReadGuard<RwLock> guard(rwLock_);
+    ReadGuard<BiasedRwLock> guard(rwLock_);
     auto iter = clients_.find(clientId);
     CHK_RET_NONE(iter == clients_.end());
 
@@ -58,7 +58,7 @@ void SaAsyncHandler::StopClientListenerHandler(int clientId)
 
 void SaAsyncHandler::RemoveClientListenerHandler(int clientId)
 {
-    WriteGuard<RwLock> guard(rwLock_);
+    WriteGuard<BiasedRwLock> guard(rwLock_);
     ClientListenerHandlerMap::iterator iter = clients_.find(clientId);
     CHK_RET_NONE(iter == clients_.end());
 
@@ -68,7 +68,7 @@ void SaAsyncHandler::RemoveClientListenerHandler(int clientId)
 
 ClientListenerHandler *SaAsyncHandler::FindClientListenerHandler(int clientId)
 {
-    ReadGuard<RwLock> guard(rwLock_);
+    ReadGuard<BiasedRwLock> guard(rwLock_);
     ClientListenerHandlerMap::iterator iter = clients_.find(clientId);
     CHK_RET(iter == clients_.end(), nullptr);
 
@@ -81,27 +81,27 @@ ClientListenerHandler *SaAsyncHandler::AddClientListenerHandler(int clientId)
     AIE_NEW(handler, ClientListenerHandler);
     CHK_RET(handler == nullptr, nullptr);
 
-    WriteGuard<RwLock> guard(rwLock_);
+    WriteGuard<BiasedRwLock> guard(rwLock_);
     clients_[clientId] = handler;
     return handler;
 }
 
 void SaAsyncHandler::RemoveTransaction(long long transactionId)
 {
-    WriteGuard<RwLock> guard(rwLock_);
+    WriteGuard<BiasedRwLock> guard(rwLock_);
     transactions_.erase(transactionId);
 }
 
 bool SaAsyncHandler::IsExistTransaction(long long transactionId)
 {
-    ReadGuard<RwLock> guard(rwLock_);
+    ReadGuard<BiasedRwLock> guard(rwLock_);
     auto iter = transactions_.find(transactionId);
     return (iter != transactions_.end());
 }
 
 void SaAsyncHandler::SaveTransaction(long long transactionId)
 {
-    WriteGuard<RwLock> guard(rwLock_);
+    WriteGuard<BiasedRwLock> guard(rwLock_);
     transactions_.insert(transactionId);
 }
 
@@ -125,7 +125,7 @@ int SaAsyncHandler::RegisterAsyncHandler(int clientId)
 
 int SaAsyncHandler::StartAsyncProcess(int clientId, SaServerAdapter *adapter)
 {
-    ReadGuard<RwLock> guard(rwLock_);
+    ReadGuard<BiasedRwLock> guard(rwLock_);
     ClientListenerHandlerMap::iterator iter = clients_.find(clientId);
     if (iter == clients_.end()) {
         HILOGE("[SaAsyncHandler]The client do not preRegister AsyncHandler, clientId: %d.", clientId);
@@ -17,6 +17,7 @@
 #include <stdlib.h>
 
 #include "iproxy_server.h"
+#include "ipc_skeleton.h"
 #include "ohos_errno.h"
 #include "ohos_init.h"
 #include "samgr_lite.h"
@@ -30,6 +31,14 @@
 #include "utils/constants/constants.h"
 #include "utils/log/aie_log.h"
 
+/**
+ * Largest calling uid allowed to request ALGORITHM_PRIORITY_REALTIME, requests of other clients are
+ * served as ALGORITHM_PRIORITY_NORMAL. It is configured by gn arg ai_engine_realtime_max_uid.
+ */
+#ifndef AIE_REALTIME_MAX_UID
+#define AIE_REALTIME_MAX_UID 1000
+#endif
+
 static const int STACK_SIZE = 0x800;
 static const int QUEUE_SIZE = 20;
 
@@ -82,7 +91,7 @@ static int UnParcelClientInfo(IpcIo *request, ClientInfo *clientInfo)
     ReadUint32(request, &(clientInfo->clientUid));
 
     DataInfo dataInfo = {NULL, 0};
-    int retCode = UnParcelDataInfo(request, &dataInfo);
+    int retCode = UnParcelClientDataInfo(request, &dataInfo, clientInfo->clientId, (uid_t)GetCallingUid());
     if (retCode == RETCODE_SUCCESS) {
         clientInfo->extendLen = dataInfo.length;
         clientInfo->extendMsg = dataInfo.data;
@@ -93,14 +102,34 @@ static int UnParcelClientInfo(IpcIo *request, ClientInfo *clientInfo)
     return retCode;
 }
 
-static int UnParcelAlgorithmInfo(IpcIo *request, AlgorithmInfo *algorithmInfo)
+static void CheckAlgorithmPriority(AlgorithmInfo *algorithmInfo)
+{
+    if (algorithmInfo->priority < ALGORITHM_PRIORITY_BACKGROUND) {
+        algorithmInfo->priority = ALGORITHM_PRIORITY_BACKGROUND;
+    } else if (algorithmInfo->priority > ALGORITHM_PRIORITY_REALTIME) {
+        algorithmInfo->priority = ALGORITHM_PRIORITY_REALTIME;
+    }
+    // Only system services may jump ahead of the other clients of an engine.
+    if (algorithmInfo->priority == ALGORITHM_PRIORITY_REALTIME) {
+        pid_t callingUid = GetCallingUid();
+        if (callingUid < 0 || callingUid > AIE_REALTIME_MAX_UID) {
+            HILOGW("[SaServer]Uid[%d] is not allowed to request realtime priority.", callingUid);
+            algorithmInfo->priority = ALGORITHM_PRIORITY_NORMAL;
+        }
+    }
+    if (algorithmInfo->timeOut < 0) {
+        algorithmInfo->timeOut = 0;
+    }
+}
+
+static int UnParcelAlgorithmInfo(IpcIo *request, const ClientInfo *clientInfo, AlgorithmInfo *algorithmInfo)
 {
     if (request == NULL) {
         HILOGE("[SaServer]The request is NULL.");
         return RETCODE_FAILURE;
     }
-    if (algorithmInfo == NULL) {
-        HILOGE("[SaServer]The algorithmInfo is NULL.");
+    if (clientInfo == NULL || algorithmInfo == NULL) {
+        HILOGE("[SaServer]The clientInfo or algorithmInfo is NULL.");
         return RETCODE_FAILURE;
     }
     ReadInt64(request, &(algorithmInfo->clientVersion));
@@ -110,9 +139,12 @@ static int UnParcelAlgorithmInfo(IpcIo *request, AlgorithmInfo *algorithmInfo)
     ReadBool(request, &(algorithmInfo->isCloud));
     ReadInt32(request, &(algorithmInfo->operateId));
     ReadInt32(request, &(algorithmInfo->requestId));
+    ReadInt32(request, &(algorithmInfo->priority));
+    ReadInt32(request, &(algorithmInfo->timeOut));
+    CheckAlgorithmPriority(algorithmInfo);
 
     DataInfo dataInfo = {NULL, 0};
-    int retCode = UnParcelDataInfo(request, &dataInfo);
+    int retCode = UnParcelClientDataInfo(request, &dataInfo, clientInfo->clientId, (uid_t)GetCallingUid());
     if (retCode == RETCODE_SUCCESS) {
         algorithmInfo->extendLen = dataInfo.length;
         algorithmInfo->extendMsg = dataInfo.data;
@@ -141,22 +173,56 @@ static void FreeAlgorithmInfo(AlgorithmInfo *algorithmInfo)
     }
 }
 
-static int UnParcelInfo(IpcIo *req, ClientInfo *clientInfo, AlgorithmInfo *algorithmInfo, DataInfo *dataInfo)
+/**
+ * Pop the data infos left in a request whose unparceling has failed, so that the slots of those the client sent
+ * through its shared memory ring are given back to it.
+ */
+static void DiscardDataInfos(IpcIo *req, const ClientInfo *clientInfo, int num)
+{
+    for (int i = 0; i < num; ++i) {
+        DataInfo dataInfo = {0};
+        LentPayload *lent = NULL;
+        if (UnParcelDataInfoInPlace(req, &dataInfo, clientInfo->clientId, (uid_t)GetCallingUid(), &lent) ==
+            RETCODE_SUCCESS) {
+            FreeLentDataInfo(&dataInfo, lent);
+        }
+    }
+}
+
+static int UnParcelClientAndAlgorithmInfo(IpcIo *req, ClientInfo *clientInfo, AlgorithmInfo *algorithmInfo)
 {
     int retCode = UnParcelClientInfo(req, clientInfo);
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[SaServer]UnParcelClientInfo failed, retCode[%d].", retCode);
-        return retCode;
     }
-
-    retCode = UnParcelAlgorithmInfo(req, algorithmInfo);
+    // Popped even after an invalid client info, so that the data infos after it can still be discarded.
+    int algoRetCode = UnParcelAlgorithmInfo(req, clientInfo, algorithmInfo);
+    if (algoRetCode != RETCODE_SUCCESS) {
+        HILOGE("[SaServer]UnParcelAlgorithmInfo failed, retCode[%d].", algoRetCode);
+        retCode = (retCode != RETCODE_SUCCESS) ? retCode : algoRetCode;
+    }
     if (retCode != RETCODE_SUCCESS) {
-        HILOGE("[SaServer]UnParcelAlgorithmInfo failed, retCode[%d].", retCode);
         FreeClientInfo(clientInfo);
+        FreeAlgorithmInfo(algorithmInfo);
+    }
+    return retCode;
+}
+
+static int UnParcelInfo(IpcIo *req, ClientInfo *clientInfo, AlgorithmInfo *algorithmInfo, DataInfo *dataInfo,
+    LentPayload **lent)
+{
+    int retCode = UnParcelClientAndAlgorithmInfo(req, clientInfo, algorithmInfo);
+    if (retCode != RETCODE_SUCCESS) {
+        DiscardDataInfos(req, clientInfo, 1);
         return retCode;
     }
 
-    retCode = UnParcelDataInfo(req, dataInfo);
+    // With a lent, the input is left in place if the client sent it through shared memory, otherwise it is copied.
+    if (lent != NULL) {
+        retCode = UnParcelDataInfoInPlace(req, dataInfo, clientInfo->clientId, (uid_t)GetCallingUid(), lent);
+    } else {
+        retCode = UnParcelClientDataInfo(req, dataInfo, clientInfo->clientId, (uid_t)GetCallingUid());
+    }
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[SaServer]UnParcelDataInfo failed, retCode[%d].", retCode);
         FreeClientInfo(clientInfo);
@@ -172,36 +238,52 @@ static int InitEngine(const ConfigInfo *configInfo)
         HILOGE("[SaServer]Fail to generate client id.");
         return INVALID_CLIENT_ID;
     }
+    // Only the uid which initialized the client may register its shared memory ring.
+    AddShmRingClient(clientId, (uid_t)GetCallingUid());
     return clientId;
 }
 
 static int SyncExecuteAlgorithm(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo, const DataInfo *inputInfo,
-    DataInfo *outputInfo)
+    LentPayload *inputLent, DataInfo *outputInfo)
 {
     if (clientInfo == NULL || algoInfo == NULL) {
         HILOGE("[SaServer]Fail to SyncExecuteAlgorithm, because parameter verification failed.");
         return RETCODE_NULL_PARAM;
     }
-    int retCode = SyncExecAlgoWrapper(clientInfo, algoInfo, inputInfo, outputInfo);
+    int retCode = SyncExecAlgoWrapper(clientInfo, algoInfo, inputInfo, inputLent, outputInfo);
     HILOGD("[SaServer][clientId:%d,sessionId:%d]SyncExecAlgoWrapper finished, retCode is [%d]",
         clientInfo->clientId, clientInfo->sessionId, retCode);
     return retCode;
 }
 
 static int AsyncExecuteAlgorithm(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo,
-    const DataInfo *inputInfo)
+    const DataInfo *inputInfo, LentPayload *inputLent)
 {
     if (clientInfo == NULL || algoInfo == NULL) {
         HILOGE("[SaServer]Fail to AsyncExecuteAlgorithm, because parameter verification failed.");
         return RETCODE_NULL_PARAM;
     }
 
-    int retCode = AsyncExecAlgoWrapper(clientInfo, algoInfo, inputInfo);
+    int retCode = AsyncExecAlgoWrapper(clientInfo, algoInfo, inputInfo, inputLent);
     HILOGD("[SaServer][clientId:%d,sessionId:%d]AsyncExecAlgoWrapper finished, retCode is [%d]",
         clientInfo->clientId, clientInfo->sessionId, retCode);
     return retCode;
 }
 
+static int BatchExecuteAlgorithm(const ClientInfo *clientInfo, const AlgorithmInfo *algoInfo,
+    const DataInfo *inputInfos, LentPayload *const *inputLents, int num, DataInfo *outputInfos, int *retCodes)
+{
+    if (clientInfo == NULL || algoInfo == NULL) {
+        HILOGE("[SaServer]Fail to BatchExecuteAlgorithm, because parameter verification failed.");
+        return RETCODE_NULL_PARAM;
+    }
+
+    int retCode = BatchExecAlgoWrapper(clientInfo, algoInfo, inputInfos, inputLents, num, outputInfos, retCodes);
+    HILOGD("[SaServer][clientId:%d,sessionId:%d]BatchExecAlgoWrapper finished, retCode is [%d]",
+        clientInfo->clientId, clientInfo->sessionId, retCode);
+    return retCode;
+}
+
 static int DestroyEngine(const ClientInfo *clientInfo)
 {
     if (clientInfo == NULL) {
@@ -263,7 +345,7 @@ static int InvokeLoadAlgorithm(AiInterface *aiInterface, IpcIo *req, IpcIo *repl
     ClientInfo clientInfo = {0};
     AlgorithmInfo algorithmInfo = {0};
     DataInfo inputInfo = {0};
-    int retCode = UnParcelInfo(req, &clientInfo, &algorithmInfo, &inputInfo);
+    int retCode = UnParcelInfo(req, &clientInfo, &algorithmInfo, &inputInfo, NULL);
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[SaServer]UnParcelInfo failed, retCode[%d].", retCode);
         return retCode;
@@ -290,7 +372,8 @@ static int InvokeSyncExecute(AiInterface *aiInterface, IpcIo *req, IpcIo *reply)
     ClientInfo clientInfo = {0};
     AlgorithmInfo algorithmInfo = {0};
     DataInfo inputInfo = {0};
-    int retCode = UnParcelInfo(req, &clientInfo, &algorithmInfo, &inputInfo);
+    LentPayload *inputLent = NULL;
+    int retCode = UnParcelInfo(req, &clientInfo, &algorithmInfo, &inputInfo, &inputLent);
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[SaServer]UnParcelInfo failed, retCode[%d].", retCode);
         return retCode;
@@ -300,7 +383,7 @@ static int InvokeSyncExecute(AiInterface *aiInterface, IpcIo *req, IpcIo *reply)
         .data = NULL,
         .length = 0,
     };
-    retCode = aiInterface->SyncExecuteAlgorithm(&clientInfo, &algorithmInfo, &inputInfo, &outputInfo);
+    retCode = aiInterface->SyncExecuteAlgorithm(&clientInfo, &algorithmInfo, &inputInfo, inputLent, &outputInfo);
     WriteInt32(reply, retCode);
     ParcelDataInfo(reply, &outputInfo, clientInfo.clientUid);
     FreeDataInfo(&outputInfo);
@@ -317,13 +400,14 @@ static int InvokeAsyncExecute(AiInterface *aiInterface, IpcIo *req, IpcIo *reply
     ClientInfo clientInfo = {0};
     AlgorithmInfo algorithmInfo = {0};
     DataInfo inputInfo = {0};
-    int retCode = UnParcelInfo(req, &clientInfo, &algorithmInfo, &inputInfo);
+    LentPayload *inputLent = NULL;
+    int retCode = UnParcelInfo(req, &clientInfo, &algorithmInfo, &inputInfo, &inputLent);
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[SaServer]UnParcelInfo failed, retCode[%d].", retCode);
         return retCode;
     }
 
-    retCode = aiInterface->AsyncExecuteAlgorithm(&clientInfo, &algorithmInfo, &inputInfo);
+    retCode = aiInterface->AsyncExecuteAlgorithm(&clientInfo, &algorithmInfo, &inputInfo, inputLent);
     // inputInfo is hold by request, and freed when request is destructed in SaServerAdapter::AsyncExecute().
     FreeClientInfo(&clientInfo);
     FreeAlgorithmInfo(&algorithmInfo);
@@ -331,6 +415,90 @@ static int InvokeAsyncExecute(AiInterface *aiInterface, IpcIo *req, IpcIo *reply
     return retCode;
 }
 
+static int UnParcelBatchInputs(IpcIo *req, const ClientInfo *clientInfo, DataInfo *inputInfos,
+    LentPayload **inputLents, int *num)
+{
+    ReadInt32(req, num);
+    if (*num <= 0 || *num > MAX_BATCH_EXECUTE_NUM) {
+        HILOGE("[SaServer]The number of batched inputs [%d] is invalid.", *num);
+        return RETCODE_INVALID_PARAM;
+    }
+    for (int i = 0; i < *num; ++i) {
+        // Every input is read by the plugin in place, the same as a single execution.
+        int retCode = UnParcelDataInfoInPlace(req, &inputInfos[i], clientInfo->clientId, (uid_t)GetCallingUid(),
+            &inputLents[i]);
+        if (retCode != RETCODE_SUCCESS) {
+            HILOGE("[SaServer]UnParcelDataInfo of input %d failed, retCode[%d].", i, retCode);
+            for (int j = 0; j < i; ++j) {
+                FreeLentDataInfo(&inputInfos[j], inputLents[j]);
+            }
+            DiscardDataInfos(req, clientInfo, *num - i - 1);
+            return retCode;
+        }
+    }
+    return RETCODE_SUCCESS;
+}
+
+// Buffers of one batch, allocated on the heap since they do not fit in the STACK_SIZE of the service task.
+typedef struct {
+    DataInfo inputInfos[MAX_BATCH_EXECUTE_NUM];
+    LentPayload *inputLents[MAX_BATCH_EXECUTE_NUM];
+    DataInfo outputInfos[MAX_BATCH_EXECUTE_NUM];
+    int retCodes[MAX_BATCH_EXECUTE_NUM];
+} BatchBuffer;
+
+static int InvokeBatchExecute(AiInterface *aiInterface, IpcIo *req, IpcIo *reply)
+{
+    HILOGI("[SaServer]InvokeBatchExecute start.");
+    ClientInfo clientInfo = {0};
+    AlgorithmInfo algorithmInfo = {0};
+    int retCode = UnParcelClientAndAlgorithmInfo(req, &clientInfo, &algorithmInfo);
+    BatchBuffer *buffer = NULL;
+    if (retCode == RETCODE_SUCCESS) {
+        buffer = (BatchBuffer *)calloc(1, sizeof(BatchBuffer));
+        if (buffer == NULL) {
+            HILOGE("[SaServer]Failed to allocate the batch buffer.");
+            FreeClientInfo(&clientInfo);
+            FreeAlgorithmInfo(&algorithmInfo);
+            retCode = RETCODE_OUT_OF_MEMORY;
+        }
+    }
+    if (retCode != RETCODE_SUCCESS) {
+        int num = 0;
+        ReadInt32(req, &num);
+        if (num > 0 && num <= MAX_BATCH_EXECUTE_NUM) {
+            DiscardDataInfos(req, &clientInfo, num);
+        }
+        return retCode;
+    }
+    int num = 0;
+    retCode = UnParcelBatchInputs(req, &clientInfo, buffer->inputInfos, buffer->inputLents, &num);
+    if (retCode != RETCODE_SUCCESS) {
+        free(buffer);
+        FreeClientInfo(&clientInfo);
+        FreeAlgorithmInfo(&algorithmInfo);
+        return retCode;
+    }
+
+    retCode = aiInterface->BatchExecuteAlgorithm(&clientInfo, &algorithmInfo, buffer->inputInfos, buffer->inputLents,
+        num, buffer->outputInfos, buffer->retCodes);
+    WriteInt32(reply, retCode);
+    WriteInt32(reply, num);
+    for (int i = 0; i < num; ++i) {
+        WriteInt32(reply, buffer->retCodes[i]);
+        if (!algorithmInfo.isAsync) {
+            ParcelDataInfo(reply, &buffer->outputInfos[i], clientInfo.clientUid);
+            FreeDataInfo(&buffer->outputInfos[i]);
+        }
+    }
+
+    // inputInfos are hold by requests, and freed when the requests are destructed in SaServerAdapter::BatchExecute().
+    free(buffer);
+    FreeClientInfo(&clientInfo);
+    FreeAlgorithmInfo(&algorithmInfo);
+    return retCode;
+}
+
 static int InvokeDestroyEngine(AiInterface *aiInterface, IpcIo *req, IpcIo *reply)
 {
     HILOGI("[SaServer]InvokeDestroyEngine start.");
@@ -352,15 +520,16 @@ static int InvokeSetOption(AiInterface *aiInterface, IpcIo *req, IpcIo *reply)
     HILOGI("[SaServer]InvokeSetOption start.");
     ClientInfo clientInfo = {0};
     int retCode = UnParcelClientInfo(req, &clientInfo);
+    int optionType;
+    ReadInt32(req, &optionType);
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[SaServer]UnParcelClientInfo failed, retCode[%d].", retCode);
+        DiscardDataInfos(req, &clientInfo, 1);
         return retCode;
     }
 
-    int optionType;
-    ReadInt32(req, &optionType);
     DataInfo inputInfo = {0};
-    retCode = UnParcelDataInfo(req, &inputInfo);
+    retCode = UnParcelClientDataInfo(req, &inputInfo, clientInfo.clientId, (uid_t)GetCallingUid());
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[SaServer]UnParcelDataInfo failed, retCode[%d].", retCode);
         FreeClientInfo(&clientInfo);
@@ -380,16 +549,16 @@ static int InvokeGetOption(AiInterface *aiInterface, IpcIo *req, IpcIo *reply)
     HILOGI("[SaServer]InvokeGetOption start.");
     ClientInfo clientInfo = {0};
     int retCode = UnParcelClientInfo(req, &clientInfo);
+    int optionType;
+    ReadInt32(req, &optionType);
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[SaServer]UnParcelClientInfo failed, retCode[%d].", retCode);
+        DiscardDataInfos(req, &clientInfo, 1);
         return retCode;
     }
 
-    int optionType;
-    ReadInt32(req, &optionType);
-
     DataInfo inputInfo = {0};
-    retCode = UnParcelDataInfo(req, &inputInfo);
+    retCode = UnParcelClientDataInfo(req, &inputInfo, clientInfo.clientId, (uid_t)GetCallingUid());
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[SaServer]UnParcelDataInfo failed, retCode[%d].", retCode);
         FreeClientInfo(&clientInfo);
@@ -467,7 +636,7 @@ static int InvokeUnloadAlgorithm(AiInterface *aiInterface, IpcIo *req, IpcIo *re
     ClientInfo clientInfo = {0};
     AlgorithmInfo algorithmInfo = {0};
     DataInfo inputInfo = {0};
-    int retCode = UnParcelInfo(req, &clientInfo, &algorithmInfo, &inputInfo);
+    int retCode = UnParcelInfo(req, &clientInfo, &algorithmInfo, &inputInfo, NULL);
     if (retCode != RETCODE_SUCCESS) {
         return retCode;
     }
@@ -493,6 +662,36 @@ static int UnloadAlgorithm(const ClientInfo *clientInfo, const AlgorithmInfo *al
     return retCode;
 }
 
+static int RegisterClientShmRing(const ClientInfo *clientInfo, int shmId)
+{
+    if (clientInfo == NULL) {
+        HILOGE("[SaServer]Fail to RegisterShmRing, because parameter verification failed.");
+        return RETCODE_NULL_PARAM;
+    }
+    // The ring is bound to the client only if the caller is the uid which initialized it.
+    int retCode = RegisterShmRing(clientInfo->clientId, (uid_t)GetCallingUid(), shmId);
+    HILOGD("[SaServer][clientId:%d]RegisterShmRing finished, retCode is [%d].", clientInfo->clientId, retCode);
+    return retCode;
+}
+
+static int InvokeRegisterShmRing(AiInterface *aiInterface, IpcIo *req, IpcIo *reply)
+{
+    HILOGI("[SaServer]InvokeRegisterShmRing start.");
+    ClientInfo clientInfo = {0};
+    int retCode = UnParcelClientInfo(req, &clientInfo);
+    if (retCode != RETCODE_SUCCESS) {
+        HILOGE("[SaServer]UnParcelClientInfo failed, retCode[%d].", retCode);
+        return retCode;
+    }
+    int shmId = -1;
+    ReadInt32(req, &shmId);
+
+    retCode = aiInterface->RegisterShmRing(&clientInfo, shmId);
+    FreeClientInfo(&clientInfo);
+    WriteInt32(reply, retCode);
+    return retCode;
+}
+
 static int Invoke(IServerProxy *proxy, int funcId, void *origin, IpcIo *req, IpcIo *reply)
 {
     HILOGI("[SaServer]Begin to call Invoke, funcId is [%d].", funcId);
@@ -538,6 +737,14 @@ static int Invoke(IServerProxy *proxy, int funcId, void *origin, IpcIo *req, Ipc
             InvokeUnloadAlgorithm(aiInterface, req, reply);
             break;
         }
+        case ID_BATCH_EXECUTE_ALGORITHM: {
+            InvokeBatchExecute(aiInterface, req, reply);
+            break;
+        }
+        case ID_REGISTER_SHM_RING: {
+            InvokeRegisterShmRing(aiInterface, req, reply);
+            break;
+        }
         default:{
             break;
         }
@@ -561,6 +768,8 @@ static AiEngineService g_aiEngine = {
     .GetOption = GetOption,
     .UnregisterCallback = UnregisterCallback,
     .LoadAlgorithm = LoadAlgorithm,
+    .BatchExecuteAlgorithm = BatchExecuteAlgorithm,
+    .RegisterShmRing = RegisterClientShmRing,
     IPROXY_END,
 };
 
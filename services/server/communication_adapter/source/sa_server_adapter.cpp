@@ -15,9 +15,13 @@
 
 #include "communication_adapter/include/sa_server_adapter.h"
 
+#include <vector>
+
 #include "ipc_skeleton.h"
 #include "securec.h"
 
+#include "platform/os_wrapper/ipc/include/aie_ipc.h"
+#include "platform/time/include/time.h"
 #include "protocol/retcode_inner/aie_retcode_inner.h"
 #include "server_executor/include/i_async_task_manager.h"
 #include "server_executor/include/i_engine_manager.h"
@@ -30,9 +34,14 @@ namespace AI {
 namespace {
 const unsigned int ADAPT_ID_BIT = 32U;
 const int INPUT_LENGTH_NULL = 0;
+
+void ReleaseLentInput(DataInfo *inputInfo, void *lender)
+{
+    FreeLentDataInfo(inputInfo, reinterpret_cast<LentPayload *>(lender));
+}
 }
 
-SaServerAdapter::SaServerAdapter(int adapterId) : adapterId_(adapterId), refCount_(0)
+SaServerAdapter::SaServerAdapter(int adapterId) : adapterId_(adapterId)
 {
 }
 
@@ -51,21 +60,6 @@ int SaServerAdapter::GetAdapterId() const
     return adapterId_;
 }
 
-void SaServerAdapter::IncRef()
-{
-    ++refCount_;
-}
-
-void SaServerAdapter::DecRef()
-{
-    refCount_--;
-}
-
-int SaServerAdapter::GetRefCount() const
-{
-    return refCount_;
-}
-
 void SaServerAdapter::Uninitialize()
 {
     std::lock_guard<std::mutex> guard(mutex_);
@@ -107,10 +101,10 @@ long long SaServerAdapter::GetTransactionId(int sessionId) const
 }
 
 int SaServerAdapter::AsyncExecute(const ClientInfo &clientInfo, const AlgorithmInfo &algoInfo,
-    const DataInfo &inputInfo)
+    const DataInfo &inputInfo, LentPayload *inputLent)
 {
     IRequest *request = nullptr;
-    ConvertToRequest(clientInfo, algoInfo, inputInfo, request);
+    ConvertToRequest(clientInfo, algoInfo, inputInfo, inputLent, request);
     ResGuard<IRequest> guardReq(request);
 
     IAsyncTaskManager *asyncTaskManager = GetAsyncTaskManager();
@@ -131,11 +125,13 @@ int SaServerAdapter::AsyncExecute(const ClientInfo &clientInfo, const AlgorithmI
 }
 
 void SaServerAdapter::ConvertToRequest(const ClientInfo &clientInfo, const AlgorithmInfo &algoInfo,
-    const DataInfo &inputInfo, IRequest *&request)
+    const DataInfo &inputInfo, LentPayload *inputLent, IRequest *&request)
 {
     request = IRequest::Create();
     if (request == nullptr) {
         HILOGE("[SaServerAdapter]Fail to create request.");
+        DataInfo input = inputInfo;
+        FreeLentDataInfo(&input, inputLent);
         return;
     }
     request->SetRequestId(algoInfo.requestId);
@@ -143,7 +139,15 @@ void SaServerAdapter::ConvertToRequest(const ClientInfo &clientInfo, const Algor
     request->SetTransactionId(GetTransactionId(clientInfo.sessionId));
     request->SetAlgoPluginType(algoInfo.algorithmType);
     request->SetMsg(inputInfo);
+    if (inputLent != nullptr) {
+        // The input is left in shared memory of the client, so it is released by the ipc as well.
+        request->SetMsgReleaser(ReleaseLentInput, inputLent);
+    }
     request->SetClientUid(clientInfo.clientUid);
+    request->SetPriority(algoInfo.priority);
+    if (algoInfo.timeOut > 0) {
+        request->SetDeadline(GetSteadyTimeMillSec() + algoInfo.timeOut);
+    }
 }
 
 int SaServerAdapter::LoadAlgorithm(long long transactionId, const AlgorithmInfo &algoInfo,
@@ -216,12 +220,12 @@ void SaServerAdapter::RemoveTransaction(long long transactionId)
 }
 
 int SaServerAdapter::SyncExecute(const ClientInfo &clientInfo, const AlgorithmInfo &algoInfo,
-    const DataInfo &inputInfo, DataInfo &outputInfo)
+    const DataInfo &inputInfo, LentPayload *inputLent, DataInfo &outputInfo)
 {
     IRequest *request = nullptr;
     outputInfo.data = nullptr;
     outputInfo.length = 0;
-    ConvertToRequest(clientInfo, algoInfo, inputInfo, request);
+    ConvertToRequest(clientInfo, algoInfo, inputInfo, inputLent, request);
     if (request == nullptr) {
         HILOGE("[SaServer]Fail to ConvertToRequest.");
         return RETCODE_OUT_OF_MEMORY;
@@ -244,5 +248,54 @@ int SaServerAdapter::SyncExecute(const ClientInfo &clientInfo, const AlgorithmIn
 
     return RETCODE_SUCCESS;
 }
+
+int SaServerAdapter::BatchExecute(const ClientInfo &clientInfo, const AlgorithmInfo &algoInfo,
+    const DataInfo *inputInfos, LentPayload *const *inputLents, int num, DataInfo *outputInfos, int *retCodes)
+{
+    AlgorithmInfo itemAlgoInfo = algoInfo;
+    int retCode = RETCODE_SUCCESS;
+    if (algoInfo.isAsync) {
+        // Every input is sent alone, its result is called back with its own request ID.
+        for (int i = 0; i < num; ++i) {
+            itemAlgoInfo.requestId = algoInfo.requestId + i;
+            retCodes[i] = AsyncExecute(clientInfo, itemAlgoInfo, inputInfos[i], inputLents[i]);
+            if (retCodes[i] != RETCODE_SUCCESS) {
+                retCode = retCodes[i];
+            }
+        }
+        return retCode;
+    }
+
+    std::vector<IRequest *> requests(num, nullptr);
+    std::vector<IResponse *> responses(num, nullptr);
+    for (int i = 0; i < num; ++i) {
+        itemAlgoInfo.requestId = algoInfo.requestId + i;
+        ConvertToRequest(clientInfo, itemAlgoInfo, inputInfos[i], inputLents[i], requests[i]);
+        outputInfos[i].data = nullptr;
+        outputInfos[i].length = 0;
+    }
+    ISyncTaskManager *taskMgr = GetSyncTaskManager();
+    if (taskMgr == nullptr) {
+        HILOGE("[SaServerAdapter]Get task manager failed, ret is %d", RETCODE_OUT_OF_MEMORY);
+        retCode = RETCODE_OUT_OF_MEMORY;
+    } else {
+        retCode = taskMgr->SyncExecuteBatch(requests.data(), requests.size(), responses.data());
+    }
+
+    for (int i = 0; i < num; ++i) {
+        if (responses[i] == nullptr) {
+            retCodes[i] = (requests[i] == nullptr) ? RETCODE_OUT_OF_MEMORY : retCode;
+        } else {
+            retCodes[i] = responses[i]->GetRetCode();
+            if (retCodes[i] == RETCODE_SUCCESS) {
+                outputInfos[i] = responses[i]->GetResult();
+                responses[i]->Detach();
+            }
+            IResponse::Destroy(responses[i]);
+        }
+        IRequest::Destroy(requests[i]);
+    }
+    return retCode;
+}
 } // namespace AI
 } // namespace OHOS
@@ -54,6 +54,7 @@ public:
     int32_t SyncProcess(IRequest *request, IResponse *&response) override;
     int32_t AsyncProcess(IRequest *request, IPluginCallback *callback) override;
     int32_t Release(bool isFullUnload, long long transactionId, const DataInfo &inputInfo) override;
+    bool IsPreloadPrepareSupported() const override;
 
 private:
     int32_t InitComponents(KWSWorkplace &workplace);
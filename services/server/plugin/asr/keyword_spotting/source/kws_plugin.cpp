@@ -79,8 +79,18 @@ KWSPlugin::~KWSPlugin()
     HILOGD("[KWSPlugin]dtor");
 }
 
+bool KWSPlugin::IsPreloadPrepareSupported() const
+{
+    // The prepare output is the encoded model handle, which release decodes and frees.
+    return true;
+}
+
 void KWSPlugin::ReleaseAllHandles()
 {
+    // Destroying the plugin is how an idle engine is unloaded, the model is released here as on a full unload.
+    if (adapter_ == nullptr) {
+        return;
+    }
     for (auto iter = handles_.begin(); iter != handles_.end(); ++iter) {
         (void)adapter_->ReleaseHandle(iter->first);
     }
@@ -47,6 +47,8 @@ public:
     int32_t Release(bool isFullUnload, long long transactionId, const DataInfo &inputInfo) override;
     int32_t SetOption(int32_t optionType, const DataInfo &inputInfo) override;
     int32_t GetOption(int32_t optionType, const DataInfo &inputInfo, DataInfo &outputInfo) override;
+    bool IsPreloadPrepareSupported() const override;
+    bool IsInPlaceInputSupported() const override;
 
 private:
     int32_t BuildConfig(intptr_t handle, ICPluginConfig &config);
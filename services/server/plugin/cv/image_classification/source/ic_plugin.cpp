@@ -158,8 +158,24 @@ int32_t ICPlugin::Release(bool isFullUnload, long long transactionId, const Data
     return RETCODE_SUCCESS;
 }
 
+bool ICPlugin::IsPreloadPrepareSupported() const
+{
+    // The prepare output is the encoded model handle, which release decodes and frees.
+    return true;
+}
+
+bool ICPlugin::IsInPlaceInputSupported() const
+{
+    // The sliced image is only copied into the model input space, the message is never kept or written.
+    return true;
+}
+
 void ICPlugin::ReleaseAllHandles()
 {
+    // Destroying the plugin is how an idle engine is unloaded, the model is released here as on a full unload.
+    if (adapter_ == nullptr) {
+        return;
+    }
     for (auto iter = handles_.begin(); iter != handles_.end(); ++iter) {
         (void)adapter_->ReleaseHandle(iter->first);
     }
@@ -288,7 +304,8 @@ int32_t ICPlugin::SyncProcess(IRequest *request, IResponse *&response)
     }
     intptr_t handle = EMPTY_UINTPTR;
     uint32_t slicedIndex = 0;
-    Array<uint8_t> slicedImage = {0};
+    // The image is not copied out of the input, which may be left in the shared memory of the client.
+    Array<const uint8_t> slicedImage = {0};
     int32_t retCode = EncdecFacade::ProcessDecode(inputInfo, handle, slicedIndex, slicedImage);
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[ICPlugin]Fail to unserialize input data");
@@ -16,6 +16,8 @@
 #ifndef I_PLUGIN_H
 #define I_PLUGIN_H
 
+#include <cstddef>
+
 #include "plugin/i_plugin_callback.h"
 #include "protocol/data_channel/include/i_request.h"
 #include "protocol/data_channel/include/i_response.h"
@@ -77,6 +79,9 @@ public:
     /**
      * Unload model and plugin.
      *
+     * An engine left without clients may stay loaded for the next one, then the last release is not a full
+     * unload and the plugin is destroyed later, its destructor must release the model as a full unload does.
+     *
      * @param [in] isFullUnload Whether to unload completely.
      * @param [in] transactionId Transaction ID.
      * @param [in] inputInfo Data information needed to unload model and plugin.
@@ -102,6 +107,82 @@ public:
      * @return Returns 0 if the operation is successful, returns a non-zero value otherwise.
      */
     virtual int GetOption(int optionType, const DataInfo &inputInfo, DataInfo &outputInfo) = 0;
+
+    /**
+     * Get the capacity of the request queue of the plugin, override it to size the queue for the plugin load.
+     *
+     * @return Maximum number of pending requests, 0 means the default capacity.
+     */
+    virtual size_t GetQueueCapacity() const
+    {
+        return 0;
+    }
+
+    /**
+     * Get the number of engine workers running the plugin concurrently, override it to declare that
+     * {@link SyncProcess} and {@link AsyncProcess} are reentrant.
+     *
+     * @return Number of workers, 1 means requests are processed one at a time.
+     */
+    virtual size_t GetWorkerNum() const
+    {
+        return 1;
+    }
+
+    /**
+     * Get the maximum number of sync requests the plugin infers in one {@link SyncProcessBatch} call,
+     * override it to let the engine coalesce concurrent sync requests.
+     *
+     * @return Maximum batch size, 1 means every request is processed by {@link SyncProcess} on its own.
+     */
+    virtual size_t GetMaxBatchSize() const
+    {
+        return 1;
+    }
+
+    /**
+     * Check whether the model may be initialized ahead of the first client, by a {@link Prepare} with an empty
+     * input and transaction ID -1, followed by a {@link Release} taking the prepare output as its input.
+     * Override it only if that output is a valid release input, e.g. an encoded model handle.
+     *
+     * @return true if preloading may prepare the plugin, false if only its library is preloaded.
+     */
+    virtual bool IsPreloadPrepareSupported() const
+    {
+        return false;
+    }
+
+    /**
+     * Check whether the plugin reads the request message in place, where it may be left in shared memory of the
+     * client. Override it only if the plugin neither writes the message nor keeps it beyond the request.
+     *
+     * @return true if the message may be lent, false if the engine copies it before the plugin gets the request.
+     */
+    virtual bool IsInPlaceInputSupported() const
+    {
+        return false;
+    }
+
+    /**
+     * Algorithmic inference interface for a batch of synchronous tasks, override it together with
+     * {@link GetMaxBatchSize}. The default implementation calls {@link SyncProcess} for each request.
+     *
+     * @param [in] requests Request tasks, num elements.
+     * @param [in] num Number of requests, not greater than the maximum batch size.
+     * @param [out] responses Results of each request, num elements initialized as null.
+     * @return Returns 0 if all requests are processed successfully, returns a non-zero value otherwise.
+     */
+    virtual int SyncProcessBatch(IRequest **requests, size_t num, IResponse **responses)
+    {
+        int retCode = RETCODE_SUCCESS;
+        for (size_t i = 0; i < num; ++i) {
+            int processRetCode = SyncProcess(requests[i], responses[i]);
+            if (processRetCode != RETCODE_SUCCESS) {
+                retCode = processRetCode;
+            }
+        }
+        return retCode;
+    }
 };
 
 typedef IPlugin *(*IPLUGIN_INTERFACE)();
@@ -28,6 +28,8 @@ const std::string ALGORITHM_ID_SAMPLE_2 = "sample_plugin_2";
 const std::string ALGORITHM_ID_KWS = "asr_keyword_spotting";
 const std::string ALGORITHM_ID_IC = "cv_image_classification";
 const std::string ALGORITHM_ID_RC = "cv_card_rectification";
+const std::string ALGORITHM_ID_SAMPLE_3 = "sample_plugin_3";
+const std::string ALGORITHM_ID_SAMPLE_4 = "sample_plugin_4";
 const std::string ALGORITHM_ID_INVALID = "invalid algorithm id";
 
 // Defines the key value of the table field in the .ini file.
@@ -41,6 +43,9 @@ const std::string ALGORITHM_INFO_TABLE_FIELD_NAME_DISTRICT = "District";
 const std::string ALGORITHM_INFO_TABLE_FIELD_NAME_FULLPATH = "FullPath";
 const std::string ALGORITHM_INFO_TABLE_FIELD_NAME_CHKSUM = "ChkSum";
 const std::string ALGORITHM_INFO_TABLE_FIELD_NAME_KEY = "Key";
+// Optional fields lowering the batch size and the number of workers advertised by the plugin.
+const std::string ALGORITHM_INFO_TABLE_FIELD_NAME_MAX_BATCH_SIZE = "MaxBatchSize";
+const std::string ALGORITHM_INFO_TABLE_FIELD_NAME_WORKER_NUM = "WorkerNum";
 
 const std::vector<std::string> ALGORITHM_TYPE_ID_LIST = {
     ALGORITHM_ID_SAMPLE_1,
@@ -48,6 +53,8 @@ const std::vector<std::string> ALGORITHM_TYPE_ID_LIST = {
     ALGORITHM_ID_KWS,
     ALGORITHM_ID_IC,
     ALGORITHM_ID_RC,
+    ALGORITHM_ID_SAMPLE_3,
+    ALGORITHM_ID_SAMPLE_4,
 };
 
 /**
@@ -77,11 +77,19 @@ public:
      */
     std::string GetAid() const;
 
+    /**
+     * Check whether the plugin config has pointed its label to another library since the plugin was loaded.
+     *
+     * @return true if a new library is configured, false otherwise.
+     */
+    bool IsOutdated() const;
+
 private:
     IPlugin *pluginAlgorithm_ {nullptr};
     std::string aid_ {""};
     long long version_ {0};
     void *handle_ {nullptr};
+    std::string libPath_ {""};
 };
 } // namespace AI
 } // namespace OHOS
@@ -16,6 +16,7 @@
 #ifndef PLUGIN_MANAGER_H
 #define PLUGIN_MANAGER_H
 
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -53,6 +54,14 @@ struct PluginKey {
 
 typedef std::map<PluginKey, std::shared_ptr<Plugin>> PluginMap;
 
+struct PluginLoadResult {
+    int retCode;
+    std::shared_ptr<Plugin> plugin;
+};
+
+// Loads in flight, later requesters of the same plugin wait for the result of the first one.
+typedef std::map<PluginKey, std::shared_future<PluginLoadResult>> PluginLoadMap;
+
 class PluginManager : public IPluginManager {
     FORBID_COPY_AND_ASSIGN(PluginManager);
     FORBID_CREATE_BY_SELF(PluginManager);
@@ -74,9 +83,9 @@ private:
     static PluginManager *instance_;
 
 private:
-    std::mutex mutex4Interface_;
     std::mutex mutex_;
     PluginMap pluginMap_;
+    PluginLoadMap loadMap_;
 };
 } // namespace AI
 } // namespace OHOS
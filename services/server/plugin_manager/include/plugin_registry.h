@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PLUGIN_REGISTRY_H
+#define PLUGIN_REGISTRY_H
+
+#include <csignal>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "utils/aie_macros.h"
+
+/**
+ * Plugin config merged from the ini files under services/common/protocol/plugin_config at build time.
+ */
+#ifndef AIE_PLUGIN_CONFIG_PATH
+#define AIE_PLUGIN_CONFIG_PATH "/etc/ai_engine_plugin.ini"
+#endif
+
+namespace OHOS {
+namespace AI {
+struct PluginInfo {
+    std::string aid;
+    long long version = 0;
+    std::string versionName;
+    std::string xpu;
+    std::string fullPath;
+    // Lowers the batch size advertised by the plugin, 0 leaves it to the plugin.
+    size_t maxBatchSize = 0;
+    // Lowers the number of engine workers advertised by the plugin, 0 leaves it to the plugin.
+    size_t workerNum = 0;
+};
+
+class PluginRegistry {
+    FORBID_COPY_AND_ASSIGN(PluginRegistry);
+    FORBID_CREATE_BY_SELF(PluginRegistry);
+public:
+    /**
+     * Get the singleton, the plugin config is loaded on first use.
+     *
+     * @return Pointer to the singleton.
+     */
+    static PluginRegistry *GetInstance();
+
+    /**
+     * Release the singleton instance.
+     */
+    static void ReleaseInstance();
+
+    /**
+     * Rescan the plugin config on SIGHUP, the config is reloaded by the next lookup.
+     */
+    static void InstallRescanSignal();
+
+    /**
+     * Load plugin config, replacing the plugins registered before.
+     *
+     * @param [in] configPath Path of the ini file, a section per plugin labelled "aid+version".
+     * @return Returns RETCODE_SUCCESS(0) if the operation is successful, returns a non-zero value otherwise.
+     */
+    int Load(const std::string &configPath);
+
+    /**
+     * Load the plugin config again from the path it was loaded from.
+     *
+     * @return Returns RETCODE_SUCCESS(0) if the operation is successful, returns a non-zero value otherwise.
+     */
+    int Rescan();
+
+    /**
+     * Find the registered info of a plugin.
+     *
+     * @param [in] aid Algorithm id.
+     * @param [in] version Algorithm version.
+     * @param [out] info Plugin info.
+     * @return true if the plugin is registered, false otherwise.
+     */
+    bool Find(const std::string &aid, long long version, PluginInfo &info);
+
+    /**
+     * Whether a plugin config has been loaded, plugins missing from it are not loaded then.
+     *
+     * @return true if a plugin config has been loaded, false otherwise.
+     */
+    bool IsLoaded();
+
+    /**
+     * Build the label of a plugin, which is the key of the registry and the section name in the ini file.
+     *
+     * @param [in] aid Algorithm id.
+     * @param [in] version Algorithm version.
+     * @return Plugin label.
+     */
+    static std::string GetLabel(const std::string &aid, long long version);
+
+private:
+    using PluginInfos = std::unordered_map<std::string, PluginInfo>;
+    std::shared_ptr<const PluginInfos> GetInfos();
+
+private:
+    static std::mutex instanceLock_;
+    static PluginRegistry *instance_;
+    static volatile sig_atomic_t rescanFlag_;
+
+private:
+    std::mutex mutex_;
+    std::string configPath_;
+    bool isLoaded_;
+    // Replaced as a whole on rescan, lookups keep reading the snapshot they took.
+    std::shared_ptr<const PluginInfos> infos_;
+};
+} // namespace AI
+} // namespace OHOS
+
+#endif // PLUGIN_REGISTRY_H
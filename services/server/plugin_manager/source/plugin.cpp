@@ -58,10 +58,6 @@ Plugin::Plugin(const std::string &aid, long long version)
 Plugin::~Plugin()
 {
     UnloadPluginAlgorithm();
-    PluginLabel *pluginLabel = PluginLabel::GetInstance();
-    if (pluginLabel != nullptr) {
-        pluginLabel->ReleaseInstance();
-    }
 }
 
 int Plugin::LoadPluginAlgorithm()
@@ -104,6 +100,7 @@ int Plugin::LoadPluginAlgorithm()
     handleGuard.Detach();
     pluginAlgorithm_ = pluginAlgorithm;
     handle_ = handle;
+    libPath_ = libPath;
 
     return RETCODE_SUCCESS;
 }
@@ -137,5 +134,15 @@ std::string Plugin::GetAid() const
 {
     return aid_;
 }
+
+bool Plugin::IsOutdated() const
+{
+    PluginLabel *pluginLabel = PluginLabel::GetInstance();
+    CHK_RET(pluginLabel == nullptr || libPath_.empty(), false);
+    long long version = version_;
+    std::string libPath;
+    CHK_RET(pluginLabel->GetLibPath(aid_, version, libPath) != RETCODE_SUCCESS, false);
+    return libPath != libPath_;
+}
 } // namespace AI
 } // namespace OHOS
\ No newline at end of file
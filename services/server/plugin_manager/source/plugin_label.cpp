@@ -15,14 +15,22 @@
 
 #include "plugin_manager/include/plugin_label.h"
 
-#include "plugin_manager/include/aie_plugin_info.h"
+#include <unordered_map>
+
+#include "plugin_manager/include/plugin_registry.h"
 #include "utils/log/aie_log.h"
 
 namespace OHOS {
 namespace AI {
 namespace {
-const std::string PLUS = "+";
-const std::string DELIMITER = ":";
+// Plugins shipped before the plugin config, still found by their label if the config fails to load.
+const std::unordered_map<std::string, std::string> BUILT_IN_LIB_PATHS = {
+    {"cv_card_rectification+20001001", "/usr/lib/libcv_card_rectification.so"},
+    {"sample_plugin_1+1", "/usr/lib/libsample_plugin_1.so"},
+    {"sample_plugin_2+1", "/usr/lib/libsample_plugin_2.so"},
+    {"asr_keyword_spotting+20001002", "/usr/lib/libasr_keyword_spotting.so"},
+    {"cv_image_classification+20001001", "/usr/lib/libcv_image_classification.so"},
+};
 }
 
 std::mutex PluginLabel::instanceLock_;
@@ -55,23 +63,18 @@ PluginLabel::~PluginLabel() = default;
 
 int PluginLabel::GetLibPath(const std::string &aid, long long &version, std::string &libPath)
 {
-    // The label combined algorithm ID and algorithm version
-    std::string label = aid + PLUS + std::to_string(version);
-    auto queryKey = label + DELIMITER + ALGORITHM_INFO_TABLE_FIELD_NAME_FULLPATH;
-    if (label == "cv_card_rectification+20001001") {
-        libPath = "/usr/lib/libcv_card_rectification.so";
-    } else if (label == "sample_plugin_1+1") {
-        libPath = "/usr/lib/libsample_plugin_1.so";
-    } else if (label == "sample_plugin_2+1") {
-        libPath = "/usr/lib/libsample_plugin_2.so";
-    } else if (label == "asr_keyword_spotting+20001002") {
-        libPath = "/usr/lib/libasr_keyword_spotting.so";
-    } else if (label == "cv_image_classification+20001001") {
-        libPath = "/usr/lib/libcv_image_classification.so";
+    PluginRegistry *pluginRegistry = PluginRegistry::GetInstance();
+    PluginInfo pluginInfo;
+    if (pluginRegistry != nullptr && pluginRegistry->Find(aid, version, pluginInfo)) {
+        libPath = pluginInfo.fullPath;
+    } else if (pluginRegistry == nullptr || !pluginRegistry->IsLoaded()) {
+        auto iter = BUILT_IN_LIB_PATHS.find(PluginRegistry::GetLabel(aid, version));
+        if (iter == BUILT_IN_LIB_PATHS.end()) {
+            HILOGE("[PluginLabel]Query lib path failed, no plugin config is loaded.");
+            return RETCODE_FAILURE;
+        }
+        libPath = iter->second;
     } else {
-        libPath = "";
-    }
-    if (libPath.empty()) {
         HILOGE("[PluginLabel]Query lib path failed.");
         return RETCODE_FAILURE;
     }
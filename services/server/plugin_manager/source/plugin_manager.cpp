@@ -16,6 +16,7 @@
 #include "plugin_manager/include/plugin_manager.h"
 
 #include "plugin_manager/include/plugin.h"
+#include "plugin_manager/include/plugin_label.h"
 #include "protocol/retcode_inner/aie_retcode_inner.h"
 #include "utils/aie_macros.h"
 #include "utils/log/aie_log.h"
@@ -26,18 +27,44 @@ int PluginManager::GetPlugin(const std::string &aid, long long version, std::sha
 {
     HILOGI("[PluginManager]Get plugin for server, aid=%s, version=%lld.", aid.c_str(), version);
     PluginKey pluginKey(aid, version);
-    plugin = FindPlugin(pluginKey);
-    if (plugin) {
-        return RETCODE_SUCCESS;
+    std::promise<PluginLoadResult> loadPromise;
+    std::shared_future<PluginLoadResult> loadFuture;
+    bool isLoader = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = pluginMap_.find(pluginKey);
+        // An outdated plugin is replaced by the newly configured library, its engines keep using the old one.
+        if (iter != pluginMap_.end() && !iter->second->IsOutdated()) {
+            plugin = iter->second;
+            return RETCODE_SUCCESS;
+        }
+        auto loadIter = loadMap_.find(pluginKey);
+        if (loadIter != loadMap_.end()) {
+            loadFuture = loadIter->second;
+        } else {
+            isLoader = true;
+            loadFuture = loadPromise.get_future().share();
+            loadMap_.emplace(pluginKey, loadFuture);
+        }
     }
 
-    std::lock_guard<std::mutex> lock(mutex4Interface_);
-    plugin = FindPlugin(pluginKey);
-    if (plugin) {
-        return RETCODE_SUCCESS;
+    if (!isLoader) {
+        // The same plugin is being loaded by another requester, share its result instead of loading it twice.
+        const PluginLoadResult &result = loadFuture.get();
+        plugin = result.plugin;
+        return result.retCode;
     }
 
-    return LoadPlugin(aid, version, plugin);
+    // Loaded without holding any lock, so that requesters of other plugins are not blocked by this one.
+    PluginLoadResult result;
+    result.retCode = LoadPlugin(aid, version, result.plugin);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loadMap_.erase(pluginKey);
+    }
+    loadPromise.set_value(result);
+    plugin = result.plugin;
+    return result.retCode;
 }
 
 std::shared_ptr<Plugin> PluginManager::FindPlugin(const PluginKey &pluginKey)
@@ -79,7 +106,7 @@ void PluginManager::DelPluginByAID(const std::string &aid)
 
 int PluginManager::LoadPlugin(const std::string &aid, long long version, std::shared_ptr<Plugin> &plugin)
 {
-    auto pluginPtr = std::make_shared<Plugin>(Plugin(aid, version));
+    auto pluginPtr = std::make_shared<Plugin>(aid, version);
     if (pluginPtr == nullptr) {
         HILOGE("[PluginManager]The plugin is null.");
         return RETCODE_OUT_OF_MEMORY;
@@ -129,6 +156,8 @@ void PluginManager::Destroy()
     HILOGI("[PluginManager]Begin to Destroy plugin");
     pluginMap_.clear();
     AIE_DELETE(instance_);
+    // Released once no plugin is left, plugins look their labels up while they live.
+    PluginLabel::ReleaseInstance();
 }
 
 PluginManager::PluginManager() = default;
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin_manager/include/plugin_registry.h"
+
+#include <cstdlib>
+#include <fstream>
+
+#include "plugin_manager/include/aie_plugin_info.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "utils/log/aie_log.h"
+
+namespace OHOS {
+namespace AI {
+namespace {
+const std::string PLUS = "+";
+const std::string BLANK_CHARS = " \t\r\n";
+const std::string QUOTE_CHARS = "'\"";
+const char SECTION_BEGIN = '[';
+const char SECTION_END = ']';
+const char KEY_DELIMITER = '=';
+const std::string COMMENT_CHARS = ";#";
+const int DECIMAL_BASE = 10;
+
+std::string Trim(const std::string &str, const std::string &chars)
+{
+    size_t begin = str.find_first_not_of(chars);
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = str.find_last_not_of(chars);
+    return str.substr(begin, end - begin + 1);
+}
+
+bool ParseNumber(const std::string &str, long long &value)
+{
+    if (str.empty()) {
+        return false;
+    }
+    char *end = nullptr;
+    value = strtoll(str.c_str(), &end, DECIMAL_BASE);
+    return (end != nullptr && *end == '\0');
+}
+
+void SetField(PluginInfo &info, const std::string &key, const std::string &value)
+{
+    long long number = 0;
+    if (key == ALGORITHM_INFO_TABLE_FIELD_NAME_AID) {
+        info.aid = value;
+    } else if (key == ALGORITHM_INFO_TABLE_FIELD_NAME_VERSION_CODE) {
+        if (ParseNumber(value, number)) {
+            info.version = number;
+        }
+    } else if (key == ALGORITHM_INFO_TABLE_FIELD_NAME_VERSION_NAME) {
+        info.versionName = value;
+    } else if (key == ALGORITHM_INFO_TABLE_FIELD_NAME_XPU) {
+        info.xpu = value;
+    } else if (key == ALGORITHM_INFO_TABLE_FIELD_NAME_FULLPATH) {
+        info.fullPath = value;
+    } else if (key == ALGORITHM_INFO_TABLE_FIELD_NAME_MAX_BATCH_SIZE) {
+        if (ParseNumber(value, number) && number > 0) {
+            info.maxBatchSize = static_cast<size_t>(number);
+        }
+    } else if (key == ALGORITHM_INFO_TABLE_FIELD_NAME_WORKER_NUM) {
+        if (ParseNumber(value, number) && number > 0) {
+            info.workerNum = static_cast<size_t>(number);
+        }
+    }
+}
+
+void AddInfo(std::unordered_map<std::string, PluginInfo> &infos, const PluginInfo &info)
+{
+    if (info.aid.empty() || info.fullPath.empty()) {
+        return;
+    }
+    infos[PluginRegistry::GetLabel(info.aid, info.version)] = info;
+}
+}
+
+std::mutex PluginRegistry::instanceLock_;
+PluginRegistry *PluginRegistry::instance_ = nullptr;
+volatile sig_atomic_t PluginRegistry::rescanFlag_ = 0;
+
+PluginRegistry *PluginRegistry::GetInstance()
+{
+    CHK_RET(instance_ != nullptr, instance_);
+
+    std::lock_guard<std::mutex> lock(instanceLock_);
+    CHK_RET(instance_ != nullptr, instance_);
+
+    PluginRegistry *temp = nullptr;
+    AIE_NEW(temp, PluginRegistry);
+    CHK_RET(temp == nullptr, nullptr);
+
+    if (temp->Load(AIE_PLUGIN_CONFIG_PATH) != RETCODE_SUCCESS) {
+        HILOGW("[PluginRegistry]No plugin config, only the built-in plugins are found.");
+    }
+    instance_ = temp;
+    return instance_;
+}
+
+void PluginRegistry::ReleaseInstance()
+{
+    std::lock_guard<std::mutex> lock(instanceLock_);
+    AIE_DELETE(instance_);
+}
+
+void PluginRegistry::InstallRescanSignal()
+{
+    // Only a flag is set in the handler, reading files is not async-signal-safe.
+    (void)signal(SIGHUP, [](int) { rescanFlag_ = 1; });
+}
+
+PluginRegistry::PluginRegistry() : isLoaded_(false), infos_(std::make_shared<const PluginInfos>())
+{
+}
+
+PluginRegistry::~PluginRegistry() = default;
+
+std::string PluginRegistry::GetLabel(const std::string &aid, long long version)
+{
+    // The label combined algorithm ID and algorithm version
+    return aid + PLUS + std::to_string(version);
+}
+
+int PluginRegistry::Load(const std::string &configPath)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        configPath_ = configPath;
+    }
+    std::ifstream file(configPath);
+    if (!file.is_open()) {
+        HILOGE("[PluginRegistry]Failed to open plugin config.");
+        return RETCODE_FAILURE;
+    }
+
+    std::shared_ptr<PluginInfos> infos = std::make_shared<PluginInfos>();
+    PluginInfo info;
+    bool inSection = false;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = Trim(line, BLANK_CHARS);
+        if (line.empty() || COMMENT_CHARS.find(line[0]) != std::string::npos) {
+            continue;
+        }
+        if (line[0] == SECTION_BEGIN && line.back() == SECTION_END) {
+            if (inSection) {
+                AddInfo(*infos, info);
+            }
+            info = PluginInfo();
+            inSection = true;
+            continue;
+        }
+        size_t pos = line.find(KEY_DELIMITER);
+        if (!inSection || pos == std::string::npos) {
+            continue;
+        }
+        std::string key = Trim(line.substr(0, pos), BLANK_CHARS);
+        std::string value = Trim(Trim(line.substr(pos + 1), BLANK_CHARS), QUOTE_CHARS);
+        SetField(info, key, value);
+    }
+    if (inSection) {
+        AddInfo(*infos, info);
+    }
+
+    HILOGI("[PluginRegistry]Registered %zu plugins.", infos->size());
+    std::lock_guard<std::mutex> lock(mutex_);
+    infos_ = infos;
+    isLoaded_ = true;
+    return RETCODE_SUCCESS;
+}
+
+int PluginRegistry::Rescan()
+{
+    std::string configPath;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        configPath = configPath_;
+    }
+    HILOGI("[PluginRegistry]Rescan plugin config.");
+    return Load(configPath);
+}
+
+std::shared_ptr<const PluginRegistry::PluginInfos> PluginRegistry::GetInfos()
+{
+    if (rescanFlag_ != 0) {
+        rescanFlag_ = 0;
+        (void)Rescan();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return infos_;
+}
+
+bool PluginRegistry::Find(const std::string &aid, long long version, PluginInfo &info)
+{
+    std::shared_ptr<const PluginInfos> infos = GetInfos();
+    auto iter = infos->find(GetLabel(aid, version));
+    CHK_RET(iter == infos->end(), false);
+    info = iter->second;
+    return true;
+}
+
+bool PluginRegistry::IsLoaded()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return isLoaded_;
+}
+} // namespace AI
+} // namespace OHOS
@@ -22,14 +22,16 @@
 #include "protocol/data_channel/include/i_request.h"
 #include "protocol/data_channel/include/i_response.h"
 #include "server_executor/include/future.h"
+#include "server_executor/include/client_qos.h"
 #include "server_executor/include/i_handler.h"
+#include "server_executor/include/shared_executor.h"
 #include "server_executor/include/task.h"
 
 namespace OHOS {
 namespace AI {
 class AsyncMsgHandler : public IHandler, public IPluginCallback {
 public:
-    AsyncMsgHandler(Queue<Task> &queue, IPlugin *pluginAlgorithm);
+    AsyncMsgHandler(Queue<Task> &queue, IPlugin *pluginAlgorithm, SharedExecutor *executor = nullptr);
     ~AsyncMsgHandler() override = default;
 
     /**
@@ -56,6 +58,21 @@ public:
      */
     void SetPluginAlgorithm(IPlugin *pluginAlgorithm) override;
 
+    /**
+     * Answer the task with the error code without calling the plugin.
+     *
+     * @param [in] task Task not to be processed.
+     * @param [in] retCode Error code returned to the client.
+     */
+    void Reject(const Task &task, int retCode) override;
+
+    /**
+     * Check whether the plugin is reentrant.
+     *
+     * @return true if the plugin declares more than one worker, false otherwise.
+     */
+    bool IsReentrant() const override;
+
     /**
      * Encapsulates the request as a task and puts it in the task queue.
      *
@@ -67,6 +84,8 @@ public:
 private:
     Queue<Task> &queue_;
     IPlugin *pluginAlgorithm_;
+    SharedExecutor *executor_;
+    ClientQuota quota_;
 };
 } // namespace AI
 } // namespace OHOS
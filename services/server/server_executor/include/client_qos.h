@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLIENT_QOS_H
+#define CLIENT_QOS_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+
+#include "platform/lock/include/biased_rw_lock.h"
+#include "protocol/data_channel/include/i_request.h"
+#include "utils/aie_macros.h"
+
+/**
+ * Maximum number of pending requests of one client in an engine, 0 means half of the engine queue capacity.
+ * It is configured by gn arg ai_engine_client_queue_depth.
+ */
+#ifndef AIE_CLIENT_QUEUE_DEPTH
+#define AIE_CLIENT_QUEUE_DEPTH 0
+#endif
+
+/**
+ * Weight and queue depth limit of chosen clients, entries of the form "uid:weight:depth" separated by commas.
+ * It is configured by gn arg ai_engine_client_qos.
+ */
+#ifndef AIE_CLIENT_QOS
+#define AIE_CLIENT_QOS ""
+#endif
+
+namespace OHOS {
+namespace AI {
+/**
+ * Scheduling weight and queue depth limit of clients, looked up by client UID.
+ */
+class ClientQosConfig {
+    FORBID_COPY_AND_ASSIGN(ClientQosConfig);
+    FORBID_CREATE_BY_SELF(ClientQosConfig);
+public:
+    /**
+     * Use singleton pattern.
+     *
+     * @return Pointer to the singleton.
+     */
+    static ClientQosConfig *GetInstance();
+
+    /**
+     * Destroy the singleton.
+     */
+    static void ReleaseInstance();
+
+    /**
+     * Load the weights and depth limits of clients, e.g. "1000:4:64,2000:1:8". A weight or depth of 0 keeps
+     * the default, invalid entries are skipped.
+     *
+     * @param [in] qosList Entries of the form "uid:weight:depth" separated by commas.
+     * @return Number of entries loaded.
+     */
+    size_t LoadConfig(const std::string &qosList);
+
+    /**
+     * Set the weight of a client, it is served weight times as many requests per round as a client of weight 1.
+     *
+     * @param [in] clientUid Client UID.
+     * @param [in] weight Weight of the client, 0 restores the default weight.
+     */
+    void SetWeight(uid_t clientUid, size_t weight);
+
+    /**
+     * Get the weight of a client.
+     *
+     * @param [in] clientUid Client UID.
+     * @return Weight of the client, 1 if not set.
+     */
+    size_t GetWeight(uid_t clientUid);
+
+    /**
+     * Set the maximum number of pending requests of a client in an engine.
+     *
+     * @param [in] clientUid Client UID.
+     * @param [in] depthLimit Maximum number of pending requests, 0 restores the default limit.
+     */
+    void SetDepthLimit(uid_t clientUid, size_t depthLimit);
+
+    /**
+     * Get the maximum number of pending requests of a client in an engine.
+     *
+     * @param [in] clientUid Client UID.
+     * @param [in] queueCapacity Capacity of the engine queue, the default limit is derived from it.
+     * @return Maximum number of pending requests.
+     */
+    size_t GetDepthLimit(uid_t clientUid, size_t queueCapacity);
+
+private:
+    static std::mutex instanceMutex_;
+    static ClientQosConfig *instance_;
+
+    // Looked up for every queued request and only changed when the config is loaded, so readers do not contend.
+    BiasedRwLock rwLock_;
+    std::map<uid_t, size_t> weights_;
+    std::map<uid_t, size_t> depthLimits_;
+};
+
+/**
+ * Pending requests of each client in an engine, so that a client flooding the engine is refused alone, however
+ * many transactions it opens.
+ */
+class ClientQuota {
+    FORBID_COPY_AND_ASSIGN(ClientQuota);
+public:
+    ClientQuota() = default;
+    ~ClientQuota() = default;
+
+    /**
+     * Count a request in, unless its client has reached the depth limit of the client.
+     *
+     * @param [in] request Request to be queued.
+     * @param [in] queueCapacity Capacity of the engine queue.
+     * @return true if the request is counted in, false if the client has too many pending requests.
+     */
+    bool Acquire(const IRequest *request, size_t queueCapacity);
+
+    /**
+     * Count a request out, when it is processed, rejected or failed to be queued.
+     *
+     * @param [in] clientUid UID of the client of the request.
+     */
+    void Release(uid_t clientUid);
+
+private:
+    std::mutex mutex_;
+    std::map<uid_t, size_t> pendingNums_;
+};
+} // namespace AI
+} // namespace OHOS
+
+#endif // CLIENT_QOS_H
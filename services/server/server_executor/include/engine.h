@@ -17,15 +17,21 @@
 #define ENGINE_H
 
 #include <memory>
+#include <vector>
 
 #include "platform/queuepool/queue.h"
 #include "plugin_manager/include/i_plugin_manager.h"
 #include "plugin_manager/include/plugin.h"
+#include "plugin_manager/include/plugin_registry.h"
 #include "protocol/data_channel/include/i_request.h"
 #include "protocol/data_channel/include/i_response.h"
 #include "server_executor/include/engine_worker.h"
+#include "server_executor/include/execution_slot.h"
+#include "server_executor/include/fair_queue.h"
 #include "server_executor/include/future.h"
 #include "server_executor/include/i_handler.h"
+#include "server_executor/include/shared_executor.h"
+#include "server_executor/include/task_scheduler.h"
 
 namespace OHOS {
 namespace AI {
@@ -35,6 +41,7 @@ const char * const PLUGIN_SYNC_INFER = "SYNC";
 class Engine {
 public:
     Engine(std::shared_ptr<Plugin> &plugin, std::shared_ptr<Thread> &thread, std::shared_ptr<Queue<Task>> &queue);
+    Engine(std::shared_ptr<Plugin> &plugin, SharedExecutor *executor, std::shared_ptr<Queue<Task>> &queue);
     ~Engine();
 
     /**
@@ -72,6 +79,17 @@ public:
      */
     int SyncExecute(IRequest *request, IResponse *&response);
 
+    /**
+     * Algorithmic execution interface for synchronous tasks sent together.
+     * All requests are queued before the first response is waited for, so the plugin may process them as a batch.
+     *
+     * @param [in] requests Request information of synchronous tasks.
+     * @param [in] num Number of requests.
+     * @param [out] responses Responses of synchronous tasks, nullptr for a request failed before it is executed.
+     * @return Returns 0 if every request is executed, returns the error of a failed one otherwise.
+     */
+    int SyncExecuteBatch(IRequest *const *requests, size_t num, IResponse **responses);
+
     /**
      * Algorithmic execution interface for asynchronous tasks.
      *
@@ -81,15 +99,28 @@ public:
     int AsyncExecute(IRequest *request);
 
 private:
+    int StartWorkers();
     void Uninitialize();
 
 private:
     std::atomic<int> refCount_;
     std::shared_ptr<Plugin> plugin_;
-    std::shared_ptr<Thread> thread_;
     std::shared_ptr<Queue<Task>> queue_;
     IHandler *msgHandler_;
-    EngineWorker worker_;
+    // Capabilities of the plugin from the plugin config.
+    PluginInfo pluginInfo_;
+    SharedExecutor *executor_;
+
+    TaskScheduler scheduler_;
+    FairQueue fairQueue_;
+
+    // Whether sync callers run the plugin on their own thread when the engine is idle.
+    bool callerRuns_;
+    ExecutionSlot slot_;
+
+    // Workers consuming queue_, more than one only if the plugin is reentrant.
+    std::vector<std::shared_ptr<Thread>> threads_;
+    std::vector<std::unique_ptr<EngineWorker>> workers_;
 };
 } // namespace AI
 } // namespace OHOS
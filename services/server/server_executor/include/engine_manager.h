@@ -16,10 +16,15 @@
 #ifndef ENGINE_MANAGER_H
 #define ENGINE_MANAGER_H
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <list>
 #include <map>
+#include <vector>
 
-#include "platform/lock/include/rw_lock.h"
+#include "platform/lock/include/biased_rw_lock.h"
+#include "platform/queuepool/queue_pool.h"
 #include "server_executor/include/engine.h"
 
 namespace OHOS {
@@ -30,6 +35,30 @@ const size_t MAX_SYNC_MSG_NUM = 64;
 // Asynchronous message default size
 const size_t MAX_ASYNC_MSG_NUM = 64;
 
+/**
+ * Time in milliseconds an engine without clients stays loaded, 0 unloads it as soon as its last client leaves.
+ * It is configured by gn arg ai_engine_idle_ttl_ms.
+ */
+#ifndef AIE_ENGINE_IDLE_TTL_MS
+#define AIE_ENGINE_IDLE_TTL_MS 30000
+#endif
+
+/**
+ * Maximum number of engines without clients staying loaded, the least recently used one is unloaded first.
+ * It is configured by gn arg ai_engine_idle_max_num.
+ */
+#ifndef AIE_ENGINE_IDLE_MAX_NUM
+#define AIE_ENGINE_IDLE_MAX_NUM 2
+#endif
+
+/**
+ * Upper limit in bytes of memory held by the busy and idle queues of the engines.
+ * It is configured by gn arg ai_engine_queue_pool_memory_budget.
+ */
+#ifndef AIE_QUEUE_POOL_MEMORY_BUDGET
+#define AIE_QUEUE_POOL_MEMORY_BUDGET QUEUE_POOL_MEMORY_BUDGET
+#endif
+
 struct EngineKey {
     std::string aid;
     long long version;
@@ -52,7 +81,13 @@ struct EngineKey {
 
 class EngineManager {
 public:
-    EngineManager();
+    /**
+     * Constructor.
+     *
+     * @param [in] idleTtlMs Time in milliseconds an engine without clients stays loaded, 0 unloads it at once.
+     * @param [in] idleMaxNum Maximum number of engines without clients staying loaded.
+     */
+    explicit EngineManager(long long idleTtlMs = AIE_ENGINE_IDLE_TTL_MS, size_t idleMaxNum = AIE_ENGINE_IDLE_MAX_NUM);
     ~EngineManager();
 
     /**
@@ -113,21 +148,63 @@ public:
     int GetOption(long long transactionId, int optionType, const DataInfo &inputInfo,
         DataInfo &outputInfo);
 
+    /**
+     * Query the statistics of idle engines.
+     *
+     * @param [out] hitNum Number of engine starts served by an idle engine.
+     * @param [out] missNum Number of engine starts loading the plugin.
+     * @param [out] idleNum Number of engines staying loaded without clients.
+     */
+    void GetIdleEngineStats(size_t &hitNum, size_t &missNum, size_t &idleNum);
+
+    /**
+     * Load the plugin of an engine ahead of its first client, the engine stays loaded until the manager is released.
+     *
+     * @param [in] engineKey Algorithm ID and version of the engine.
+     * @param [in] isPrepare Whether to initialize the model by a prepare and release round trip as well, only done
+     *             for plugins supporting it, see {@link IPlugin::IsPreloadPrepareSupported}.
+     * @return Returns RETCODE_SUCCESS(0) if the operation is successful, returns a non-zero value otherwise.
+     */
+    int PreloadEngine(const EngineKey &engineKey, bool isPrepare);
+
 private:
     void Uninitialize();
     void RecordClient(long long transactionId, const std::shared_ptr<Engine> &engine);
     void UnRecordClient(long long transactionId);
     int CreateEngine(const EngineKey &engineKey, std::shared_ptr<Engine> &engine);
-    int CreateEngineWithCheck(const EngineKey &engineKey, std::shared_ptr<Engine> &engine);
-    std::shared_ptr<Engine> FindEngine(const EngineKey &engineKey);
-    void DelEngine(const EngineKey &engineKey);
+    int CreateSharedEngine(std::shared_ptr<Plugin> &plugin, SharedExecutor *executor,
+        std::shared_ptr<Queue<Task>> &queue, std::shared_ptr<Engine> &engine);
+    int AcquireEngine(const EngineKey &engineKey, std::shared_ptr<Engine> &engine);
+    bool ReuseEngine(const EngineKey &engineKey, std::shared_ptr<Engine> &engine);
+    static bool IsOutdated(const std::shared_ptr<Engine> &engine);
+    void RetireEngine(const EngineKey &engineKey);
+    void ReleaseEngine(const std::shared_ptr<Engine> &engine);
+    void TrimIdleEngines(size_t maxIdleNum);
+    void UnloadEngine(const EngineKey &engineKey);
 
 private:
-    RwLock rwLock_;
+    BiasedRwLock rwLock_;
     using Engines = std::map<EngineKey, std::shared_ptr<Engine>>;
     Engines engines_;
     using ClientEngines = std::map<long long, std::shared_ptr<Engine>>;
+    // Looked up on every request, guarded by a lock of its own so that readers never wait for an engine
+    // being loaded or unloaded under rwLock_.
+    BiasedRwLock clientLock_;
     ClientEngines clientEngines_;
+
+    // Engines without clients, guarded by rwLock_. The most recently released one is at the front.
+    struct IdleEngine {
+        std::list<EngineKey>::iterator lruIter;
+        std::chrono::steady_clock::time_point idleTime;
+    };
+    std::list<EngineKey> idleLru_;
+    std::map<EngineKey, IdleEngine> idleEngines_;
+    long long idleTtlMs_;
+    size_t idleMaxNum_;
+    std::atomic<size_t> idleHitNum_;
+    std::atomic<size_t> idleMissNum_;
+    // Engines referenced by the manager itself, guarded by rwLock_.
+    std::vector<std::shared_ptr<Engine>> preloadEngines_;
 };
 } // namespace AI
 } // namespace OHOS
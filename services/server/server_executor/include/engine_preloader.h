@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENGINE_PRELOADER_H
+#define ENGINE_PRELOADER_H
+
+#include <string>
+#include <vector>
+
+#include "platform/threadpool/include/thread.h"
+#include "server_executor/include/engine_manager.h"
+
+/**
+ * Plugins loaded in the background when the service starts, labels of the form "aid+version" separated by
+ * commas, e.g. "cv_image_classification+20001001". It is configured by gn arg ai_engine_preload_plugins.
+ */
+#ifndef AIE_PRELOAD_PLUGINS
+#define AIE_PRELOAD_PLUGINS ""
+#endif
+
+namespace OHOS {
+namespace AI {
+class EnginePreloader : public IWorker {
+public:
+    /**
+     * Constructor.
+     *
+     * @param [in] engineManager Engine manager keeping the preloaded engines.
+     * @param [in] preloadList Labels of the plugins to preload, separated by commas.
+     * @param [in] isPrepare Whether to initialize the model of each plugin as well.
+     */
+    EnginePreloader(EngineManager &engineManager, const std::string &preloadList, bool isPrepare);
+    ~EnginePreloader() override = default;
+
+    /**
+     * Get worker name, and cannot return null.
+     *
+     * @return Worker name.
+     */
+    const char *GetName() const override;
+
+    /**
+     * Preload one plugin of the list per call.
+     *
+     * @return true more plugins are left, false every plugin of the list is preloaded.
+     */
+    bool OneAction() override;
+
+    /**
+     * Whether the preload list names no valid plugin.
+     *
+     * @return true nothing to preload, false otherwise.
+     */
+    bool IsEmpty() const;
+
+private:
+    EngineManager &engineManager_;
+    std::vector<EngineKey> engineKeys_;
+    size_t index_;
+    bool isPrepare_;
+};
+} // namespace AI
+} // namespace OHOS
+
+#endif // ENGINE_PRELOADER_H
@@ -16,6 +16,8 @@
 #ifndef ENGINE_WORKER_H
 #define ENGINE_WORKER_H
 
+#include <vector>
+
 #include "protocol/retcode_inner/aie_retcode_inner.h"
 
 #include "platform/queuepool/queue.h"
@@ -24,13 +26,42 @@
 #include "platform/threadpool/include/thread_pool.h"
 #include "protocol/data_channel/include/i_request.h"
 #include "protocol/data_channel/include/i_response.h"
+#include "server_executor/include/execution_slot.h"
+#include "server_executor/include/fair_queue.h"
 #include "server_executor/include/task.h"
+#include "server_executor/include/task_scheduler.h"
+
+/**
+ * Maximum number of tasks the engine worker takes from its queue per wakeup.
+ * It is configured by gn arg ai_engine_worker_batch_size.
+ */
+#ifndef AIE_ENGINE_WORKER_BATCH_SIZE
+#define AIE_ENGINE_WORKER_BATCH_SIZE 16
+#endif
+
+/**
+ * Maximum time in milliseconds the engine worker waits for more sync requests to fill a batch of a plugin
+ * advertising batched inference. It is configured by gn arg ai_engine_batch_wait_time_ms.
+ */
+#ifndef AIE_SYNC_BATCH_WAIT_TIME_MS
+#define AIE_SYNC_BATCH_WAIT_TIME_MS 2
+#endif
 
 namespace OHOS {
 namespace AI {
 class EngineWorker : public IWorker {
 public:
-    explicit EngineWorker(Queue<Task> &queue);
+    /**
+     * Constructor.
+     *
+     * @param [in] queue Task queue of the engine.
+     * @param [in] scheduler Orders the tasks asking for priority or deadline, shared by workers of the engine.
+     * @param [in] fairQueue Shares the engine among its clients, shared by workers of the engine.
+     * @param [in] slot Taken around each plugin call if sync callers may run the plugin themselves, may be null.
+     * @param [in] batchSize Maximum number of tasks taken from the queue per wakeup, at least 1.
+     */
+    EngineWorker(Queue<Task> &queue, TaskScheduler &scheduler, FairQueue &fairQueue, ExecutionSlot *slot = nullptr,
+        size_t batchSize = AIE_ENGINE_WORKER_BATCH_SIZE);
     ~EngineWorker() override = default;
 
     /**
@@ -52,8 +83,21 @@ public:
      */
     void Uninitialize() override;
 
+private:
+    bool IsSingleFlow(size_t taskNum) const;
+    static bool IsSameTransaction(const Task &lhs, const Task &rhs);
+    size_t CoalesceBatch(size_t popNum);
+    void ProcessTasks(size_t taskNum);
+
 private:
     Queue<Task> &queue_;
+    TaskScheduler &scheduler_;
+    FairQueue &fairQueue_;
+    ExecutionSlot *slot_;
+    std::vector<Task> tasks_;
+
+    // Number of tasks of the last batch, the worker only waits to fill a batch when requests arrive concurrently.
+    size_t lastBatchNum_;
 };
 } // namespace AI
 } // namespace OHOS
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXECUTION_SLOT_H
+#define EXECUTION_SLOT_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "utils/aie_macros.h"
+
+namespace OHOS {
+namespace AI {
+/**
+ * Counts the plugin calls an engine may run at the same time, one for a non-reentrant plugin.
+ * Engine workers wait for a slot, while a sync caller only takes one if it is free right away.
+ */
+class ExecutionSlot {
+    FORBID_COPY_AND_ASSIGN(ExecutionSlot);
+public:
+    ExecutionSlot();
+    ~ExecutionSlot() = default;
+
+    /**
+     * Set the number of slots, it is called before any slot is taken.
+     *
+     * @param [in] slotNum Number of slots, at least 1.
+     */
+    void Reset(size_t slotNum);
+
+    /**
+     * Take a slot without waiting.
+     *
+     * @return true if a slot is taken, false if all slots are busy.
+     */
+    bool TryAcquire();
+
+    /**
+     * Take a slot, wait until one is released if all slots are busy.
+     */
+    void Acquire();
+
+    /**
+     * Release a slot taken by {@link TryAcquire} or {@link Acquire}.
+     */
+    void Release();
+
+private:
+    std::atomic<size_t> freeNum_;
+    std::atomic<size_t> waiterNum_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+};
+} // namespace AI
+} // namespace OHOS
+
+#endif // EXECUTION_SLOT_H
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FAIR_QUEUE_H
+#define FAIR_QUEUE_H
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+
+#include "server_executor/include/task.h"
+#include "utils/aie_macros.h"
+
+namespace OHOS {
+namespace AI {
+/**
+ * Ready tasks of an engine kept in one sub-queue per transaction and served by deficit round robin,
+ * so that clients sharing the engine get turns in proportion to the weights of their UIDs
+ * (see {@link ClientQosConfig}) whatever their request rates are.
+ */
+class FairQueue {
+    FORBID_COPY_AND_ASSIGN(FairQueue);
+public:
+    FairQueue();
+    ~FairQueue() = default;
+
+    /**
+     * Add a task to the sub-queue of its transaction.
+     *
+     * @param [in] task Task to add.
+     */
+    void Push(const Task &task);
+
+    /**
+     * Take tasks in deficit round robin order, each visited transaction is served up to its weight per round.
+     *
+     * @param [out] tasks Buffer of at least maxNum tasks.
+     * @param [in] maxNum Maximum number of tasks to take.
+     * @return Number of tasks taken.
+     */
+    size_t PopBulk(Task *tasks, size_t maxNum);
+
+    /**
+     * Query the number of tasks.
+     *
+     * @return Number of tasks.
+     */
+    size_t Count() const;
+
+    /**
+     * Check whether there is no task.
+     *
+     * @return true if empty, false otherwise.
+     */
+    bool IsEmpty() const;
+
+private:
+    struct SubQueue {
+        std::deque<Task> tasks;
+        size_t weight;
+        size_t deficit;
+    };
+
+    std::mutex mutex_;
+    std::map<long long, SubQueue> subQueues_;
+    // Transactions having tasks, in the order they are visited.
+    std::deque<long long> activeList_;
+    std::atomic<size_t> count_;
+};
+} // namespace AI
+} // namespace OHOS
+
+#endif // FAIR_QUEUE_H
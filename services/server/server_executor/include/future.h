@@ -19,6 +19,7 @@
 #include <memory>
 #include <ctime>
 
+#include "platform/objectpool/object_pool.h"
 #include "platform/semaphore/include/i_semaphore.h"
 #include "plugin/i_plugin_callback.h"
 #include "protocol/data_channel/include/i_request.h"
@@ -36,6 +37,8 @@ public:
 
     ~Future() override;
 
+    DECLARE_OBJECT_POOL_ALLOCATION(Future);
+
     IResponse *GetResponse(int timeOut) const override;
 
     /**
@@ -79,7 +82,7 @@ private:
     IResponse *response_;
     FutureStatus status_;
 
-    std::shared_ptr<ISemaphore> semaphore_;
+    ISemaphore *semaphore_;
 };
 } // namespace AI
 } // namespace OHOS
@@ -18,8 +18,11 @@
 
 #include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <vector>
 
+#include "platform/lock/include/biased_rw_lock.h"
 #include "plugin/i_plugin_callback.h"
 #include "protocol/data_channel/include/request.h"
 #include "protocol/data_channel/include/response.h"
@@ -28,6 +31,14 @@
 #include "server_executor/include/i_future_listener.h"
 #include "utils/aie_macros.h"
 
+/**
+ * Maximum number of in-flight async requests of the server.
+ * It is configured by gn arg ai_engine_max_future_num.
+ */
+#ifndef AIE_MAX_FUTURE_NUM
+#define AIE_MAX_FUTURE_NUM 1024
+#endif
+
 namespace OHOS {
 namespace AI {
 class FutureFactory {
@@ -78,26 +89,31 @@ public:
     int ProcessResponse(PluginEvent event, IResponse *response);
 
 private:
-    void AddFuture(long long sequenceId, Future* future);
+    using FutureListeners = std::map<long long, std::shared_ptr<IFutureListener>>;
 
-    void DeleteFuture(long long sequenceId);
+    // A future lives in slot (sequenceId % slot number), tagged with its sequence ID.
+    struct FutureSlot {
+        std::mutex mutex;
+        long long sequenceId = 0;
+        Future *future = nullptr;
+    };
 
-    Future* FetchFuture(Response *response);
+    void DeleteFuture(long long sequenceId);
 
-    IFutureListener *FindListener(long long transactionId);
+    Future *TakeFuture(long long sequenceId);
 
-    long long FindSequenceId();
+    std::shared_ptr<IFutureListener> FindListener(long long transactionId) const;
 
 private:
     static std::mutex mutex_;
     static FutureFactory *instance_;
 
 private:
-    std::mutex innerMutex_;
-    using Futures = std::map<long long, Future*>;
-    Futures futures_;
+    std::vector<FutureSlot> slots_;
     std::atomic<long long> sequenceId_;
-    using FutureListeners = std::map<long long, IFutureListener*>;
+
+    // Responses look listeners up far more often than clients come and go, readers do not contend on the lock.
+    mutable BiasedRwLock listenerLock_;
     FutureListeners listeners_;
 };
 } // namespace AI
@@ -36,6 +36,50 @@ public:
      */
     virtual int Process(const Task &task) = 0;
 
+    /**
+     * Interface to process consecutive tasks of the handler, override it to process them together.
+     *
+     * @param [in] tasks Tasks need to be processed.
+     * @param [in] num Number of tasks, not greater than {@link GetMaxBatchSize}.
+     * @return Returns RETCODE_SUCCESS(0) if the operation is successful, returns a non-zero value otherwise.
+     */
+    virtual int ProcessBatch(const Task *tasks, size_t num)
+    {
+        int retCode = RETCODE_SUCCESS;
+        for (size_t i = 0; i < num; ++i) {
+            int processRetCode = Process(tasks[i]);
+            if (processRetCode != RETCODE_SUCCESS) {
+                retCode = processRetCode;
+            }
+        }
+        return retCode;
+    }
+
+    /**
+     * Get the maximum number of tasks the handler processes together.
+     *
+     * @return Maximum batch size, 1 if tasks are processed one by one.
+     */
+    virtual size_t GetMaxBatchSize() const
+    {
+        return 1;
+    }
+
+    /**
+     * Answer a task with an error instead of processing it, e.g. when its deadline has passed.
+     *
+     * @param [in] task Task not to be processed.
+     * @param [in] retCode Error code returned to the client.
+     */
+    virtual void Reject(const Task &task, int retCode) = 0;
+
+    /**
+     * Check whether tasks of different transactions may be processed concurrently by the handler.
+     *
+     * @return true if the plugin declares more than one worker, false otherwise.
+     */
+    virtual bool IsReentrant() const = 0;
+
     /**
      * Set plugin algorithm, override by sync and async message handler.
      *
@@ -16,6 +16,8 @@
 #ifndef I_SYNC_TASK_MANAGER_H
 #define I_SYNC_TASK_MANAGER_H
 
+#include <cstddef>
+
 #include "protocol/data_channel/include/i_request.h"
 #include "protocol/data_channel/include/i_response.h"
 
@@ -33,6 +35,16 @@ public:
      * @return Returns RETCODE_SUCCESS(0) if the operation is successful, returns a non-zero value otherwise.
      */
     virtual int SyncExecute(IRequest *request, IResponse *&response) = 0;
+
+    /**
+     * Interface to sync execute requests of one session together, they are all queued before the first is waited for.
+     *
+     * @param [in] requests Input infos.
+     * @param [in] num Number of requests.
+     * @param [out] responses Output infos, nullptr for a request failed before it is executed.
+     * @return Returns RETCODE_SUCCESS(0) if every request is executed, returns the error of a failed one otherwise.
+     */
+    virtual int SyncExecuteBatch(IRequest *const *requests, size_t num, IResponse **responses) = 0;
 };
 
 /**
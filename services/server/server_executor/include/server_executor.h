@@ -16,6 +16,7 @@
 #ifndef SERVER_EXECUTOR_H
 #define SERVER_EXECUTOR_H
 
+#include <memory>
 #include <mutex>
 
 #include "platform/queuepool/queue.h"
@@ -24,6 +25,7 @@
 #include "platform/threadpool/include/thread_pool.h"
 #include "protocol/struct_definition/aie_info_define.h"
 #include "server_executor/include/engine_manager.h"
+#include "server_executor/include/engine_preloader.h"
 #include "server_executor/include/i_async_task_manager.h"
 #include "server_executor/include/i_engine_manager.h"
 #include "server_executor/include/i_future_listener.h"
@@ -57,6 +59,16 @@ public:
      */
     int SyncExecute(IRequest *request, IResponse *&response) override;
 
+    /**
+     * Process sync execute requests of one session together.
+     *
+     * @param [in] requests Algorithm inputs.
+     * @param [in] num Number of requests.
+     * @param [out] responses Algorithm outputs, nullptr for a request failed before it is executed.
+     * @return Returns RETCODE_SUCCESS(0) if every request is executed, returns the error of a failed one otherwise.
+     */
+    int SyncExecuteBatch(IRequest *const *requests, size_t num, IResponse **responses) override;
+
     /**
      * process async execute request
      *
@@ -128,6 +140,8 @@ public:
 private:
     int Initialize();
     void Uninitialize();
+    void StartPreload();
+    void StopPreload();
 
 private:
     static std::mutex mutex_;
@@ -135,6 +149,8 @@ private:
 
 private:
     EngineManager *engineMgr_;
+    std::unique_ptr<EnginePreloader> preloader_;
+    std::shared_ptr<Thread> preloadThread_;
 };
 } // namespace AI
 } // namespace OHOS
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHARED_EXECUTOR_H
+#define SHARED_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "platform/queuepool/queue.h"
+#include "platform/queuepool/work_stealing_deque.h"
+#include "platform/threadpool/include/thread.h"
+#include "server_executor/include/i_handler.h"
+#include "server_executor/include/task.h"
+#include "utils/aie_macros.h"
+
+/**
+ * Number of shared executor workers, 0 means the number of cores.
+ * It is configured by gn arg ai_engine_executor_thread_num.
+ */
+#ifndef AIE_SHARED_EXECUTOR_THREAD_NUM
+#define AIE_SHARED_EXECUTOR_THREAD_NUM 0
+#endif
+
+namespace OHOS {
+namespace AI {
+class SharedExecutor;
+
+class SharedExecutorWorker : public IWorker {
+public:
+    SharedExecutorWorker(SharedExecutor &executor, size_t index);
+    ~SharedExecutorWorker() override = default;
+
+    /**
+     * Get worker name, and cannot return null.
+     *
+     * @return Worker name.
+     */
+    const char *GetName() const override;
+
+    /**
+     * Bind the worker index to the running thread, so that tasks submitted from this thread go to its own deque.
+     *
+     * @return true always.
+     */
+    bool Initialize() override;
+
+    /**
+     * Run one scheduled transaction or wait for one to be submitted.
+     *
+     * @return true thread is running, false thread is stop.
+     */
+    bool OneAction() override;
+
+    /**
+     * Unbind the worker index from the running thread.
+     */
+    void Uninitialize() override;
+
+private:
+    SharedExecutor &executor_;
+    size_t index_;
+};
+
+/**
+ * Fixed-size pool of workers shared by all engines, instead of one dedicated thread per engine.
+ *
+ * Tasks of the same transaction are chained in a strand and run one by one in submission order,
+ * while different transactions of a reentrant engine run in parallel. All tasks of a non-reentrant
+ * engine share one strand. Strand state is sharded by handler, so engines do not contend on one lock.
+ * Each worker owns a lock-free deque and inbox of ready strands, and steals from the others when both are empty.
+ */
+class SharedExecutor {
+    FORBID_COPY_AND_ASSIGN(SharedExecutor);
+    FORBID_CREATE_BY_SELF(SharedExecutor);
+    friend class SharedExecutorWorker;
+public:
+    /**
+     * Use singleton pattern.
+     *
+     * @return Pointer to the singleton.
+     */
+    static SharedExecutor *GetInstance();
+
+    /**
+     * Stop the workers and destroy the singleton.
+     */
+    static void ReleaseInstance();
+
+    /**
+     * Start workers.
+     *
+     * @param [in] threadNum Number of workers, 0 means the number of cores.
+     * @return Returns RETCODE_SUCCESS(0) if the operation is successful, returns a non-zero value otherwise.
+     */
+    int Initialize(size_t threadNum);
+
+    /**
+     * Check whether the workers are started.
+     *
+     * @return true if started, false otherwise.
+     */
+    bool IsRunning() const;
+
+    /**
+     * Query the number of workers.
+     *
+     * @return Number of workers.
+     */
+    size_t ThreadNum() const;
+
+    /**
+     * Submit a task, it runs after the previously submitted tasks of the same transaction,
+     * or of the same handler if the handler is not reentrant.
+     *
+     * @param [in] task Task to run, task.handler is called to process it.
+     * @return Returns RETCODE_SUCCESS(0) if the operation is successful, returns a non-zero value otherwise.
+     */
+    int Submit(const Task &task);
+
+    /**
+     * Query the number of submitted but unfinished tasks of the handler.
+     *
+     * @param [in] handler Message handler of the engine.
+     * @return Number of pending tasks.
+     */
+    size_t Count(const IHandler *handler);
+
+    /**
+     * Drop the queued tasks of the handler and wait for its running tasks to finish.
+     * It is called before the handler is destroyed.
+     *
+     * @param [in] handler Message handler of the engine.
+     */
+    void Clear(const IHandler *handler);
+
+private:
+    // Handler of the tasks, and transaction ID or SERIAL_STRAND_ID for a non-reentrant handler.
+    typedef std::pair<const IHandler*, long long> StrandKey;
+
+    struct Strand {
+        StrandKey key;
+        std::deque<Task> tasks;
+    };
+
+    // Strands and pending task numbers of the handlers hashed to the shard. A strand exists while it is
+    // queued or running, so the pointers held by the work deques stay valid.
+    struct Shard {
+        std::mutex mutex;
+        std::map<StrandKey, Strand> strands;
+        std::map<const IHandler*, size_t> pendingNums;
+        std::condition_variable finishCond;
+    };
+
+    struct WorkDeque {
+        WorkDeque();
+
+        // Strands submitted by the owner worker, other workers steal from the top.
+        WorkStealingDeque<Strand*> strands;
+        // Strands submitted by other threads and strands requeued by the owner, popped by any worker in order.
+        Queue<Strand*> inbox;
+    };
+
+    void Uninitialize();
+    void RunOnce(size_t index);
+    bool PopStrand(size_t index, Strand *&strand);
+    void PushStrand(Strand *strand, bool isRequeue);
+    void RunStrand(Strand *strand);
+    Shard &GetShard(const IHandler *handler);
+    void DecreasePendingNum(Shard &shard, const IHandler *handler);
+
+private:
+    static const size_t SHARD_NUM = 16;
+
+    static std::mutex instanceMutex_;
+    static SharedExecutor *instance_;
+
+    std::atomic<bool> running_;
+    std::atomic<bool> stopping_;
+    std::atomic<size_t> nextIndex_;
+
+    Shard shards_[SHARD_NUM];
+
+    std::vector<std::unique_ptr<WorkDeque>> deques_;
+    std::vector<std::unique_ptr<SharedExecutorWorker>> workers_;
+    std::vector<std::shared_ptr<Thread>> threads_;
+
+    // Strands which fit in no inbox, only used when all inboxes are full.
+    std::mutex overflowMutex_;
+    std::deque<Strand*> overflowStrands_;
+    std::atomic<size_t> overflowNum_;
+
+    // Number of strands waiting in deques, idle workers sleep until it is not zero.
+    std::atomic<size_t> queuedNum_;
+    // Number of sleeping workers, submitters only take readyMutex_ to wake them when it is not zero.
+    std::atomic<size_t> idleNum_;
+    std::mutex readyMutex_;
+    std::condition_variable readyCond_;
+};
+} // namespace AI
+} // namespace OHOS
+
+#endif // SHARED_EXECUTOR_H
@@ -22,7 +22,9 @@
 #include "protocol/data_channel/include/i_request.h"
 #include "protocol/data_channel/include/i_response.h"
 #include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "server_executor/include/client_qos.h"
 #include "server_executor/include/i_handler.h"
+#include "server_executor/include/shared_executor.h"
 #include "server_executor/include/task.h"
 #include "utils/aie_macros.h"
 
@@ -30,7 +32,7 @@ namespace OHOS {
 namespace AI {
 class SyncMsgHandler : public IHandler {
 public:
-    SyncMsgHandler(Queue<Task> &queue, IPlugin *pluginAlgorithm);
+    SyncMsgHandler(Queue<Task> &queue, IPlugin *pluginAlgorithm, SharedExecutor *executor = nullptr);
 
     ~SyncMsgHandler() override = default;
 
@@ -42,6 +44,48 @@ public:
      */
     int Process(const Task &task) override;
 
+    /**
+     * Run the plugin on the request and build its response, on the calling thread.
+     *
+     * @param [in] request Request to process.
+     * @param [out] response Response of the request, its retcode tells whether the plugin succeeded.
+     * @return Returns RETCODE_SUCCESS(0) if the operation is successful, returns a non-zero value otherwise.
+     */
+    int Execute(IRequest *request, IResponse *&response);
+
+    /**
+     * Run a request on the calling thread in place of queuing it, under the same client quota and deadline
+     * checks as a queued request.
+     *
+     * @param [in] request Request to process.
+     * @param [out] response Response of the request, its retcode tells whether the plugin succeeded.
+     * @return Returns RETCODE_SUCCESS(0) if the operation is successful, returns a non-zero value otherwise.
+     */
+    int ExecuteOnCaller(IRequest *request, IResponse *&response);
+
+    /**
+     * Deal with consecutive sync tasks by one batched call of the plugin, then answer each of them.
+     *
+     * @param [in] tasks Tasks need to be processed.
+     * @param [in] num Number of tasks, not greater than {@link GetMaxBatchSize}.
+     * @return Returns RETCODE_SUCCESS(0) if the operation is successful, returns a non-zero value otherwise.
+     */
+    int ProcessBatch(const Task *tasks, size_t num) override;
+
+    /**
+     * Get the maximum batch size advertised by the plugin, bounded by the capacity of the queue.
+     *
+     * @return Maximum batch size, 1 if the plugin does not process batches.
+     */
+    size_t GetMaxBatchSize() const override;
+
+    /**
+     * Lower the batch size advertised by the plugin, e.g. to fit the memory of the XPU.
+     *
+     * @param [in] batchSizeLimit Upper limit of the batch size, 0 means no limit.
+     */
+    void SetBatchSizeLimit(size_t batchSizeLimit);
+
     /**
      * Set pluginAlgorithm.
      *
@@ -49,6 +93,21 @@ public:
      */
     void SetPluginAlgorithm(IPlugin *pluginAlgorithm) override;
 
+    /**
+     * Answer the task with the error code without calling the plugin.
+     *
+     * @param [in] task Task not to be processed.
+     * @param [in] retCode Error code returned to the client.
+     */
+    void Reject(const Task &task, int retCode) override;
+
+    /**
+     * Check whether the plugin is reentrant.
+     *
+     * @return true if the plugin declares more than one worker, false otherwise.
+     */
+    bool IsReentrant() const override;
+
     /**
      * Add request to the end of processing queue.
      *
@@ -71,6 +130,9 @@ public:
 private:
     Queue<Task> &queue_;
     IPlugin *pluginAlgorithm_;
+    SharedExecutor *executor_;
+    ClientQuota quota_;
+    size_t batchSizeLimit_;
 };
 } // namespace AI
 } // namespace OHOS
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <atomic>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+#include "server_executor/include/task.h"
+#include "utils/aie_macros.h"
+
+namespace OHOS {
+namespace AI {
+/**
+ * Ready tasks of an engine ordered by priority class, then by deadline (earliest first), then by arrival.
+ * Tasks of normal priority without deadline bypass it, so it is only involved when clients ask for it.
+ */
+class TaskScheduler {
+    FORBID_COPY_AND_ASSIGN(TaskScheduler);
+public:
+    TaskScheduler();
+    ~TaskScheduler() = default;
+
+    /**
+     * Check whether the task asks for priority or deadline scheduling.
+     *
+     * @param [in] task Task to check.
+     * @return true if the priority is not normal or the task has a deadline, false otherwise.
+     */
+    static bool IsScheduled(const Task &task);
+
+    /**
+     * Check whether the deadline of the task has passed.
+     *
+     * @param [in] task Task to check.
+     * @param [in] now Current time in milliseconds, as GetSteadyTimeMillSec.
+     * @return true if the task has a deadline earlier than now, false otherwise.
+     */
+    static bool IsExpired(const Task &task, long long now);
+
+    /**
+     * Add a task.
+     *
+     * @param [in] task Task to add.
+     */
+    void Push(const Task &task);
+
+    /**
+     * Take the most urgent task.
+     *
+     * @param [out] task Task taken.
+     * @return true if a task is taken, false if there is no task.
+     */
+    bool Pop(Task &task);
+
+    /**
+     * Take the most urgent task if its priority class is not lower than minPriority.
+     *
+     * @param [out] task Task taken.
+     * @param [in] minPriority Lowest priority class to take, see {@link AlgorithmPriority}.
+     * @return true if a task is taken, false otherwise.
+     */
+    bool Pop(Task &task, int minPriority);
+
+    /**
+     * Check whether there is no task.
+     *
+     * @return true if empty, false otherwise.
+     */
+    bool IsEmpty() const;
+
+private:
+    struct Entry {
+        int priority;
+        long long deadline;
+        unsigned long long sequence;
+        Task task;
+    };
+
+    struct EntryCompare {
+        // Returns true if lhs is served after rhs.
+        bool operator()(const Entry &lhs, const Entry &rhs) const;
+    };
+
+    std::mutex mutex_;
+    std::priority_queue<Entry, std::vector<Entry>, EntryCompare> entries_;
+    unsigned long long sequence_;
+    std::atomic<size_t> count_;
+};
+} // namespace AI
+} // namespace OHOS
+
+#endif // TASK_SCHEDULER_H
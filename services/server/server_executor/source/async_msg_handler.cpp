@@ -25,8 +25,8 @@
 
 namespace OHOS {
 namespace AI {
-AsyncMsgHandler::AsyncMsgHandler(Queue<Task> &g_queue, IPlugin *pluginAlgorithm)
-    : queue_(g_queue), pluginAlgorithm_(pluginAlgorithm)
+AsyncMsgHandler::AsyncMsgHandler(Queue<Task> &g_queue, IPlugin *pluginAlgorithm, SharedExecutor *executor)
+    : queue_(g_queue), pluginAlgorithm_(pluginAlgorithm), executor_(executor)
 {
 }
 
@@ -43,6 +43,7 @@ int AsyncMsgHandler::Process(const Task &task)
         return RETCODE_NULL_PARAM;
     }
 
+    quota_.Release(request->GetClientUid());
     ResGuard<IRequest> guardReq(request);
     return pluginAlgorithm_->AsyncProcess(request, this);
 }
@@ -58,14 +59,32 @@ int AsyncMsgHandler::OnEvent(PluginEvent event, IResponse *response)
     return futureFactory->ProcessResponse(event, response);
 }
 
-void AsyncMsgHandler::SetPluginAlgorithm(IPlugin *pluginAlgorithm)
+void AsyncMsgHandler::Reject(const Task &task, int retCode)
 {
-    pluginAlgorithm_ = pluginAlgorithm;
+    IRequest *request = task.request;
+    CHK_RET_NONE(request == nullptr);
+    quota_.Release(request->GetClientUid());
+    ResGuard<IRequest> guardReq(request);
+
+    IResponse *response = IResponse::Create(request);
+    if (response == nullptr) {
+        HILOGE("[AsyncMsgHandler]Failed to create response.");
+        return;
+    }
+    response->SetRetCode(retCode);
+    if (OnEvent(ON_PLUGIN_FAIL, response) != RETCODE_SUCCESS) {
+        HILOGE("[AsyncMsgHandler]Failed to reply rejected request.");
+    }
+}
+
+bool AsyncMsgHandler::IsReentrant() const
+{
+    return (pluginAlgorithm_ != nullptr) && (pluginAlgorithm_->GetWorkerNum() > 1);
 }
 
-size_t GetAsyncMsgQueueCapacity()
+void AsyncMsgHandler::SetPluginAlgorithm(IPlugin *pluginAlgorithm)
 {
-    return MAX_ASYNC_MSG_NUM;
+    pluginAlgorithm_ = pluginAlgorithm;
 }
 
 int AsyncMsgHandler::SendRequest(IRequest *request)
@@ -75,7 +94,8 @@ int AsyncMsgHandler::SendRequest(IRequest *request)
         return RETCODE_NULL_PARAM;
     }
 
-    if (queue_.Count() >= GetAsyncMsgQueueCapacity()) {
+    size_t pendingNum = (executor_ != nullptr) ? executor_->Count(this) : queue_.Count();
+    if (pendingNum >= queue_.Capacity()) {
         HILOGE("[AsyncMsgHandler]Task queue overload");
         return RETCODE_QUEUE_FULL;
     }
@@ -83,14 +103,26 @@ int AsyncMsgHandler::SendRequest(IRequest *request)
     FutureFactory *futureFactory = FutureFactory::GetInstance();
     CHK_RET(futureFactory == nullptr, RETCODE_NULL_PARAM);
 
+    // A client flooding the engine is refused alone, the others keep their share of the queue.
+    if (!quota_.Acquire(request, queue_.Capacity())) {
+        HILOGE("[AsyncMsgHandler]Client task queue overload");
+        return RETCODE_QUEUE_FULL;
+    }
+
+    uid_t clientUid = request->GetClientUid();
     int retCode = futureFactory->CreateFuture(request);
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[AsyncMsgHandler]Create future for async msg failed");
+        quota_.Release(clientUid);
         return retCode;
     }
 
     Task task(this, request, nullptr);
-    return queue_.PushBack(task);
+    retCode = (executor_ != nullptr) ? executor_->Submit(task) : queue_.PushBack(task);
+    if (retCode != RETCODE_SUCCESS) {
+        quota_.Release(clientUid);
+    }
+    return retCode;
 }
 } // namespace AI
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "server_executor/include/client_qos.h"
+
+#include <cstdio>
+
+#include "utils/log/aie_log.h"
+
+namespace OHOS {
+namespace AI {
+namespace {
+const size_t DEFAULT_CLIENT_WEIGHT = 1;
+const size_t DEFAULT_DEPTH_DIVISOR = 2;
+const size_t MIN_DEPTH_LIMIT = 1;
+const char ENTRY_SEPARATOR = ',';
+const int QOS_FIELD_NUM = 3;
+
+bool ParseEntry(const std::string &entry, uid_t &clientUid, size_t &weight, size_t &depthLimit)
+{
+    unsigned int uid = 0;
+    unsigned int weightValue = 0;
+    unsigned int depthValue = 0;
+    char tail = '\0';
+    if (sscanf(entry.c_str(), " %u : %u : %u %c", &uid, &weightValue, &depthValue, &tail) != QOS_FIELD_NUM) {
+        return false;
+    }
+    clientUid = static_cast<uid_t>(uid);
+    weight = weightValue;
+    depthLimit = depthValue;
+    return true;
+}
+}
+
+std::mutex ClientQosConfig::instanceMutex_;
+ClientQosConfig *ClientQosConfig::instance_ = nullptr;
+
+ClientQosConfig *ClientQosConfig::GetInstance()
+{
+    CHK_RET(instance_ != nullptr, instance_);
+
+    std::lock_guard<std::mutex> lock(instanceMutex_);
+    CHK_RET(instance_ != nullptr, instance_);
+
+    ClientQosConfig *tempInstance = nullptr;
+    AIE_NEW(tempInstance, ClientQosConfig);
+    CHK_RET(tempInstance == nullptr, nullptr);
+
+    instance_ = tempInstance;
+    return instance_;
+}
+
+void ClientQosConfig::ReleaseInstance()
+{
+    std::lock_guard<std::mutex> lock(instanceMutex_);
+    AIE_DELETE(instance_);
+}
+
+ClientQosConfig::ClientQosConfig() = default;
+
+ClientQosConfig::~ClientQosConfig() = default;
+
+size_t ClientQosConfig::LoadConfig(const std::string &qosList)
+{
+    size_t loadedNum = 0;
+    size_t begin = 0;
+    while (begin < qosList.size()) {
+        size_t end = qosList.find(ENTRY_SEPARATOR, begin);
+        if (end == std::string::npos) {
+            end = qosList.size();
+        }
+        std::string entry = qosList.substr(begin, end - begin);
+        begin = end + 1;
+        if (entry.find_first_not_of(" \t") == std::string::npos) {
+            continue;
+        }
+        uid_t clientUid = 0;
+        size_t weight = 0;
+        size_t depthLimit = 0;
+        if (!ParseEntry(entry, clientUid, weight, depthLimit)) {
+            HILOGW("[ClientQosConfig]Invalid client qos entry %s, skip it.", entry.c_str());
+            continue;
+        }
+        SetWeight(clientUid, weight);
+        SetDepthLimit(clientUid, depthLimit);
+        ++loadedNum;
+    }
+    return loadedNum;
+}
+
+void ClientQosConfig::SetWeight(uid_t clientUid, size_t weight)
+{
+    WriteGuard<BiasedRwLock> guard(rwLock_);
+    if (weight == 0) {
+        weights_.erase(clientUid);
+        return;
+    }
+    weights_[clientUid] = weight;
+}
+
+size_t ClientQosConfig::GetWeight(uid_t clientUid)
+{
+    ReadGuard<BiasedRwLock> guard(rwLock_);
+    auto iter = weights_.find(clientUid);
+    return (iter == weights_.end()) ? DEFAULT_CLIENT_WEIGHT : iter->second;
+}
+
+void ClientQosConfig::SetDepthLimit(uid_t clientUid, size_t depthLimit)
+{
+    WriteGuard<BiasedRwLock> guard(rwLock_);
+    if (depthLimit == 0) {
+        depthLimits_.erase(clientUid);
+        return;
+    }
+    depthLimits_[clientUid] = depthLimit;
+}
+
+size_t ClientQosConfig::GetDepthLimit(uid_t clientUid, size_t queueCapacity)
+{
+    {
+        ReadGuard<BiasedRwLock> guard(rwLock_);
+        auto iter = depthLimits_.find(clientUid);
+        if (iter != depthLimits_.end()) {
+            return iter->second;
+        }
+    }
+    size_t depthLimit = AIE_CLIENT_QUEUE_DEPTH;
+    if (depthLimit == 0) {
+        depthLimit = queueCapacity / DEFAULT_DEPTH_DIVISOR;
+    }
+    return (depthLimit < MIN_DEPTH_LIMIT) ? MIN_DEPTH_LIMIT : depthLimit;
+}
+
+bool ClientQuota::Acquire(const IRequest *request, size_t queueCapacity)
+{
+    CHK_RET(request == nullptr, false);
+    ClientQosConfig *config = ClientQosConfig::GetInstance();
+    CHK_RET(config == nullptr, false);
+    size_t depthLimit = config->GetDepthLimit(request->GetClientUid(), queueCapacity);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t &pendingNum = pendingNums_[request->GetClientUid()];
+    CHK_RET(pendingNum >= depthLimit, false);
+    ++pendingNum;
+    return true;
+}
+
+void ClientQuota::Release(uid_t clientUid)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = pendingNums_.find(clientUid);
+    CHK_RET_NONE(iter == pendingNums_.end());
+    if (--iter->second == 0) {
+        pendingNums_.erase(iter);
+    }
+}
+} // namespace AI
+} // namespace OHOS
@@ -16,9 +16,12 @@
 #include "server_executor/include/engine.h"
 
 #include <cstring>
+#include <deque>
+#include <thread>
 
 #include "platform/time/include/time.h"
 #include "plugin_manager/include/aie_plugin_info.h"
+#include "plugin_manager/include/plugin_registry.h"
 #include "server_executor/include/async_msg_handler.h"
 #include "server_executor/include/sync_msg_handler.h"
 #include "utils/constants/constants.h"
@@ -26,14 +29,35 @@
 
 namespace OHOS {
 namespace AI {
+namespace {
+#ifdef AIE_CALLER_RUNS
+const bool CALLER_RUNS = true;
+#else
+const bool CALLER_RUNS = false;
+#endif
+}
+
 Engine::Engine(std::shared_ptr<Plugin> &plugin, std::shared_ptr<Thread> &thread,
     std::shared_ptr<Queue<Task>> &queue)
     : refCount_(0),
       plugin_(plugin),
-      thread_(thread),
       queue_(queue),
       msgHandler_(nullptr),
-      worker_(*queue)
+      executor_(nullptr),
+      callerRuns_(false)
+{
+    if (thread != nullptr) {
+        threads_.push_back(thread);
+    }
+}
+
+Engine::Engine(std::shared_ptr<Plugin> &plugin, SharedExecutor *executor, std::shared_ptr<Queue<Task>> &queue)
+    : refCount_(0),
+      plugin_(plugin),
+      queue_(queue),
+      msgHandler_(nullptr),
+      executor_(executor),
+      callerRuns_(false)
 {
 }
 
@@ -51,6 +75,22 @@ static bool IsSyncMode(const std::shared_ptr<Plugin> &plugin)
     return (strcmp(PLUGIN_SYNC_INFER, inferMode) == 0);
 }
 
+/**
+ * Copy a message lent from shared memory of the client, unless the plugin reads it in place.
+ */
+static int TakeLentMsg(const std::shared_ptr<Plugin> &plugin, IRequest *request)
+{
+    if (plugin->GetPluginAlgorithm()->IsInPlaceInputSupported()) {
+        return RETCODE_SUCCESS;
+    }
+    int retCode = request->CopyLentMsg();
+    if (retCode != RETCODE_SUCCESS) {
+        HILOGE("[Engine][transactionId:%lld]Copy lent message failed, retCode is [%d].",
+            request->GetTransactionId(), retCode);
+    }
+    return retCode;
+}
+
 std::shared_ptr<Plugin> Engine::GetPlugin() const
 {
     return plugin_;
@@ -76,10 +116,19 @@ int Engine::Initialize()
     if (plugin_->GetPluginAlgorithm() == nullptr) {
         return RETCODE_NULL_PARAM;
     }
+    PluginRegistry *pluginRegistry = PluginRegistry::GetInstance();
+    if (pluginRegistry == nullptr || !pluginRegistry->Find(plugin_->GetAid(), plugin_->GetVersion(), pluginInfo_)) {
+        pluginInfo_ = PluginInfo();
+    }
     if (IsSyncMode(plugin_)) {
-        AIE_NEW(msgHandler_, SyncMsgHandler(*queue_, plugin_->GetPluginAlgorithm()));
+        SyncMsgHandler *syncMsgHandler = nullptr;
+        AIE_NEW(syncMsgHandler, SyncMsgHandler(*queue_, plugin_->GetPluginAlgorithm(), executor_));
+        if (syncMsgHandler != nullptr) {
+            syncMsgHandler->SetBatchSizeLimit(pluginInfo_.maxBatchSize);
+        }
+        msgHandler_ = syncMsgHandler;
     } else {
-        AIE_NEW(msgHandler_, AsyncMsgHandler(*queue_, plugin_->GetPluginAlgorithm()));
+        AIE_NEW(msgHandler_, AsyncMsgHandler(*queue_, plugin_->GetPluginAlgorithm(), executor_));
     }
     if (msgHandler_ == nullptr) {
         HILOGE("[Engine]Allocate massage handler failed, algoType is [%lld], algoName is [%s].",
@@ -87,24 +136,72 @@ int Engine::Initialize()
         return RETCODE_OUT_OF_MEMORY;
     }
 
-    bool isStarted = thread_->StartThread(&worker_);
-    if (!isStarted) {
-        AIE_DELETE(msgHandler_);
-        HILOGE("[Engine]Engine(aid is [%s], version is [%lld]) start thread failed.",
-            plugin_->GetAid().c_str(), plugin_->GetVersion());
-        return RETCODE_START_THREAD_FAILED;
+    if (executor_ != nullptr) {
+        return RETCODE_SUCCESS;
+    }
+    return StartWorkers();
+}
+
+int Engine::StartWorkers()
+{
+    CHK_RET(threads_.empty(), RETCODE_NULL_PARAM);
+
+    size_t workerNum = plugin_->GetPluginAlgorithm()->GetWorkerNum();
+    // The plugin config may only lower the number, more workers than the plugin allows would run it concurrently.
+    if (pluginInfo_.workerNum != 0 && workerNum > pluginInfo_.workerNum) {
+        workerNum = pluginInfo_.workerNum;
+    }
+    size_t coreNum = std::thread::hardware_concurrency();
+    if (coreNum != 0 && workerNum > coreNum) {
+        workerNum = coreNum;
+    }
+    ThreadPool *threadPool = ThreadPool::GetInstance();
+    while (threadPool != nullptr && threads_.size() < workerNum) {
+        std::shared_ptr<Thread> thread = threadPool->Pop();
+        if (thread == nullptr) {
+            HILOGW("[Engine]Only %zu of %zu workers are available.", threads_.size(), workerNum);
+            break;
+        }
+        threads_.push_back(thread);
+    }
+
+    // Sync callers may run the plugin themselves, the workers then share its slots with them.
+    callerRuns_ = CALLER_RUNS && IsSyncMode(plugin_);
+    slot_.Reset(threads_.size());
+    for (auto &thread : threads_) {
+        EngineWorker *worker = nullptr;
+        AIE_NEW(worker, EngineWorker(*queue_, scheduler_, fairQueue_, callerRuns_ ? &slot_ : nullptr));
+        CHK_RET(worker == nullptr, RETCODE_OUT_OF_MEMORY);
+        workers_.emplace_back(worker);
+        if (!thread->StartThread(worker)) {
+            HILOGE("[Engine]Engine(aid is [%s], version is [%lld]) start thread failed.",
+                plugin_->GetAid().c_str(), plugin_->GetVersion());
+            return RETCODE_START_THREAD_FAILED;
+        }
     }
     return RETCODE_SUCCESS;
 }
 
 void Engine::Uninitialize()
 {
-    if (thread_) {
-        thread_->StopThread();
+    if (!threads_.empty()) {
+        // Release the workers blocked on the empty queue, the wakeup flag is cleared when the queue is reset.
+        if (queue_ != nullptr) {
+            queue_->Wakeup();
+        }
         ThreadPool *threadPool = ThreadPool::GetInstance();
-        CHK_RET_NONE(threadPool == nullptr);
-        threadPool->Push(thread_);
-        thread_ = nullptr;
+        for (auto &thread : threads_) {
+            thread->StopThread();
+            if (threadPool != nullptr) {
+                threadPool->Push(thread);
+            }
+        }
+        threads_.clear();
+        workers_.clear();
+    }
+
+    if (executor_ != nullptr && msgHandler_ != nullptr) {
+        executor_->Clear(msgHandler_);
     }
 
     if (queue_ != nullptr) {
@@ -136,6 +233,18 @@ int Engine::SyncExecute(IRequest *request, IResponse *&response)
         HILOGE("[Engine]The request is null.");
         return RETCODE_NULL_PARAM;
     }
+    int takeRet = TakeLentMsg(plugin_, request);
+    if (takeRet != RETCODE_SUCCESS) {
+        return takeRet;
+    }
+
+    // Nothing is queued and the plugin is free, so run it here instead of switching to the worker and back.
+    if (callerRuns_ && queue_->IsEmpty() && scheduler_.IsEmpty() && fairQueue_.IsEmpty() && slot_.TryAcquire()) {
+        int retCode = handler->ExecuteOnCaller(request, response);
+        slot_.Release();
+        CHK_RET(response == nullptr, retCode);
+        return response->GetRetCode();
+    }
 
     SimpleEventNotifier<IResponse> notifier(IResponse::Destroy);
     int sendRequestRet = handler->SendRequest(request, notifier);
@@ -153,6 +262,63 @@ int Engine::SyncExecute(IRequest *request, IResponse *&response)
     return response->GetRetCode();
 }
 
+int Engine::SyncExecuteBatch(IRequest *const *requests, size_t num, IResponse **responses)
+{
+    if (plugin_ == nullptr) {
+        HILOGE("[Engine]The plugin_ is null.");
+        return RETCODE_PLUGIN_LOAD_FAILED;
+    }
+
+    SyncMsgHandler *handler = reinterpret_cast<SyncMsgHandler *>(msgHandler_);
+    if (handler == nullptr) {
+        HILOGE("[Engine]MsgHandler is null, synchronous execution is not supported.");
+        return RETCODE_NULL_PARAM;
+    }
+
+    if (requests == nullptr || responses == nullptr) {
+        HILOGE("[Engine]The requests or responses are null.");
+        return RETCODE_NULL_PARAM;
+    }
+
+    // Every request waits on a notifier of its own, the deque keeps them in place while more are added.
+    std::deque<SimpleEventNotifier<IResponse>> notifiers;
+    std::vector<bool> isSent(num, false);
+    int retCode = RETCODE_SUCCESS;
+    for (size_t i = 0; i < num; ++i) {
+        responses[i] = nullptr;
+        notifiers.emplace_back(IResponse::Destroy);
+        if (requests[i] == nullptr) {
+            retCode = RETCODE_NULL_PARAM;
+            continue;
+        }
+        int sendRequestRet = TakeLentMsg(plugin_, requests[i]);
+        if (sendRequestRet == RETCODE_SUCCESS) {
+            sendRequestRet = handler->SendRequest(requests[i], notifiers.back());
+        }
+        if (sendRequestRet != RETCODE_SUCCESS) {
+            HILOGE("[Engine][transactionId:%lld]Send sync request %zu of %zu failed, retCode is [%d].",
+                requests[i]->GetTransactionId(), i, num, sendRequestRet);
+            retCode = sendRequestRet;
+            continue;
+        }
+        isSent[i] = true;
+    }
+
+    for (size_t i = 0; i < num; ++i) {
+        if (!isSent[i]) {
+            continue;
+        }
+        int recvResponseRet = handler->ReceiveResponse(SYNC_MSG_TIMEOUT, notifiers[i], responses[i]);
+        if (recvResponseRet != RETCODE_SUCCESS) {
+            HILOGE("[Engine]Receive response %zu of %zu failed, retCode is [%d].", i, num, recvResponseRet);
+            retCode = recvResponseRet;
+        } else if (responses[i]->GetRetCode() != RETCODE_SUCCESS) {
+            retCode = responses[i]->GetRetCode();
+        }
+    }
+    return retCode;
+}
+
 int Engine::AsyncExecute(IRequest *request)
 {
     if (plugin_ == nullptr) {
@@ -166,6 +332,14 @@ int Engine::AsyncExecute(IRequest *request)
         return RETCODE_NULL_PARAM;
     }
 
+    if (request == nullptr) {
+        HILOGE("[Engine]The request is null.");
+        return RETCODE_NULL_PARAM;
+    }
+    int takeRet = TakeLentMsg(plugin_, request);
+    if (takeRet != RETCODE_SUCCESS) {
+        return takeRet;
+    }
     return handler->SendRequest(request);
 }
 } // namespace AI
@@ -15,9 +15,10 @@
 
 #include "server_executor/include/engine_manager.h"
 
+#include <cstdlib>
 #include <cstring>
 
-#include "platform/lock/include/rw_lock.h"
+#include "platform/lock/include/biased_rw_lock.h"
 #include "plugin/i_plugin.h"
 #include "plugin_manager/include/aie_plugin_info.h"
 #include "plugin_manager/include/i_plugin_manager.h"
@@ -29,8 +30,26 @@ namespace OHOS {
 namespace AI {
 namespace {
     const int PLUGIN_NUM_FOR_UNLOAD = 1;
+    // Transaction ID passed to the plugin when preloading, IDs of clients are never negative.
+    const long long PRELOAD_TRANSACTION_ID = -1;
+}
+
+static size_t GetQueueCapacity(const std::shared_ptr<Plugin> &plugin)
+{
+    IPlugin *pluginAlgorithm = plugin->GetPluginAlgorithm();
+    size_t capacity = pluginAlgorithm->GetQueueCapacity();
+    if (capacity == 0) {
+        const char *inferMode = pluginAlgorithm->GetInferMode();
+        bool isSync = (inferMode != nullptr) && (strcmp(PLUGIN_SYNC_INFER, inferMode) == 0);
+        return isSync ? MAX_SYNC_MSG_NUM : MAX_ASYNC_MSG_NUM;
+    }
+    return (capacity > MAX_QUEUE_LENGTH) ? MAX_QUEUE_LENGTH : capacity;
+}
+
+EngineManager::EngineManager(long long idleTtlMs, size_t idleMaxNum)
+    : idleTtlMs_(idleTtlMs), idleMaxNum_(idleMaxNum), idleHitNum_(0), idleMissNum_(0)
+{
 }
-EngineManager::EngineManager() = default;
 
 EngineManager::~EngineManager()
 {
@@ -39,14 +58,23 @@ EngineManager::~EngineManager()
 
 int EngineManager::Initialize()
 {
+    QueuePool<Task> *queuePool = QueuePool<Task>::GetInstance(MAX_SYNC_MSG_NUM);
+    CHK_RET(queuePool == nullptr, RETCODE_OUT_OF_MEMORY);
+    queuePool->SetMemoryBudget(AIE_QUEUE_POOL_MEMORY_BUDGET);
     return RETCODE_SUCCESS;
 }
 
 void EngineManager::Uninitialize()
 {
     HILOGI("[EngineManager]Begin to release engine manager.");
+    preloadEngines_.clear();
+    idleEngines_.clear();
+    idleLru_.clear();
     engines_.clear();
-    clientEngines_.clear();
+    {
+        WriteGuard<BiasedRwLock> guard(clientLock_);
+        clientEngines_.clear();
+    }
 
     IPluginManager *pluginManager = IPluginManager::GetPluginManager();
     if (pluginManager != nullptr) {
@@ -63,26 +91,25 @@ int EngineManager::StartEngine(long long transactionId, const AlgorithmInfo &alg
         return RETCODE_ALGORITHM_ID_INVALID;
     }
     EngineKey engineKey(aid, algoInfo.algorithmVersion);
-    std::shared_ptr<Engine> engine = FindEngine(engineKey);
-    if (engine == nullptr) {
-        int retCode = CreateEngineWithCheck(engineKey, engine);
-        if (retCode != RETCODE_SUCCESS) {
-            HILOGE("[EngineManager][transactionId:%lld]Create engine failed, retCode=[%d].",
-                transactionId, retCode);
-            return retCode;
-        }
+    std::shared_ptr<Engine> engine = nullptr;
+    int retCode = AcquireEngine(engineKey, engine);
+    if (retCode != RETCODE_SUCCESS) {
+        HILOGE("[EngineManager][transactionId:%lld]Create engine failed, retCode=[%d].",
+            transactionId, retCode);
+        return retCode;
     }
     std::shared_ptr<Plugin> plugin = engine->GetPlugin();
     if (plugin == nullptr) {
         HILOGE("[EngineManager]Plugin is nullptr.");
+        ReleaseEngine(engine);
         return RETCODE_FAILURE;
     }
-    int retCode = plugin->GetPluginAlgorithm()->Prepare(transactionId, inputInfo, outputInfo);
+    retCode = plugin->GetPluginAlgorithm()->Prepare(transactionId, inputInfo, outputInfo);
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[EngineManager]Start engine failed, failed to prepare.");
+        ReleaseEngine(engine);
         return retCode;
     }
-    engine->AddEngineReference();
     RecordClient(transactionId, engine);
     return RETCODE_SUCCESS;
 }
@@ -101,29 +128,16 @@ int EngineManager::StopEngine(long long transactionId, const DataInfo &inputInfo
         return RETCODE_SA_SERVICE_EXCEPTION;
     }
 
-    // only one engine remains, fully unload this plugin
-    bool isFullUnload = engine->GetEngineReference() == PLUGIN_NUM_FOR_UNLOAD;
+    // only one engine remains, fully unload this plugin, unless the engine stays loaded for the next client.
+    // An idle engine evicted later is unloaded by destroying the plugin, which releases the model then.
+    bool isFullUnload = (engine->GetEngineReference() == PLUGIN_NUM_FOR_UNLOAD) && (idleTtlMs_ == 0);
     int retCode = plugin->GetPluginAlgorithm()->Release(isFullUnload, transactionId, inputInfo);
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[EngineManager]Failed to release plugin.");
         return retCode;
     }
 
-    engine->DelEngineReference();
-    if (engine->GetEngineReference() == 0) {
-        HILOGI("[EngineManager]The current engine is not in use.");
-        IPluginManager *pluginManager = IPluginManager::GetPluginManager();
-        if (pluginManager == nullptr) {
-            HILOGE("[EngineManager]The pluginManager is null.");
-            return RETCODE_NULL_PARAM;
-        }
-
-        const std::string aid = plugin->GetAid();
-        long long version = plugin->GetVersion();
-        pluginManager->UnloadPlugin(aid, version);
-        EngineKey engineKey(aid, version);
-        DelEngine(engineKey);
-    }
+    ReleaseEngine(engine);
     UnRecordClient(transactionId);
     return RETCODE_SUCCESS;
 }
@@ -161,7 +175,7 @@ int EngineManager::GetOption(long long transactionId, int optionType, const Data
 
 std::shared_ptr<Engine> EngineManager::FindEngine(long long transactionId)
 {
-    ReadGuard<RwLock> guard(rwLock_);
+    ReadGuard<BiasedRwLock> guard(clientLock_);
     auto iter = clientEngines_.find(transactionId);
     if (iter == clientEngines_.end()) {
         HILOGE("[EngineManager]No corresponding engine was found.");
@@ -172,14 +186,19 @@ std::shared_ptr<Engine> EngineManager::FindEngine(long long transactionId)
 
 void EngineManager::RecordClient(long long transactionId, const std::shared_ptr<Engine> &engine)
 {
-    WriteGuard<RwLock> guard(rwLock_);
+    WriteGuard<BiasedRwLock> guard(clientLock_);
     clientEngines_[transactionId] = engine;
 }
 
 void EngineManager::UnRecordClient(long long transactionId)
 {
-    WriteGuard<RwLock> guard(rwLock_);
-    clientEngines_.erase(transactionId);
+    // Declared before the guard, so that an engine dropped with its last client is freed outside the lock.
+    std::shared_ptr<Engine> engine = nullptr;
+    WriteGuard<BiasedRwLock> guard(clientLock_);
+    auto iter = clientEngines_.find(transactionId);
+    CHK_RET_NONE(iter == clientEngines_.end());
+    engine = iter->second;
+    clientEngines_.erase(iter);
 }
 
 int EngineManager::CreateEngine(const EngineKey &engineKey, std::shared_ptr<Engine> &engine)
@@ -198,20 +217,24 @@ int EngineManager::CreateEngine(const EngineKey &engineKey, std::shared_ptr<Engi
         return retCode;
     }
 
-    ThreadPool *threadPool = ThreadPool::GetInstance();
-    CHK_RET(threadPool == nullptr, RETCODE_OUT_OF_MEMORY);
-    std::shared_ptr<Thread> thread = threadPool->Pop();
-    if (thread == nullptr) {
-        HILOGE("[EngineManager]Failed to get thread.");
-        return RETCODE_OUT_OF_MEMORY;
-    }
-
     QueuePool<Task> *queuePool = QueuePool<Task>::GetInstance(MAX_SYNC_MSG_NUM);
     CHK_RET(queuePool == nullptr, RETCODE_OUT_OF_MEMORY);
-    std::shared_ptr<Queue<Task>> queue = queuePool->Pop();
+    std::shared_ptr<Queue<Task>> queue = queuePool->Pop(GetQueueCapacity(plugin));
     if (queue == nullptr) {
-        HILOGE("[EngineManager]Failed to get queue.");
-        threadPool->Push(thread);
+        HILOGE("[EngineManager]Failed to get queue, queue pool memory usage is [%zu].", queuePool->MemoryUsage());
+        return RETCODE_OUT_OF_MEMORY;
+    }
+
+    SharedExecutor *executor = SharedExecutor::GetInstance();
+    if (executor != nullptr && executor->IsRunning()) {
+        return CreateSharedEngine(plugin, executor, queue, engine);
+    }
+
+    ThreadPool *threadPool = ThreadPool::GetInstance();
+    std::shared_ptr<Thread> thread = (threadPool == nullptr) ? nullptr : threadPool->Pop();
+    if (thread == nullptr) {
+        HILOGE("[EngineManager]Failed to get thread.");
+        queuePool->Push(queue);
         return RETCODE_OUT_OF_MEMORY;
     }
 
@@ -224,53 +247,225 @@ int EngineManager::CreateEngine(const EngineKey &engineKey, std::shared_ptr<Engi
         return RETCODE_ENGINE_NOT_EXIST;
     }
 
+    // The engine returns its threads and queue to the pools when it is destroyed.
     engine.reset(newEngine);
     retCode = engine->Initialize();
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[EngineManager]Initialize engine failed.");
-        queuePool->Push(queue);
-        threadPool->Push(thread);
-        return retCode;
+        engine = nullptr;
     }
-    return RETCODE_SUCCESS;
+    return retCode;
 }
 
-int EngineManager::CreateEngineWithCheck(const EngineKey &engineKey, std::shared_ptr<Engine> &engine)
+int EngineManager::CreateSharedEngine(std::shared_ptr<Plugin> &plugin, SharedExecutor *executor,
+    std::shared_ptr<Queue<Task>> &queue, std::shared_ptr<Engine> &engine)
 {
-    HILOGI("[EngineManager]Begin to create corresponding engine.");
-    WriteGuard<RwLock> guard(rwLock_);
-    Engines::iterator iter = engines_.find(engineKey);
-    if (iter != engines_.end()) {
-        HILOGI("[EngineManager]Success to find engine.");
-        engine = iter->second;
-        return RETCODE_SUCCESS;
+    Engine *newEngine = nullptr;
+    AIE_NEW(newEngine, Engine(plugin, executor, queue));
+    if (newEngine == nullptr) {
+        HILOGE("[EngineManager]Failed to create engine.");
+        QueuePool<Task> *queuePool = QueuePool<Task>::GetInstance();
+        if (queuePool != nullptr) {
+            queuePool->Push(queue);
+        }
+        return RETCODE_ENGINE_NOT_EXIST;
     }
 
-    int retCode = CreateEngine(engineKey, engine);
+    // The engine returns its queue to the pool when it is destroyed.
+    engine.reset(newEngine);
+    int retCode = engine->Initialize();
+    if (retCode != RETCODE_SUCCESS) {
+        HILOGE("[EngineManager]Initialize engine failed.");
+        engine = nullptr;
+    }
+    return retCode;
+}
+
+int EngineManager::AcquireEngine(const EngineKey &engineKey, std::shared_ptr<Engine> &engine)
+{
+    {
+        WriteGuard<BiasedRwLock> guard(rwLock_);
+        TrimIdleEngines(idleMaxNum_);
+        CHK_RET(ReuseEngine(engineKey, engine), RETCODE_SUCCESS);
+    }
+
+    // Created without holding the lock, so that loading one plugin does not block clients of the other engines.
+    HILOGI("[EngineManager]Begin to create corresponding engine.");
+    std::shared_ptr<Engine> newEngine = nullptr;
+    int retCode = CreateEngine(engineKey, newEngine);
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[EngineManager]Failed to create engine.");
         return retCode;
     }
 
+    WriteGuard<BiasedRwLock> guard(rwLock_);
+    // Another client created the same engine meanwhile, the new one is dropped after the lock is released.
+    CHK_RET(ReuseEngine(engineKey, engine), RETCODE_SUCCESS);
+    ++idleMissNum_;
+    engine = newEngine;
     engines_[engineKey] = engine;
+    engine->AddEngineReference();
     return RETCODE_SUCCESS;
 }
 
-std::shared_ptr<Engine> EngineManager::FindEngine(const EngineKey &engineKey)
+bool EngineManager::ReuseEngine(const EngineKey &engineKey, std::shared_ptr<Engine> &engine)
 {
-    ReadGuard<RwLock> guard(rwLock_);
+    // Called with rwLock_ held for writing.
     Engines::iterator iter = engines_.find(engineKey);
-    if (iter == engines_.end()) {
-        HILOGI("[EngineManager]No corresponding engine was found.");
-        return nullptr;
+    CHK_RET(iter == engines_.end(), false);
+    if (IsOutdated(iter->second)) {
+        RetireEngine(engineKey);
+        return false;
+    }
+    engine = iter->second;
+    auto idleIter = idleEngines_.find(engineKey);
+    if (idleIter != idleEngines_.end()) {
+        HILOGI("[EngineManager]Reuse idle engine, aid=%s, version=%lld.", engineKey.aid.c_str(), engineKey.version);
+        idleLru_.erase(idleIter->second.lruIter);
+        idleEngines_.erase(idleIter);
+        ++idleHitNum_;
+    }
+    // Referenced before the lock is released, so that the engine cannot be unloaded while it is prepared.
+    engine->AddEngineReference();
+    return true;
+}
+
+bool EngineManager::IsOutdated(const std::shared_ptr<Engine> &engine)
+{
+    std::shared_ptr<Plugin> plugin = engine->GetPlugin();
+    return (plugin != nullptr) && plugin->IsOutdated();
+}
+
+void EngineManager::RetireEngine(const EngineKey &engineKey)
+{
+    // Called with rwLock_ held for writing. New transactions get a new engine, the current ones finish on this one.
+    HILOGI("[EngineManager]Retire engine, aid=%s, version=%lld, a new library is configured.",
+        engineKey.aid.c_str(), engineKey.version);
+    Engines::iterator iter = engines_.find(engineKey);
+    CHK_RET_NONE(iter == engines_.end());
+    std::shared_ptr<Engine> engine = iter->second;
+    auto idleIter = idleEngines_.find(engineKey);
+    if (idleIter != idleEngines_.end()) {
+        idleLru_.erase(idleIter->second.lruIter);
+        idleEngines_.erase(idleIter);
+    }
+    for (auto preloadIter = preloadEngines_.begin(); preloadIter != preloadEngines_.end(); ++preloadIter) {
+        if (*preloadIter == engine) {
+            engine->DelEngineReference();
+            preloadEngines_.erase(preloadIter);
+            break;
+        }
+    }
+    engines_.erase(iter);
+}
+
+void EngineManager::ReleaseEngine(const std::shared_ptr<Engine> &engine)
+{
+    WriteGuard<BiasedRwLock> guard(rwLock_);
+    engine->DelEngineReference();
+    CHK_RET_NONE(engine->GetEngineReference() != 0);
+    HILOGI("[EngineManager]The current engine is not in use.");
+    std::shared_ptr<Plugin> plugin = engine->GetPlugin();
+    CHK_RET_NONE(plugin == nullptr);
+    EngineKey engineKey(plugin->GetAid(), plugin->GetVersion());
+    Engines::iterator iter = engines_.find(engineKey);
+    if (iter == engines_.end() || iter->second != engine) {
+        // Replaced by a newer version, the engine is freed along with its last transaction.
+        HILOGI("[EngineManager]Retired engine drained, aid=%s, version=%lld.", engineKey.aid.c_str(),
+            engineKey.version);
+        return;
+    }
+    if (idleTtlMs_ == 0) {
+        UnloadEngine(engineKey);
+        return;
+    }
+
+    // Keep the engine loaded, a client coming back soon skips loading the plugin and its model.
+    idleLru_.push_front(engineKey);
+    IdleEngine idleEngine;
+    idleEngine.lruIter = idleLru_.begin();
+    idleEngine.idleTime = std::chrono::steady_clock::now();
+    idleEngines_[engineKey] = idleEngine;
+    TrimIdleEngines(idleMaxNum_);
+}
+
+void EngineManager::TrimIdleEngines(size_t maxIdleNum)
+{
+    // Called with rwLock_ held for writing. Engines expire or overflow from the least recently used end.
+    auto now = std::chrono::steady_clock::now();
+    while (!idleLru_.empty()) {
+        const EngineKey &engineKey = idleLru_.back();
+        auto iter = idleEngines_.find(engineKey);
+        bool isExpired = (iter == idleEngines_.end()) ||
+            (now - iter->second.idleTime >= std::chrono::milliseconds(idleTtlMs_));
+        if (!isExpired && idleLru_.size() <= maxIdleNum) {
+            break;
+        }
+        EngineKey expiredKey = engineKey;
+        if (iter != idleEngines_.end()) {
+            idleEngines_.erase(iter);
+        }
+        idleLru_.pop_back();
+        UnloadEngine(expiredKey);
     }
-    return iter->second;
 }
 
-void EngineManager::DelEngine(const EngineKey &engineKey)
+void EngineManager::UnloadEngine(const EngineKey &engineKey)
 {
-    WriteGuard<RwLock> guard(rwLock_);
+    // Called with rwLock_ held for writing.
+    HILOGI("[EngineManager]Unload idle engine, aid=%s, version=%lld, idle hit=%zu, miss=%zu.",
+        engineKey.aid.c_str(), engineKey.version, idleHitNum_.load(), idleMissNum_.load());
+    IPluginManager *pluginManager = IPluginManager::GetPluginManager();
+    if (pluginManager == nullptr) {
+        HILOGE("[EngineManager]The pluginManager is null.");
+    } else {
+        pluginManager->UnloadPlugin(engineKey.aid, engineKey.version);
+    }
     engines_.erase(engineKey);
 }
+
+void EngineManager::GetIdleEngineStats(size_t &hitNum, size_t &missNum, size_t &idleNum)
+{
+    ReadGuard<BiasedRwLock> guard(rwLock_);
+    hitNum = idleHitNum_;
+    missNum = idleMissNum_;
+    idleNum = idleEngines_.size();
+}
+
+int EngineManager::PreloadEngine(const EngineKey &engineKey, bool isPrepare)
+{
+    HILOGI("[EngineManager]Begin to preload engine, aid=%s, version=%lld.", engineKey.aid.c_str(), engineKey.version);
+    std::shared_ptr<Engine> engine = nullptr;
+    int retCode = AcquireEngine(engineKey, engine);
+    CHK_RET(retCode != RETCODE_SUCCESS, retCode);
+    {
+        // The reference held here keeps the engine and its model loaded while clients come and go.
+        WriteGuard<BiasedRwLock> guard(rwLock_);
+        preloadEngines_.push_back(engine);
+    }
+    CHK_RET(!isPrepare, RETCODE_SUCCESS);
+
+    std::shared_ptr<Plugin> plugin = engine->GetPlugin();
+    CHK_RET(plugin == nullptr, RETCODE_FAILURE);
+    if (!plugin->GetPluginAlgorithm()->IsPreloadPrepareSupported()) {
+        HILOGI("[EngineManager]Plugin does not support preload prepare, the model is initialized on first use.");
+        return RETCODE_SUCCESS;
+    }
+    DataInfo inputInfo = {nullptr, 0};
+    DataInfo outputInfo = {nullptr, 0};
+    retCode = plugin->GetPluginAlgorithm()->Prepare(PRELOAD_TRANSACTION_ID, inputInfo, outputInfo);
+    if (retCode == RETCODE_SUCCESS) {
+        // The plugin returns its handle in the prepare output and takes it back on release.
+        retCode = plugin->GetPluginAlgorithm()->Release(false, PRELOAD_TRANSACTION_ID, outputInfo);
+    }
+    if (outputInfo.data != nullptr) {
+        free(outputInfo.data);
+        outputInfo.data = nullptr;
+    }
+    if (retCode != RETCODE_SUCCESS) {
+        HILOGW("[EngineManager]Failed to prepare preloaded engine, the model is initialized on first use.");
+    }
+    return RETCODE_SUCCESS;
+}
 } // namespace AI
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "server_executor/include/engine_preloader.h"
+
+#include <cstdlib>
+
+#include "utils/log/aie_log.h"
+
+namespace OHOS {
+namespace AI {
+namespace {
+const char * const ENGINE_PRELOADER_NAME = "EnginePreloader";
+const char LABEL_SEPARATOR = ',';
+const char VERSION_SEPARATOR = '+';
+const char * const BLANK_CHARS = " \t";
+
+std::string Trim(const std::string &str)
+{
+    size_t begin = str.find_first_not_of(BLANK_CHARS);
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = str.find_last_not_of(BLANK_CHARS);
+    return str.substr(begin, end - begin + 1);
+}
+
+bool ParseLabel(const std::string &label, std::string &aid, long long &version)
+{
+    size_t pos = label.rfind(VERSION_SEPARATOR);
+    if (pos == std::string::npos || pos == 0 || pos + 1 == label.size()) {
+        return false;
+    }
+    char *end = nullptr;
+    std::string versionStr = label.substr(pos + 1);
+    version = strtoll(versionStr.c_str(), &end, 10);
+    if (end == nullptr || *end != '\0') {
+        return false;
+    }
+    aid = label.substr(0, pos);
+    return true;
+}
+}
+
+EnginePreloader::EnginePreloader(EngineManager &engineManager, const std::string &preloadList, bool isPrepare)
+    : engineManager_(engineManager), index_(0), isPrepare_(isPrepare)
+{
+    size_t begin = 0;
+    while (begin <= preloadList.size()) {
+        size_t end = preloadList.find(LABEL_SEPARATOR, begin);
+        if (end == std::string::npos) {
+            end = preloadList.size();
+        }
+        std::string label = Trim(preloadList.substr(begin, end - begin));
+        begin = end + 1;
+        if (label.empty()) {
+            continue;
+        }
+        std::string aid;
+        long long version = 0;
+        if (!ParseLabel(label, aid, version)) {
+            HILOGW("[EnginePreloader]Invalid preload label %s, skip it.", label.c_str());
+            continue;
+        }
+        engineKeys_.emplace_back(aid, version);
+    }
+}
+
+const char *EnginePreloader::GetName() const
+{
+    return ENGINE_PRELOADER_NAME;
+}
+
+bool EnginePreloader::OneAction()
+{
+    CHK_RET(index_ >= engineKeys_.size(), false);
+
+    const EngineKey &engineKey = engineKeys_[index_++];
+    int retCode = engineManager_.PreloadEngine(engineKey, isPrepare_);
+    if (retCode != RETCODE_SUCCESS) {
+        HILOGW("[EnginePreloader]Failed to preload %s, version=%lld, retCode=[%d], it is loaded on first use.",
+            engineKey.aid.c_str(), engineKey.version, retCode);
+    }
+    return index_ < engineKeys_.size();
+}
+
+bool EnginePreloader::IsEmpty() const
+{
+    return engineKeys_.empty();
+}
+} // namespace AI
+} // namespace OHOS
@@ -15,7 +15,11 @@
 
 #include "server_executor/include/engine_worker.h"
 
+#include <chrono>
+#include <limits>
+
 #include "platform/time/include/time.h"
+#include "protocol/struct_definition/aie_info_define.h"
 #include "server_executor/include/i_handler.h"
 #include "utils/log/aie_log.h"
 
@@ -23,21 +27,32 @@ namespace OHOS {
 namespace AI {
 namespace {
 const char * const ENGINE_WORKER_NAME = "EngineWorker";
+// Upper bound of one blocking wait, the worker is woken up as soon as a task is pushed or the engine stops.
+const int TASK_WAIT_TIME_MS = 1000;
 }
 
-EngineWorker::EngineWorker(Queue<Task> &queue) : queue_(queue)
+EngineWorker::EngineWorker(Queue<Task> &queue, TaskScheduler &scheduler, FairQueue &fairQueue, ExecutionSlot *slot,
+    size_t batchSize)
+    : queue_(queue), scheduler_(scheduler), fairQueue_(fairQueue), slot_(slot),
+      tasks_((batchSize == 0) ? 1 : batchSize), lastBatchNum_(0)
 {
 }
 
-static void ClearQueue(Queue<Task> &queue)
+static void ClearQueue(Queue<Task> &queue, TaskScheduler &scheduler, FairQueue &fairQueue, std::vector<Task> &tasks)
 {
-    size_t size = queue.Count();
-    for (size_t i = 0; i < size; ++i) {
-        Task task;
-        int retCode = queue.PopFront(task);
-        if (retCode != RETCODE_SUCCESS) {
-            break;
+    size_t popNum = 0;
+    while (queue.PopBulk(tasks.data(), tasks.size(), popNum) == RETCODE_SUCCESS) {
+        for (size_t i = 0; i < popNum; ++i) {
+            IRequest::Destroy(tasks[i].request);
         }
+    }
+    while ((popNum = fairQueue.PopBulk(tasks.data(), tasks.size())) > 0) {
+        for (size_t i = 0; i < popNum; ++i) {
+            IRequest::Destroy(tasks[i].request);
+        }
+    }
+    Task task;
+    while (scheduler.Pop(task)) {
         IRequest::Destroy(task.request);
     }
 }
@@ -49,33 +64,158 @@ const char *EngineWorker::GetName() const
 
 bool EngineWorker::OneAction()
 {
-    if (queue_.IsEmpty()) {
-        StepSleepMs(1);
-        CHK_RET(queue_.IsEmpty(), true);
+    // Drain a burst of tasks with one reservation on the queue, instead of one wakeup per task.
+    // Do not block while tasks are waiting in the scheduler or the fair queue.
+    size_t popNum = 0;
+    bool hasPending = !scheduler_.IsEmpty() || !fairQueue_.IsEmpty();
+    int retCode = hasPending ? queue_.PopBulk(tasks_.data(), tasks_.size(), popNum) :
+        queue_.PopBulk(tasks_.data(), tasks_.size(), popNum, TASK_WAIT_TIME_MS);
+    if (retCode != RETCODE_SUCCESS && retCode != RETCODE_QUEUE_EMPTY) {
+        HILOGE("[EngineWorker]Fetch task from queue failed. error code is [%d].", retCode);
+        return true;
     }
 
-    Task task;
-    int retCode = queue_.PopFront(task);
-    if (retCode != RETCODE_SUCCESS) {
-        HILOGE("[EngineWorker]Fetch task from queue failed. error code is [%d].", retCode);
+    // A burst of one client without priority or deadline needs no reordering.
+    if (popNum > 0 && !hasPending && IsSingleFlow(popNum)) {
+        ProcessTasks(CoalesceBatch(popNum));
         return true;
     }
 
-    if (task.handler == nullptr) {
-        HILOGE("[EngineWorker]The handler is null.");
+    for (size_t i = 0; i < popNum; ++i) {
+        if (TaskScheduler::IsScheduled(tasks_[i])) {
+            scheduler_.Push(tasks_[i]);
+        } else {
+            fairQueue_.Push(tasks_[i]);
+        }
+    }
+
+    // Tasks asking for priority or deadline run one by one, background ones only when no other client waits.
+    int minPriority = fairQueue_.IsEmpty() ? std::numeric_limits<int>::min() : ALGORITHM_PRIORITY_NORMAL;
+    if (scheduler_.Pop(tasks_[0], minPriority)) {
+        lastBatchNum_ = 1;
+        ProcessTasks(1);
         return true;
     }
 
-    retCode = task.handler->Process(task);
-    if (retCode != RETCODE_SUCCESS) {
-        HILOGE("[EngineWorker]Failed to process task.");
+    // Clients sharing the engine take turns by the weights of their UIDs.
+    popNum = fairQueue_.PopBulk(tasks_.data(), tasks_.size());
+    CHK_RET(popNum == 0, true);
+    // Requests arriving during the wait may only join the batch once every queued request is taken.
+    if (fairQueue_.IsEmpty()) {
+        popNum = CoalesceBatch(popNum);
+    } else {
+        lastBatchNum_ = popNum;
     }
+    ProcessTasks(popNum);
     return true;
 }
 
+bool EngineWorker::IsSingleFlow(size_t taskNum) const
+{
+    for (size_t i = 0; i < taskNum; ++i) {
+        if (TaskScheduler::IsScheduled(tasks_[i])) {
+            return false;
+        }
+        if (i > 0 && !IsSameTransaction(tasks_[0], tasks_[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EngineWorker::IsSameTransaction(const Task &lhs, const Task &rhs)
+{
+    if (lhs.request == nullptr || rhs.request == nullptr) {
+        return lhs.request == rhs.request;
+    }
+    return lhs.request->GetTransactionId() == rhs.request->GetTransactionId();
+}
+
+size_t EngineWorker::CoalesceBatch(size_t popNum)
+{
+    size_t maxBatchSize = (tasks_[0].handler == nullptr) ? 1 : tasks_[0].handler->GetMaxBatchSize();
+    if (tasks_.size() < maxBatchSize) {
+        tasks_.resize(maxBatchSize);
+    }
+    // A lone caller is not delayed, the wait starts paying off once requests overlap.
+    if (maxBatchSize <= 1 || lastBatchNum_ <= 1) {
+        lastBatchNum_ = popNum;
+        return popNum;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(AIE_SYNC_BATCH_WAIT_TIME_MS);
+    while (popNum < maxBatchSize) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (remaining <= 0) {
+            break;
+        }
+        size_t moreNum = 0;
+        int retCode = queue_.PopBulk(tasks_.data() + popNum, maxBatchSize - popNum, moreNum,
+            static_cast<int>(remaining));
+        if (retCode != RETCODE_SUCCESS) {
+            break;
+        }
+        // Latecomers asking for priority or deadline are left to the scheduler.
+        size_t endNum = popNum + moreNum;
+        for (size_t i = popNum; i < endNum; ++i) {
+            if (TaskScheduler::IsScheduled(tasks_[i])) {
+                scheduler_.Push(tasks_[i]);
+            } else {
+                tasks_[popNum++] = tasks_[i];
+            }
+        }
+    }
+    lastBatchNum_ = popNum;
+    return popNum;
+}
+
+void EngineWorker::ProcessTasks(size_t taskNum)
+{
+    long long now = GetSteadyTimeMillSec();
+    size_t index = 0;
+    while (index < taskNum) {
+        IHandler *handler = tasks_[index].handler;
+        if (handler == nullptr) {
+            HILOGE("[EngineWorker]The handler is null.");
+            ++index;
+            continue;
+        }
+        if (TaskScheduler::IsExpired(tasks_[index], now)) {
+            HILOGW("[EngineWorker]Deadline of the task has passed, reject it.");
+            handler->Reject(tasks_[index], RETCODE_SYNC_MSG_TIMEOUT);
+            ++index;
+            continue;
+        }
+
+        // Consecutive tasks of the same handler are processed together, up to its batch size.
+        size_t maxBatchSize = handler->GetMaxBatchSize();
+        size_t batchNum = 1;
+        while (index + batchNum < taskNum && batchNum < maxBatchSize) {
+            const Task &task = tasks_[index + batchNum];
+            if (task.handler != handler || TaskScheduler::IsExpired(task, now)) {
+                break;
+            }
+            ++batchNum;
+        }
+
+        if (slot_ != nullptr) {
+            slot_->Acquire();
+        }
+        int retCode = handler->ProcessBatch(&tasks_[index], batchNum);
+        if (slot_ != nullptr) {
+            slot_->Release();
+        }
+        if (retCode != RETCODE_SUCCESS) {
+            HILOGE("[EngineWorker]Failed to process task.");
+        }
+        index += batchNum;
+    }
+}
+
 void EngineWorker::Uninitialize()
 {
-    ClearQueue(queue_);
+    ClearQueue(queue_, scheduler_, fairQueue_, tasks_);
 }
 } // namespace AI
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "server_executor/include/execution_slot.h"
+
+namespace OHOS {
+namespace AI {
+namespace {
+const size_t MIN_SLOT_NUM = 1;
+}
+
+ExecutionSlot::ExecutionSlot() : freeNum_(MIN_SLOT_NUM), waiterNum_(0)
+{
+}
+
+void ExecutionSlot::Reset(size_t slotNum)
+{
+    freeNum_ = (slotNum < MIN_SLOT_NUM) ? MIN_SLOT_NUM : slotNum;
+}
+
+bool ExecutionSlot::TryAcquire()
+{
+    size_t freeNum = freeNum_.load();
+    while (freeNum > 0) {
+        if (freeNum_.compare_exchange_weak(freeNum, freeNum - 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ExecutionSlot::Acquire()
+{
+    CHK_RET_NONE(TryAcquire());
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++waiterNum_;
+    cond_.wait(lock, [this] { return TryAcquire(); });
+    --waiterNum_;
+}
+
+void ExecutionSlot::Release()
+{
+    ++freeNum_;
+    // Pairs with the waiter count raised before the waiter checks for a free slot, no wakeup is lost.
+    CHK_RET_NONE(waiterNum_ == 0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    cond_.notify_one();
+}
+} // namespace AI
+} // namespace OHOS
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "server_executor/include/fair_queue.h"
+
+#include "protocol/data_channel/include/i_request.h"
+#include "server_executor/include/client_qos.h"
+
+namespace OHOS {
+namespace AI {
+namespace {
+const long long INVALID_TRANSACTION_ID = -1;
+const size_t DEFAULT_WEIGHT = 1;
+}
+
+FairQueue::FairQueue() : count_(0)
+{
+}
+
+void FairQueue::Push(const Task &task)
+{
+    long long transactionId = INVALID_TRANSACTION_ID;
+    size_t weight = DEFAULT_WEIGHT;
+    if (task.request != nullptr) {
+        transactionId = task.request->GetTransactionId();
+        ClientQosConfig *config = ClientQosConfig::GetInstance();
+        if (config != nullptr) {
+            weight = config->GetWeight(task.request->GetClientUid());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = subQueues_.find(transactionId);
+    if (iter == subQueues_.end()) {
+        SubQueue subQueue;
+        subQueue.weight = weight;
+        subQueue.deficit = 0;
+        iter = subQueues_.emplace(transactionId, subQueue).first;
+        activeList_.push_back(transactionId);
+    }
+    iter->second.tasks.push_back(task);
+    ++count_;
+}
+
+size_t FairQueue::PopBulk(Task *tasks, size_t maxNum)
+{
+    CHK_RET(tasks == nullptr || count_ == 0, 0);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t popNum = 0;
+    while (popNum < maxNum && !activeList_.empty()) {
+        long long transactionId = activeList_.front();
+        auto iter = subQueues_.find(transactionId);
+        if (iter == subQueues_.end()) {
+            activeList_.pop_front();
+            continue;
+        }
+        SubQueue &subQueue = iter->second;
+        // A transaction earns its quantum once per visit, what is left of it carries over to the next call.
+        if (subQueue.deficit == 0) {
+            subQueue.deficit = subQueue.weight;
+        }
+        while (subQueue.deficit > 0 && !subQueue.tasks.empty() && popNum < maxNum) {
+            tasks[popNum++] = subQueue.tasks.front();
+            subQueue.tasks.pop_front();
+            --subQueue.deficit;
+        }
+
+        if (subQueue.tasks.empty()) {
+            // An idle transaction does not hoard credit.
+            subQueues_.erase(iter);
+            activeList_.pop_front();
+        } else if (subQueue.deficit == 0) {
+            activeList_.pop_front();
+            activeList_.push_back(transactionId);
+        }
+    }
+    count_ -= popNum;
+    return popNum;
+}
+
+size_t FairQueue::Count() const
+{
+    return count_;
+}
+
+bool FairQueue::IsEmpty() const
+{
+    return count_ == 0;
+}
+} // namespace AI
+} // namespace OHOS
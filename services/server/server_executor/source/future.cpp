@@ -33,12 +33,13 @@ Future::Future(IRequest *request, long long sequenceId, long long transactionId)
       status_(FUTURE_OK)
 {
     createTime_ = GetCurTimeSec();
-    semaphore_ = ISemaphore::MakeShared(0);
+    semaphore_ = ISemaphore::Create(0);
 }
 
 Future::~Future()
 {
     request_ = nullptr;
+    ISemaphore::Destroy(semaphore_);
 
     if (response_ != nullptr) {
         IResponse::Destroy(response_);
@@ -26,9 +26,14 @@
 namespace OHOS {
 namespace AI {
 namespace {
-const int MAX_NUM_FUTURES = 1024;
-const int INVALID_SEQUENCE_ID = -1;
-const int MIN_SEQUENCE_ID = 1;
+const long long INVALID_SEQUENCE_ID = -1;
+const long long FREE_SEQUENCE_ID = 0;
+const size_t MIN_NUM_FUTURES = 1;
+
+void DeleteListener(IFutureListener *listener)
+{
+    AIE_DELETE(listener);
+}
 }
 
 std::mutex FutureFactory::mutex_;
@@ -52,71 +57,51 @@ void FutureFactory::ReleaseInstance()
     AIE_DELETE(instance_);
 }
 
-FutureFactory::FutureFactory() : sequenceId_(0)
+FutureFactory::FutureFactory()
+    : slots_((AIE_MAX_FUTURE_NUM < MIN_NUM_FUTURES) ? MIN_NUM_FUTURES : AIE_MAX_FUTURE_NUM),
+      sequenceId_(FREE_SEQUENCE_ID)
 {
 }
 
 FutureFactory::~FutureFactory()
 {
     HILOGI("[FutureFactory]Begin to release FutureFactory.");
-    for (auto &iter : listeners_) {
-        AIE_DELETE(iter.second);
-    }
     listeners_.clear();
-    for (auto &iter : futures_) {
-        AIE_DELETE(iter.second);
-    }
-    futures_.clear();
-}
-
-long long FutureFactory::FindSequenceId()
-{
-    std::lock_guard<std::mutex> lock(innerMutex_);
-
-    if (futures_.size() > MAX_NUM_FUTURES) {
-        HILOGE("[FutureFactory]Num of valid futures reaches max.");
-        return INVALID_SEQUENCE_ID;
+    for (auto &slot : slots_) {
+        AIE_DELETE(slot.future);
+        slot.sequenceId = FREE_SEQUENCE_ID;
     }
-
-    do {
-        ++sequenceId_;
-        if (sequenceId_ < MIN_SEQUENCE_ID) {
-            HILOGI("[FutureFactory]The sequenceId_ is smaller than MIN_SEQUENCE_ID.");
-            sequenceId_ = MIN_SEQUENCE_ID;
-        }
-    } while (futures_.find(sequenceId_) != futures_.end());
-
-    return sequenceId_;
 }
 
 int FutureFactory::CreateFuture(IRequest *request)
 {
-    long long sequenceId = FindSequenceId();
-    if (sequenceId == INVALID_SEQUENCE_ID) {
-        HILOGE("[FutureFactory]Invalid sequence id generated.");
-        return RETCODE_NULL_PARAM;
-    }
-
     if (request == nullptr) {
         HILOGE("[FutureFactory]Param request is nullptr.");
         return RETCODE_NULL_PARAM;
     }
-    Request *req = reinterpret_cast<Request*>(request);
-    req->SetInnerSequenceId(sequenceId);
-
-    Future *future = nullptr;
-    AIE_NEW(future, Future(request, sequenceId, request->GetTransactionId()));
-    CHK_RET(future == nullptr, RETCODE_OUT_OF_MEMORY);
 
-    AddFuture(sequenceId, future);
-    return RETCODE_SUCCESS;
-}
+    // Sequence IDs only grow, so a slot is probed at most once per round and an ID is never reused.
+    size_t slotNum = slots_.size();
+    for (size_t i = 0; i < slotNum; ++i) {
+        long long sequenceId = ++sequenceId_;
+        FutureSlot &slot = slots_[static_cast<size_t>(sequenceId) % slotNum];
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        if (slot.future != nullptr) {
+            continue;
+        }
 
-void FutureFactory::AddFuture(long long sequenceId, Future* future)
-{
-    std::lock_guard<std::mutex> lock(innerMutex_);
+        Future *future = nullptr;
+        AIE_NEW(future, Future(request, sequenceId, request->GetTransactionId()));
+        CHK_RET(future == nullptr, RETCODE_OUT_OF_MEMORY);
+        Request *req = reinterpret_cast<Request*>(request);
+        req->SetInnerSequenceId(sequenceId);
+        slot.sequenceId = sequenceId;
+        slot.future = future;
+        return RETCODE_SUCCESS;
+    }
 
-    futures_[sequenceId] = future;
+    HILOGE("[FutureFactory]Num of valid futures reaches max.");
+    return RETCODE_NULL_PARAM;
 }
 
 void FutureFactory::Release(long long sequenceId)
@@ -126,29 +111,40 @@ void FutureFactory::Release(long long sequenceId)
 
 void FutureFactory::DeleteFuture(long long sequenceId)
 {
-    std::lock_guard<std::mutex> lock(innerMutex_);
-    auto iter = futures_.find(sequenceId);
-    if (iter != futures_.end()) {
-        delete iter->second;
-        iter->second = nullptr;
-        futures_.erase(sequenceId);
-    }
+    Future *future = TakeFuture(sequenceId);
+    AIE_DELETE(future);
+}
+
+Future *FutureFactory::TakeFuture(long long sequenceId)
+{
+    CHK_RET(sequenceId <= FREE_SEQUENCE_ID, nullptr);
+    FutureSlot &slot = slots_[static_cast<size_t>(sequenceId) % slots_.size()];
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    CHK_RET(slot.sequenceId != sequenceId, nullptr);
+
+    Future *future = slot.future;
+    slot.future = nullptr;
+    slot.sequenceId = FREE_SEQUENCE_ID;
+    return future;
 }
 
 void FutureFactory::RegisterListener(IFutureListener *listener, long long transactionId)
 {
-    std::lock_guard<std::mutex> lock(innerMutex_);
-    listeners_[transactionId] = listener;
+    std::shared_ptr<IFutureListener> newListener(listener, DeleteListener);
+    WriteGuard<BiasedRwLock> guard(listenerLock_);
+    listeners_[transactionId] = newListener;
 }
 
 void FutureFactory::UnregisterListener(long long transactionId)
 {
-    std::lock_guard<std::mutex> lock(innerMutex_);
-    auto iter = listeners_.find(transactionId);
-    if (iter != listeners_.end()) {
-        delete iter->second;
-        iter->second = nullptr;
-        listeners_.erase(transactionId);
+    // The listener is deleted outside the lock, once no response in flight is using it.
+    std::shared_ptr<IFutureListener> oldListener;
+    {
+        WriteGuard<BiasedRwLock> guard(listenerLock_);
+        auto iter = listeners_.find(transactionId);
+        CHK_RET_NONE(iter == listeners_.end());
+        oldListener = iter->second;
+        listeners_.erase(iter);
     }
 }
 
@@ -157,7 +153,8 @@ int FutureFactory::ProcessResponse(PluginEvent event, IResponse *response)
     CHK_RET(response == nullptr, RETCODE_NULL_PARAM);
     HILOGI("[FutureFactory]Begin to Process Response.");
     Response *res = reinterpret_cast<Response *>(response);
-    Future *future = FetchFuture(res);
+    // The future is taken out of the table, it cannot be released by others while being answered.
+    Future *future = TakeFuture(res->GetInnerSequenceId());
     if (!future) {
         HILOGE("[FutureFactory][transactionId:%lld]No matched future found, seqId=%lld.",
             res->GetTransactionId(), res->GetInnerSequenceId());
@@ -167,38 +164,27 @@ int FutureFactory::ProcessResponse(PluginEvent event, IResponse *response)
     FutureStatus status = Future::ConvertPluginStatus(event);
     future->SetResponse(status, response);
 
-    IFutureListener *listener = FindListener(response->GetTransactionId());
+    std::shared_ptr<IFutureListener> listener = FindListener(response->GetTransactionId());
     if (listener == nullptr) {
         HILOGE("[FutureFactory][transactionId:%lld]No matched listener found.", response->GetTransactionId());
+        AIE_DELETE(future);
         return RETCODE_NO_LISTENER_FOUND;
     }
 
     listener->OnReply(future);
     future->DetachResponse();
-    DeleteFuture(future->GetSequenceId());
+    AIE_DELETE(future);
 
     return RETCODE_SUCCESS;
 }
 
-Future *FutureFactory::FetchFuture(Response *response)
-{
-    long long sequenceId = response->GetInnerSequenceId();
-    std::lock_guard<std::mutex> lock(innerMutex_);
-
-    auto findProc = futures_.find(sequenceId);
-    CHK_RET(findProc == futures_.end(), nullptr);
-
-    return findProc->second;
-}
-
-IFutureListener *FutureFactory::FindListener(long long transactionId)
+std::shared_ptr<IFutureListener> FutureFactory::FindListener(long long transactionId) const
 {
-    std::lock_guard<std::mutex> lock(innerMutex_);
-
+    ReadGuard<BiasedRwLock> guard(listenerLock_);
     auto findProc = listeners_.find(transactionId);
     CHK_RET(findProc == listeners_.end(), nullptr);
 
     return findProc->second;
 }
 } // namespace AI
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
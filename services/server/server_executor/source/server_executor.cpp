@@ -15,12 +15,23 @@
 
 #include "server_executor/include/server_executor.h"
 
+#include "plugin_manager/include/plugin_registry.h"
 #include "protocol/data_channel/include/i_request.h"
+#include "server_executor/include/client_qos.h"
 #include "server_executor/include/future_factory.h"
 #include "server_executor/include/i_future.h"
+#include "server_executor/include/shared_executor.h"
 
 namespace OHOS {
 namespace AI {
+namespace {
+#ifdef AIE_PRELOAD_PREPARE
+const bool PRELOAD_PREPARE = true;
+#else
+const bool PRELOAD_PREPARE = false;
+#endif
+}
+
 std::mutex ServerExecutor::mutex_;
 ServerExecutor *ServerExecutor::instance_ = nullptr;
 
@@ -60,6 +71,19 @@ ServerExecutor::~ServerExecutor()
 
 int ServerExecutor::Initialize()
 {
+    // New or updated plugins are registered by sending SIGHUP, without restarting the service.
+    PluginRegistry::InstallRescanSignal();
+    ClientQosConfig *qosConfig = ClientQosConfig::GetInstance();
+    if (qosConfig != nullptr) {
+        qosConfig->LoadConfig(AIE_CLIENT_QOS);
+    }
+#ifdef AIE_SHARED_EXECUTOR
+    SharedExecutor *sharedExecutor = SharedExecutor::GetInstance();
+    if (sharedExecutor == nullptr || sharedExecutor->Initialize(AIE_SHARED_EXECUTOR_THREAD_NUM) != RETCODE_SUCCESS) {
+        HILOGE("[ServerExecutor]Failed to start shared executor, engines use dedicated threads");
+        SharedExecutor::ReleaseInstance();
+    }
+#endif
     AIE_NEW(engineMgr_, EngineManager);
     if (engineMgr_ == nullptr) {
         HILOGE("[ServerExecutor]Failed to new engine manager");
@@ -69,14 +93,66 @@ int ServerExecutor::Initialize()
     if (retCode != RETCODE_SUCCESS) {
         HILOGE("[ServerExecutor]Failed to initialize engine manager");
         AIE_DELETE(engineMgr_);
+        return retCode;
     }
-    return retCode;
+    StartPreload();
+    return RETCODE_SUCCESS;
 }
 
 void ServerExecutor::Uninitialize()
 {
+    StopPreload();
+    if (engineMgr_ != nullptr) {
+        size_t hitNum = 0;
+        size_t missNum = 0;
+        size_t idleNum = 0;
+        engineMgr_->GetIdleEngineStats(hitNum, missNum, idleNum);
+        HILOGI("[ServerExecutor]Idle engine stats, hit=%zu, miss=%zu, idle=%zu.", hitNum, missNum, idleNum);
+    }
     AIE_DELETE(engineMgr_);
+    SharedExecutor::ReleaseInstance();
     FutureFactory::ReleaseInstance();
+    PluginRegistry::ReleaseInstance();
+    ClientQosConfig::ReleaseInstance();
+}
+
+void ServerExecutor::StartPreload()
+{
+    EnginePreloader *preloader = nullptr;
+    AIE_NEW(preloader, EnginePreloader(*engineMgr_, AIE_PRELOAD_PLUGINS, PRELOAD_PREPARE));
+    CHK_RET_NONE(preloader == nullptr);
+    preloader_.reset(preloader);
+    CHK_RET_NONE(preloader_->IsEmpty());
+
+    // Plugins are loaded in the background, the service is available at once and clients never wait for them.
+    ThreadPool *threadPool = ThreadPool::GetInstance();
+    CHK_RET_NONE(threadPool == nullptr);
+    std::shared_ptr<Thread> thread = threadPool->Pop();
+    if (thread == nullptr) {
+        HILOGW("[ServerExecutor]No thread to preload plugins, they are loaded on first use");
+        return;
+    }
+    if (!thread->StartThread(preloader_.get())) {
+        HILOGW("[ServerExecutor]Failed to start preloading plugins, they are loaded on first use");
+        threadPool->Push(thread);
+        return;
+    }
+    preloadThread_ = thread;
+}
+
+void ServerExecutor::StopPreload()
+{
+    if (preloadThread_ != nullptr) {
+        // The preloader may have finished already, so only ask it to stop and join it in any case.
+        (void)preloadThread_->StopThread(0);
+        preloadThread_->WaitForEnd();
+        ThreadPool *threadPool = ThreadPool::GetInstance();
+        if (threadPool != nullptr) {
+            threadPool->Push(preloadThread_);
+        }
+        preloadThread_ = nullptr;
+    }
+    preloader_.reset();
 }
 
 int ServerExecutor::StartEngine(long long transactionId, const AlgorithmInfo &algoInfo, const DataInfo &inputInfo,
@@ -125,6 +201,20 @@ int ServerExecutor::SyncExecute(IRequest *request, IResponse *&response)
     return engine->SyncExecute(request, response);
 }
 
+int ServerExecutor::SyncExecuteBatch(IRequest *const *requests, size_t num, IResponse **responses)
+{
+    CHK_RET(engineMgr_ == nullptr, RETCODE_ENGINE_MANAGER_NOT_INIT);
+    CHK_RET(requests == nullptr || responses == nullptr || num == 0 || requests[0] == nullptr, RETCODE_NULL_PARAM);
+    HILOGI("[ServerExecutor]Begin to call SyncExecuteBatch, algoType:%d, num:%zu.",
+        requests[0]->GetAlgoPluginType(), num);
+
+    // The requests are of one session, so they all go to the engine of the first one.
+    std::shared_ptr<Engine> engine = engineMgr_->FindEngine(requests[0]->GetTransactionId());
+    CHK_RET(engine == nullptr, RETCODE_ENGINE_NOT_EXIST);
+
+    return engine->SyncExecuteBatch(requests, num, responses);
+}
+
 int ServerExecutor::AsyncExecute(IRequest *request)
 {
     if (engineMgr_ == nullptr) {
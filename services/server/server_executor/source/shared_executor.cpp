@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "server_executor/include/shared_executor.h"
+
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+#include "platform/threadpool/include/thread_pool.h"
+#include "platform/time/include/time.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "server_executor/include/task_scheduler.h"
+#include "utils/log/aie_log.h"
+
+namespace OHOS {
+namespace AI {
+namespace {
+const char * const SHARED_EXECUTOR_WORKER_NAME = "SharedExecutorWorker";
+// Upper bound of one idle wait, the worker is woken up as soon as a transaction becomes ready.
+const int TASK_WAIT_TIME_MS = 1000;
+const size_t DEFAULT_THREAD_NUM = 1;
+const size_t INVALID_WORKER_INDEX = static_cast<size_t>(-1);
+const size_t DEQUE_INIT_CAPACITY = 64;
+const size_t INBOX_CAPACITY = 1024;
+// Pointers of handlers are aligned, low bits carry no entropy.
+const unsigned int HANDLER_ALIGN_BITS = 4;
+// All tasks of a non-reentrant handler are chained in this strand.
+const long long SERIAL_STRAND_ID = -1;
+
+// Index of the shared executor worker running on the current thread.
+thread_local size_t g_workerIndex = INVALID_WORKER_INDEX;
+}
+
+SharedExecutorWorker::SharedExecutorWorker(SharedExecutor &executor, size_t index)
+    : executor_(executor), index_(index)
+{
+}
+
+const char *SharedExecutorWorker::GetName() const
+{
+    return SHARED_EXECUTOR_WORKER_NAME;
+}
+
+bool SharedExecutorWorker::Initialize()
+{
+    g_workerIndex = index_;
+    return true;
+}
+
+bool SharedExecutorWorker::OneAction()
+{
+    executor_.RunOnce(index_);
+    return true;
+}
+
+void SharedExecutorWorker::Uninitialize()
+{
+    g_workerIndex = INVALID_WORKER_INDEX;
+}
+
+std::mutex SharedExecutor::instanceMutex_;
+SharedExecutor *SharedExecutor::instance_ = nullptr;
+
+SharedExecutor *SharedExecutor::GetInstance()
+{
+    CHK_RET(instance_ != nullptr, instance_);
+
+    std::lock_guard<std::mutex> lock(instanceMutex_);
+    CHK_RET(instance_ != nullptr, instance_);
+
+    SharedExecutor *tempInstance = nullptr;
+    AIE_NEW(tempInstance, SharedExecutor);
+    CHK_RET(tempInstance == nullptr, nullptr);
+
+    instance_ = tempInstance;
+    return instance_;
+}
+
+void SharedExecutor::ReleaseInstance()
+{
+    std::lock_guard<std::mutex> lock(instanceMutex_);
+    AIE_DELETE(instance_);
+}
+
+SharedExecutor::WorkDeque::WorkDeque()
+    : strands(DEQUE_INIT_CAPACITY), inbox(INBOX_CAPACITY)
+{
+}
+
+SharedExecutor::SharedExecutor()
+    : running_(false), stopping_(false), nextIndex_(0), overflowNum_(0), queuedNum_(0), idleNum_(0)
+{
+}
+
+SharedExecutor::~SharedExecutor()
+{
+    Uninitialize();
+}
+
+int SharedExecutor::Initialize(size_t threadNum)
+{
+    CHK_RET(running_, RETCODE_SUCCESS);
+
+    if (threadNum == 0) {
+        threadNum = std::thread::hardware_concurrency();
+    }
+    if (threadNum == 0) {
+        threadNum = DEFAULT_THREAD_NUM;
+    }
+
+    ThreadPool *threadPool = ThreadPool::GetInstance();
+    CHK_RET(threadPool == nullptr, RETCODE_OUT_OF_MEMORY);
+    for (size_t i = 0; i < threadNum; ++i) {
+        WorkDeque *workDeque = nullptr;
+        AIE_NEW(workDeque, WorkDeque);
+        SharedExecutorWorker *worker = nullptr;
+        AIE_NEW(worker, SharedExecutorWorker(*this, i));
+        std::shared_ptr<Thread> thread = threadPool->Pop();
+        deques_.emplace_back(workDeque);
+        workers_.emplace_back(worker);
+        if (thread == nullptr || workDeque == nullptr || worker == nullptr) {
+            HILOGE("[SharedExecutor]Failed to allocate worker[%zu].", i);
+            if (thread != nullptr) {
+                threadPool->Push(thread);
+            }
+            Uninitialize();
+            return RETCODE_OUT_OF_MEMORY;
+        }
+        threads_.push_back(thread);
+    }
+
+    stopping_ = false;
+    for (size_t i = 0; i < threadNum; ++i) {
+        if (!threads_[i]->StartThread(workers_[i].get())) {
+            HILOGE("[SharedExecutor]Failed to start worker[%zu].", i);
+            Uninitialize();
+            return RETCODE_START_THREAD_FAILED;
+        }
+    }
+    running_ = true;
+    HILOGI("[SharedExecutor]Start %zu workers.", threadNum);
+    return RETCODE_SUCCESS;
+}
+
+void SharedExecutor::Uninitialize()
+{
+    stopping_ = true;
+    {
+        std::lock_guard<std::mutex> lock(readyMutex_);
+        readyCond_.notify_all();
+    }
+
+    ThreadPool *threadPool = ThreadPool::GetInstance();
+    for (auto &thread : threads_) {
+        thread->StopThread();
+        if (threadPool != nullptr) {
+            threadPool->Push(thread);
+        }
+    }
+    threads_.clear();
+    workers_.clear();
+    deques_.clear();
+    {
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        overflowStrands_.clear();
+        overflowNum_ = 0;
+    }
+    queuedNum_ = 0;
+
+    for (Shard &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto &item : shard.strands) {
+            for (auto &task : item.second.tasks) {
+                IRequest::Destroy(task.request);
+            }
+        }
+        shard.strands.clear();
+        shard.pendingNums.clear();
+        shard.finishCond.notify_all();
+    }
+    running_ = false;
+}
+
+bool SharedExecutor::IsRunning() const
+{
+    return running_;
+}
+
+size_t SharedExecutor::ThreadNum() const
+{
+    return deques_.size();
+}
+
+int SharedExecutor::Submit(const Task &task)
+{
+    CHK_RET(task.request == nullptr, RETCODE_NULL_PARAM);
+    if (!running_ || stopping_) {
+        HILOGE("[SharedExecutor]Executor is not running.");
+        return RETCODE_FAILURE;
+    }
+
+    CHK_RET(task.handler == nullptr, RETCODE_NULL_PARAM);
+    StrandKey strandKey(task.handler,
+        task.handler->IsReentrant() ? task.request->GetTransactionId() : SERIAL_STRAND_ID);
+    Shard &shard = GetShard(task.handler);
+    Strand *readyStrand = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto iter = shard.strands.find(strandKey);
+        if (iter == shard.strands.end()) {
+            // No task of this strand is queued or running, the new strand is scheduled below.
+            iter = shard.strands.emplace(strandKey, Strand()).first;
+            iter->second.key = strandKey;
+            readyStrand = &iter->second;
+        }
+        iter->second.tasks.push_back(task);
+        ++shard.pendingNums[task.handler];
+    }
+
+    if (readyStrand != nullptr) {
+        PushStrand(readyStrand, false);
+    }
+    return RETCODE_SUCCESS;
+}
+
+size_t SharedExecutor::Count(const IHandler *handler)
+{
+    Shard &shard = GetShard(handler);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.pendingNums.find(handler);
+    return (iter == shard.pendingNums.end()) ? 0 : iter->second;
+}
+
+void SharedExecutor::Clear(const IHandler *handler)
+{
+    Shard &shard = GetShard(handler);
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    auto iter = shard.strands.lower_bound(StrandKey(handler, std::numeric_limits<long long>::min()));
+    for (; iter != shard.strands.end() && iter->first.first == handler; ++iter) {
+        for (auto &task : iter->second.tasks) {
+            IRequest::Destroy(task.request);
+            DecreasePendingNum(shard, handler);
+        }
+        iter->second.tasks.clear();
+    }
+    // Strands left empty are released by the worker which owns them.
+    shard.finishCond.wait(lock, [&shard, handler] {
+        return shard.pendingNums.find(handler) == shard.pendingNums.end();
+    });
+}
+
+void SharedExecutor::RunOnce(size_t index)
+{
+    if (stopping_) {
+        StepSleepMs(THREAD_SLEEP_MS);
+        return;
+    }
+
+    Strand *strand = nullptr;
+    if (PopStrand(index, strand)) {
+        RunStrand(strand);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(readyMutex_);
+    ++idleNum_;
+    (void)readyCond_.wait_for(lock, std::chrono::milliseconds(TASK_WAIT_TIME_MS),
+        [this] { return stopping_ || queuedNum_ > 0; });
+    --idleNum_;
+}
+
+bool SharedExecutor::PopStrand(size_t index, Strand *&strand)
+{
+    size_t dequeNum = deques_.size();
+    bool isPopped = false;
+    for (size_t i = 0; i < dequeNum && !isPopped; ++i) {
+        WorkDeque &workDeque = *deques_[(index + i) % dequeNum];
+        // The owner takes its newest strand, thieves take the oldest one.
+        if (i == 0) {
+            isPopped = workDeque.strands.Pop(strand) == RETCODE_SUCCESS;
+        } else {
+            isPopped = workDeque.strands.Steal(strand) == RETCODE_SUCCESS;
+        }
+        isPopped = isPopped || workDeque.inbox.PopFront(strand) == RETCODE_SUCCESS;
+    }
+    if (!isPopped && overflowNum_ > 0) {
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        if (!overflowStrands_.empty()) {
+            strand = overflowStrands_.front();
+            overflowStrands_.pop_front();
+            --overflowNum_;
+            isPopped = true;
+        }
+    }
+    if (isPopped) {
+        --queuedNum_;
+    }
+    return isPopped;
+}
+
+void SharedExecutor::PushStrand(Strand *strand, bool isRequeue)
+{
+    // Counted before it is visible, so a woken worker does not go back to sleep before finding it.
+    ++queuedNum_;
+    size_t index = g_workerIndex;
+    bool isPushed = false;
+    if (index < deques_.size()) {
+        WorkDeque &workDeque = *deques_[index];
+        // Requeue at the back of its own inbox, so other transactions get their turn.
+        if (isRequeue) {
+            isPushed = workDeque.inbox.PushBack(strand) == RETCODE_SUCCESS;
+        }
+        isPushed = isPushed || workDeque.strands.Push(strand) == RETCODE_SUCCESS;
+    }
+    for (size_t i = 0; i < deques_.size() && !isPushed; ++i) {
+        isPushed = deques_[nextIndex_++ % deques_.size()]->inbox.PushBack(strand) == RETCODE_SUCCESS;
+    }
+    if (!isPushed) {
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        overflowStrands_.push_back(strand);
+        ++overflowNum_;
+    }
+
+    if (idleNum_ > 0) {
+        std::lock_guard<std::mutex> lock(readyMutex_);
+        readyCond_.notify_one();
+    }
+}
+
+void SharedExecutor::RunStrand(Strand *strand)
+{
+    const StrandKey strandKey = strand->key;
+    const IHandler *handler = strandKey.first;
+    Shard &shard = GetShard(handler);
+    Task task;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (strand->tasks.empty()) {
+            // All tasks are dropped by Clear.
+            shard.strands.erase(strandKey);
+            return;
+        }
+        task = strand->tasks.front();
+        strand->tasks.pop_front();
+    }
+
+    if (task.handler == nullptr) {
+        HILOGE("[SharedExecutor]The handler is null.");
+    } else if (TaskScheduler::IsExpired(task, GetSteadyTimeMillSec())) {
+        HILOGW("[SharedExecutor]Deadline of the task has passed, reject it.");
+        task.handler->Reject(task, RETCODE_SYNC_MSG_TIMEOUT);
+    } else if (task.handler->Process(task) != RETCODE_SUCCESS) {
+        HILOGE("[SharedExecutor]Failed to process task.");
+    }
+
+    bool isReady = false;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        DecreasePendingNum(shard, handler);
+        if (strand->tasks.empty()) {
+            shard.strands.erase(strandKey);
+        } else {
+            isReady = true;
+        }
+    }
+    if (isReady) {
+        PushStrand(strand, true);
+    }
+}
+
+SharedExecutor::Shard &SharedExecutor::GetShard(const IHandler *handler)
+{
+    return shards_[(reinterpret_cast<uintptr_t>(handler) >> HANDLER_ALIGN_BITS) % SHARD_NUM];
+}
+
+void SharedExecutor::DecreasePendingNum(Shard &shard, const IHandler *handler)
+{
+    // Called with shard.mutex held.
+    auto iter = shard.pendingNums.find(handler);
+    CHK_RET_NONE(iter == shard.pendingNums.end());
+    if (--iter->second == 0) {
+        shard.pendingNums.erase(iter);
+        shard.finishCond.notify_all();
+    }
+}
+} // namespace AI
+} // namespace OHOS
@@ -15,18 +15,22 @@
 
 #include "server_executor/include/sync_msg_handler.h"
 
+#include <vector>
+
 #include "platform/queuepool/queue_pool.h"
+#include "platform/time/include/time.h"
 #include "platform/semaphore/include/simple_event_notifier.h"
 #include "plugin/i_plugin.h"
 #include "server_executor/include/engine_manager.h"
+#include "server_executor/include/task_scheduler.h"
 #include "utils/aie_guard.h"
 #include "utils/constants/constants.h"
 #include "utils/log/aie_log.h"
 
 namespace OHOS {
 namespace AI {
-SyncMsgHandler::SyncMsgHandler(Queue<Task> &queue, IPlugin *pluginAlgorithm)
-    : queue_(queue), pluginAlgorithm_(pluginAlgorithm)
+SyncMsgHandler::SyncMsgHandler(Queue<Task> &queue, IPlugin *pluginAlgorithm, SharedExecutor *executor)
+    : queue_(queue), pluginAlgorithm_(pluginAlgorithm), executor_(executor), batchSizeLimit_(0)
 {
 }
 
@@ -39,12 +43,30 @@ int SyncMsgHandler::Process(const Task &task)
         HILOGE("[SyncMsgHandler]Invalid request param");
         return RETCODE_NULL_PARAM;
     }
+    quota_.Release(request->GetClientUid());
 
     IResponse *response = nullptr;
+    int processRetCode = Execute(request, response);
+    CHK_RET(response == nullptr, RETCODE_OUT_OF_MEMORY);
+
+    if (task.notifier != nullptr) {
+        (task.notifier)->AddToBack(response);
+    } else {
+        IResponse::Destroy(response);
+    }
+
+    return processRetCode;
+}
+
+int SyncMsgHandler::Execute(IRequest *request, IResponse *&response)
+{
+    CHK_RET(pluginAlgorithm_ == nullptr, RETCODE_PLUGIN_LOAD_FAILED);
+    CHK_RET(request == nullptr, RETCODE_NULL_PARAM);
+
     int processRetCode = pluginAlgorithm_->SyncProcess(request, response);
 
     if (response == nullptr) {
-        response = IResponse::Create(task.request);
+        response = IResponse::Create(request);
         CHK_RET(response == nullptr, RETCODE_OUT_OF_MEMORY);
     }
 
@@ -53,24 +75,123 @@ int SyncMsgHandler::Process(const Task &task)
     } else {
         response->SetRetCode(RETCODE_SUCCESS);
     }
+    return processRetCode;
+}
 
-    if (task.notifier != nullptr) {
-        (task.notifier)->AddToBack(response);
+int SyncMsgHandler::ExecuteOnCaller(IRequest *request, IResponse *&response)
+{
+    CHK_RET(request == nullptr, RETCODE_NULL_PARAM);
+    if (!quota_.Acquire(request, queue_.Capacity())) {
+        HILOGE("[SyncMsgHandler]Client queue overload");
+        return RETCODE_QUEUE_FULL;
+    }
+
+    int retCode = RETCODE_SUCCESS;
+    Task task(this, request, nullptr);
+    if (TaskScheduler::IsExpired(task, GetSteadyTimeMillSec())) {
+        HILOGW("[SyncMsgHandler]Deadline of the request has passed, reject it.");
+        retCode = RETCODE_SYNC_MSG_TIMEOUT;
+        response = IResponse::Create(request);
+        if (response != nullptr) {
+            response->SetRetCode(retCode);
+        }
     } else {
-        IResponse::Destroy(response);
+        retCode = Execute(request, response);
     }
+    quota_.Release(request->GetClientUid());
+    return retCode;
+}
 
-    return processRetCode;
+int SyncMsgHandler::ProcessBatch(const Task *tasks, size_t num)
+{
+    CHK_RET(tasks == nullptr, RETCODE_NULL_PARAM);
+    if (num <= 1 || GetMaxBatchSize() <= 1) {
+        return IHandler::ProcessBatch(tasks, num);
+    }
+
+    std::vector<const Task*> batchTasks;
+    std::vector<IRequest*> requests;
+    batchTasks.reserve(num);
+    requests.reserve(num);
+    for (size_t i = 0; i < num; ++i) {
+        if (tasks[i].request == nullptr) {
+            HILOGE("[SyncMsgHandler]Invalid request param");
+            continue;
+        }
+        quota_.Release(tasks[i].request->GetClientUid());
+        batchTasks.push_back(&tasks[i]);
+        requests.push_back(tasks[i].request);
+    }
+    CHK_RET(requests.empty(), RETCODE_NULL_PARAM);
+
+    std::vector<IResponse*> responses(requests.size(), nullptr);
+    int processRetCode = pluginAlgorithm_->SyncProcessBatch(requests.data(), requests.size(), responses.data());
+
+    // Split the results back to the waiting clients, a request fails alone if only its response carries an error.
+    int retCode = processRetCode;
+    for (size_t i = 0; i < batchTasks.size(); ++i) {
+        IResponse *response = responses[i];
+        bool isFailed = (response == nullptr) ? (processRetCode != RETCODE_SUCCESS) :
+            (response->GetRetCode() != RETCODE_SUCCESS);
+        if (response == nullptr) {
+            response = IResponse::Create(batchTasks[i]->request);
+            if (response == nullptr) {
+                HILOGE("[SyncMsgHandler]Failed to create response.");
+                retCode = RETCODE_OUT_OF_MEMORY;
+                continue;
+            }
+        }
+        response->SetRetCode(isFailed ? RETCODE_ALGORITHM_PROCESS_ERROR : RETCODE_SUCCESS);
+
+        if (batchTasks[i]->notifier != nullptr) {
+            (batchTasks[i]->notifier)->AddToBack(response);
+        } else {
+            IResponse::Destroy(response);
+        }
+    }
+    return retCode;
 }
 
-void SyncMsgHandler::SetPluginAlgorithm(IPlugin *pluginAlgorithm)
+size_t SyncMsgHandler::GetMaxBatchSize() const
 {
-    pluginAlgorithm_ = pluginAlgorithm;
+    CHK_RET(pluginAlgorithm_ == nullptr, 1);
+    size_t maxBatchSize = pluginAlgorithm_->GetMaxBatchSize();
+    if (maxBatchSize > queue_.Capacity()) {
+        maxBatchSize = queue_.Capacity();
+    }
+    if (batchSizeLimit_ != 0 && maxBatchSize > batchSizeLimit_) {
+        maxBatchSize = batchSizeLimit_;
+    }
+    return (maxBatchSize == 0) ? 1 : maxBatchSize;
 }
 
-size_t GetSynMsgQueueCapacity()
+void SyncMsgHandler::SetBatchSizeLimit(size_t batchSizeLimit)
 {
-    return MAX_SYNC_MSG_NUM;
+    batchSizeLimit_ = batchSizeLimit;
+}
+
+void SyncMsgHandler::Reject(const Task &task, int retCode)
+{
+    CHK_RET_NONE(task.request == nullptr);
+    quota_.Release(task.request->GetClientUid());
+    CHK_RET_NONE(task.notifier == nullptr);
+    IResponse *response = IResponse::Create(task.request);
+    if (response == nullptr) {
+        HILOGE("[SyncMsgHandler]Failed to create response.");
+        return;
+    }
+    response->SetRetCode(retCode);
+    (task.notifier)->AddToBack(response);
+}
+
+bool SyncMsgHandler::IsReentrant() const
+{
+    return (pluginAlgorithm_ != nullptr) && (pluginAlgorithm_->GetWorkerNum() > 1);
+}
+
+void SyncMsgHandler::SetPluginAlgorithm(IPlugin *pluginAlgorithm)
+{
+    pluginAlgorithm_ = pluginAlgorithm;
 }
 
 int SyncMsgHandler::SendRequest(IRequest *request, SimpleEventNotifier<IResponse> &notifier)
@@ -80,15 +201,22 @@ int SyncMsgHandler::SendRequest(IRequest *request, SimpleEventNotifier<IResponse
         return RETCODE_NULL_PARAM;
     }
 
-    if (queue_.Count() >= GetSynMsgQueueCapacity()) {
+    size_t pendingNum = (executor_ != nullptr) ? executor_->Count(this) : queue_.Count();
+    if (pendingNum >= queue_.Capacity()) {
         HILOGE("[SyncMsgHandler]Queue overload");
         return RETCODE_QUEUE_FULL;
     }
+    // A client flooding the engine is refused alone, the others keep their share of the queue.
+    if (!quota_.Acquire(request, queue_.Capacity())) {
+        HILOGE("[SyncMsgHandler]Client queue overload");
+        return RETCODE_QUEUE_FULL;
+    }
 
     Task task(this, request, &notifier);
-    int retCode = queue_.PushBack(task);
+    int retCode = (executor_ != nullptr) ? executor_->Submit(task) : queue_.PushBack(task);
     if (retCode != RETCODE_SUCCESS) {
         HILOGI("[SyncMsgHandler]Push sync msg result is %d.", retCode);
+        quota_.Release(request->GetClientUid());
     }
     return retCode;
 }
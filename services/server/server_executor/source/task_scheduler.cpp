@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "server_executor/include/task_scheduler.h"
+
+#include <limits>
+
+#include "protocol/data_channel/include/i_request.h"
+#include "protocol/struct_definition/aie_info_define.h"
+
+namespace OHOS {
+namespace AI {
+namespace {
+const long long NO_DEADLINE = 0;
+}
+
+TaskScheduler::TaskScheduler() : sequence_(0), count_(0)
+{
+}
+
+bool TaskScheduler::IsScheduled(const Task &task)
+{
+    CHK_RET(task.request == nullptr, false);
+    return (task.request->GetPriority() != ALGORITHM_PRIORITY_NORMAL) ||
+        (task.request->GetDeadline() != NO_DEADLINE);
+}
+
+bool TaskScheduler::IsExpired(const Task &task, long long now)
+{
+    CHK_RET(task.request == nullptr, false);
+    long long deadline = task.request->GetDeadline();
+    return (deadline != NO_DEADLINE) && (deadline < now);
+}
+
+bool TaskScheduler::EntryCompare::operator()(const Entry &lhs, const Entry &rhs) const
+{
+    if (lhs.priority != rhs.priority) {
+        return lhs.priority < rhs.priority;
+    }
+    // Earliest deadline first, tasks without deadline go after those with one.
+    if (lhs.deadline != rhs.deadline) {
+        if (lhs.deadline == NO_DEADLINE || rhs.deadline == NO_DEADLINE) {
+            return lhs.deadline == NO_DEADLINE;
+        }
+        return lhs.deadline > rhs.deadline;
+    }
+    return lhs.sequence > rhs.sequence;
+}
+
+void TaskScheduler::Push(const Task &task)
+{
+    Entry entry;
+    entry.priority = (task.request == nullptr) ? ALGORITHM_PRIORITY_NORMAL : task.request->GetPriority();
+    entry.deadline = (task.request == nullptr) ? NO_DEADLINE : task.request->GetDeadline();
+    entry.task = task;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entry.sequence = sequence_++;
+    entries_.push(entry);
+    ++count_;
+}
+
+bool TaskScheduler::Pop(Task &task)
+{
+    return Pop(task, std::numeric_limits<int>::min());
+}
+
+bool TaskScheduler::Pop(Task &task, int minPriority)
+{
+    CHK_RET(count_ == 0, false);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHK_RET(entries_.empty() || entries_.top().priority < minPriority, false);
+    task = entries_.top().task;
+    entries_.pop();
+    --count_;
+    return true;
+}
+
+bool TaskScheduler::IsEmpty() const
+{
+    return count_ == 0;
+}
+} // namespace AI
+} // namespace OHOS
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "platform/lock/include/biased_rw_lock.h"
+#include "platform/lock/include/rw_lock.h"
+#include "platform/time/include/time_elapser.h"
+#include "utils/log/aie_log.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const int OPS_PER_THREAD = 100000;
+    const int MAX_THREAD_NUM = 64;
+    // One write every WRITE_INTERVAL operations of a thread, engines start and stop rarely compared to lookups.
+    const int WRITE_INTERVAL = 1000;
+}
+
+class RwLockPerfTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+/**
+ * Run threads reading a pair of values under the lock, and writing them once every writeInterval operations.
+ * Writers always keep both values equal, so a reader seeing them differ overlapped a writer.
+ *
+ * @return Elapsed time in microseconds, or -1 if a reader overlapped a writer or a write is lost.
+ */
+template<class LOCK>
+static long long RunContention(LOCK &lock, int threadNum, int writeInterval)
+{
+    long long first = 0;
+    long long second = 0;
+    std::atomic<bool> isBroken(false);
+
+    TimeElapser elapser;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; ++t) {
+        threads.emplace_back([&lock, &first, &second, &isBroken, writeInterval]() {
+            for (int i = 1; i <= OPS_PER_THREAD; ++i) {
+                if (writeInterval > 0 && i % writeInterval == 0) {
+                    WriteGuard<LOCK> guard(lock);
+                    ++first;
+                    ++second;
+                    continue;
+                }
+                ReadGuard<LOCK> guard(lock);
+                if (first != second) {
+                    isBroken = true;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    long long elapsed = elapser.ElapseMicro();
+
+    long long writeNum = (writeInterval > 0) ? static_cast<long long>(threadNum) * (OPS_PER_THREAD / writeInterval) : 0;
+    if (isBroken || first != writeNum) {
+        return -1;
+    }
+    return elapsed;
+}
+
+/**
+ * @tc.name: TestRwLockPerf001
+ * @tc.desc: Compare read throughput of the biased lock with the mutex based lock from 1 to 64 threads.
+ * @tc.type: PERF
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(RwLockPerfTest, TestRwLockPerf001, TestSize.Level1)
+{
+    for (int threadNum = 1; threadNum <= MAX_THREAD_NUM; threadNum *= 2) {
+        RwLock rwLock;
+        long long rwLockTime = RunContention(rwLock, threadNum, 0);
+        ASSERT_GE(rwLockTime, 0);
+
+        BiasedRwLock biasedLock;
+        long long biasedTime = RunContention(biasedLock, threadNum, 0);
+        ASSERT_GE(biasedTime, 0);
+
+        HILOGI("[Test][RwLockPerf]%d readers %d ops, rwLock[%lld]us, biased[%lld]us", threadNum,
+            threadNum * OPS_PER_THREAD, rwLockTime, biasedTime);
+    }
+}
+
+/**
+ * @tc.name: TestRwLockPerf002
+ * @tc.desc: Compare throughput of the biased lock with the mutex based lock from 1 to 64 threads with rare writes,
+ *           and check readers never overlap a writer.
+ * @tc.type: PERF
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(RwLockPerfTest, TestRwLockPerf002, TestSize.Level1)
+{
+    for (int threadNum = 1; threadNum <= MAX_THREAD_NUM; threadNum *= 2) {
+        RwLock rwLock;
+        long long rwLockTime = RunContention(rwLock, threadNum, WRITE_INTERVAL);
+        ASSERT_GE(rwLockTime, 0);
+
+        BiasedRwLock biasedLock;
+        long long biasedTime = RunContention(biasedLock, threadNum, WRITE_INTERVAL);
+        ASSERT_GE(biasedTime, 0);
+
+        HILOGI("[Test][RwLockPerf]%d threads %d ops 1/%d writes, rwLock[%lld]us, biased[%lld]us", threadNum,
+            threadNum * OPS_PER_THREAD, WRITE_INTERVAL, rwLockTime, biasedTime);
+    }
+}
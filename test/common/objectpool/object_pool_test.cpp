@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "platform/objectpool/object_pool.h"
+#include "platform/semaphore/include/i_semaphore.h"
+#include "platform/semaphore/include/simple_event_notifier.h"
+#include "protocol/data_channel/include/i_request.h"
+#include "protocol/data_channel/include/request.h"
+#include "utils/aie_macros.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+const size_t OBJECT_NUM = 16;
+const size_t CYCLE_NUM = 1000;
+const int TIME_OUT = 20;
+const int CONST_VALUE = 123;
+
+class PooledObject {
+public:
+    explicit PooledObject(int value) : value_(value)
+    {
+    }
+
+    ~PooledObject() = default;
+
+    DECLARE_OBJECT_POOL_ALLOCATION(PooledObject);
+
+    int GetValue() const
+    {
+        return value_;
+    }
+
+private:
+    int value_;
+};
+}
+
+class ObjectPoolTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+/**
+ * @tc.name: TestObjectPool001
+ * @tc.desc: Test objects created repeatedly by one thread are served from recycled memory.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NO
+ */
+HWTEST_F(ObjectPoolTest, TestObjectPool001, TestSize.Level1)
+{
+    std::vector<PooledObject*> objects(OBJECT_NUM, nullptr);
+    for (size_t i = 0; i < OBJECT_NUM; ++i) {
+        AIE_NEW(objects[i], PooledObject(static_cast<int>(i)));
+        ASSERT_NE(objects[i], nullptr);
+        ASSERT_EQ(objects[i]->GetValue(), static_cast<int>(i));
+    }
+    for (auto &object : objects) {
+        AIE_DELETE(object);
+    }
+
+    size_t missNum = ObjectPool<PooledObject>::MissNum();
+    size_t hitNum = ObjectPool<PooledObject>::HitNum();
+    for (size_t cycle = 0; cycle < CYCLE_NUM; ++cycle) {
+        for (size_t i = 0; i < OBJECT_NUM; ++i) {
+            AIE_NEW(objects[i], PooledObject(CONST_VALUE));
+            ASSERT_NE(objects[i], nullptr);
+        }
+        for (auto &object : objects) {
+            ASSERT_EQ(object->GetValue(), CONST_VALUE);
+            AIE_DELETE(object);
+        }
+    }
+    ASSERT_EQ(ObjectPool<PooledObject>::MissNum(), missNum);
+    ASSERT_EQ(ObjectPool<PooledObject>::HitNum(), hitNum + CYCLE_NUM * OBJECT_NUM);
+}
+
+/**
+ * @tc.name: TestObjectPool002
+ * @tc.desc: Test objects created by one thread and destroyed by another are recycled through the depot.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NO
+ */
+HWTEST_F(ObjectPoolTest, TestObjectPool002, TestSize.Level1)
+{
+    const size_t batchNum = OBJECT_POOL_LOCAL_CACHE_SIZE * 2;
+    std::vector<IRequest*> requests(batchNum, nullptr);
+    for (size_t cycle = 0; cycle < CYCLE_NUM / OBJECT_NUM; ++cycle) {
+        for (auto &request : requests) {
+            request = IRequest::Create();
+            ASSERT_NE(request, nullptr);
+        }
+        std::thread consumer([&requests] {
+            for (auto &request : requests) {
+                IRequest::Destroy(request);
+            }
+        });
+        consumer.join();
+    }
+
+    size_t missNum = ObjectPool<Request>::MissNum();
+    for (auto &request : requests) {
+        request = IRequest::Create();
+        ASSERT_NE(request, nullptr);
+    }
+    for (auto &request : requests) {
+        IRequest::Destroy(request);
+    }
+    ASSERT_EQ(ObjectPool<Request>::MissNum(), missNum);
+}
+
+/**
+ * @tc.name: TestObjectPool003
+ * @tc.desc: Test notifiers keep working with pooled semaphores.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NO
+ */
+HWTEST_F(ObjectPoolTest, TestObjectPool003, TestSize.Level1)
+{
+    for (size_t cycle = 0; cycle < CYCLE_NUM; ++cycle) {
+        SimpleEventNotifier<int> notifier(nullptr);
+        int item = CONST_VALUE;
+        int *itemOut = nullptr;
+        notifier.AddToBack(&item);
+        ASSERT_TRUE(notifier.GetFromFront(TIME_OUT, itemOut));
+        ASSERT_EQ(itemOut, &item);
+    }
+}
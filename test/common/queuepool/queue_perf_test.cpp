@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "platform/queuepool/queue.h"
+#include "platform/time/include/time_elapser.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "utils/log/aie_log.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const size_t PERF_QUEUE_CAPACITY = 256;
+    const int ITEMS_PER_PRODUCER = 200000;
+    const int SINGLE_THREAD = 1;
+    const int CONTENDED_THREADS = 4;
+    const size_t PERF_BULK_SIZE = 16;
+}
+
+class QueuePerfTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+/**
+ * Bounded queue guarded by one mutex, the way the queue was synchronized before, used as baseline.
+ */
+class MutexQueue {
+public:
+    explicit MutexQueue(size_t maxQueueSize) : totalNum_(maxQueueSize) {}
+
+    int PushBack(int &msgBlock)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() >= totalNum_) {
+            return RETCODE_QUEUE_FULL;
+        }
+        queue_.push_back(msgBlock);
+        return RETCODE_SUCCESS;
+    }
+
+    int PopFront(int &msgBlock)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) {
+            return RETCODE_QUEUE_EMPTY;
+        }
+        msgBlock = queue_.front();
+        queue_.pop_front();
+        return RETCODE_SUCCESS;
+    }
+
+private:
+    size_t totalNum_;
+    std::mutex mutex_;
+    std::deque<int> queue_;
+};
+
+/**
+ * Run producers and consumers against the queue, and check every item is received exactly once.
+ *
+ * @return Elapsed time in microseconds, or -1 if any item is lost or duplicated.
+ */
+template<class QUEUE>
+static long long RunContention(QUEUE &queue, int producerNum, int consumerNum)
+{
+    const int totalItems = producerNum * ITEMS_PER_PRODUCER;
+    std::vector<std::atomic<int>> received(totalItems);
+    for (auto &item : received) {
+        item = 0;
+    }
+    std::atomic<int> consumedNum(0);
+
+    TimeElapser elapser;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producerNum; ++p) {
+        threads.emplace_back([&queue, p]() {
+            for (int i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+                int value = p * ITEMS_PER_PRODUCER + i;
+                while (queue.PushBack(value) != RETCODE_SUCCESS) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumerNum; ++c) {
+        threads.emplace_back([&queue, &received, &consumedNum, totalItems]() {
+            int value = 0;
+            while (consumedNum.load() < totalItems) {
+                if (queue.PopFront(value) != RETCODE_SUCCESS) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                ++received[value];
+                ++consumedNum;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    long long elapsed = elapser.ElapseMicro();
+
+    for (auto &item : received) {
+        if (item != 1) {
+            return -1;
+        }
+    }
+    return elapsed;
+}
+
+/**
+ * Same as RunContention, but items move in bulks of PERF_BULK_SIZE.
+ *
+ * @return Elapsed time in microseconds, or -1 if any item is lost or duplicated.
+ */
+static long long RunBulkContention(Queue<int> &queue, int producerNum, int consumerNum)
+{
+    const int totalItems = producerNum * ITEMS_PER_PRODUCER;
+    std::vector<std::atomic<int>> received(totalItems);
+    for (auto &item : received) {
+        item = 0;
+    }
+    std::atomic<int> consumedNum(0);
+
+    TimeElapser elapser;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producerNum; ++p) {
+        threads.emplace_back([&queue, p]() {
+            int values[PERF_BULK_SIZE];
+            int i = 0;
+            while (i < ITEMS_PER_PRODUCER) {
+                size_t num = 0;
+                for (; num < PERF_BULK_SIZE && i + static_cast<int>(num) < ITEMS_PER_PRODUCER; ++num) {
+                    values[num] = p * ITEMS_PER_PRODUCER + i + static_cast<int>(num);
+                }
+                size_t pushNum = 0;
+                if (queue.PushBulk(values, num, pushNum) != RETCODE_SUCCESS) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                i += static_cast<int>(pushNum);
+            }
+        });
+    }
+    for (int c = 0; c < consumerNum; ++c) {
+        threads.emplace_back([&queue, &received, &consumedNum, totalItems]() {
+            int values[PERF_BULK_SIZE];
+            while (consumedNum.load() < totalItems) {
+                size_t popNum = 0;
+                if (queue.PopBulk(values, PERF_BULK_SIZE, popNum) != RETCODE_SUCCESS) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (size_t i = 0; i < popNum; ++i) {
+                    ++received[values[i]];
+                }
+                consumedNum += static_cast<int>(popNum);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    long long elapsed = elapser.ElapseMicro();
+
+    for (auto &item : received) {
+        if (item != 1) {
+            return -1;
+        }
+    }
+    return elapsed;
+}
+
+/**
+ * @tc.name: TestQueuePerf001
+ * @tc.desc: Compare throughput of lock-free queue with a mutex queue under one producer and one consumer.
+ * @tc.type: PERF
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(QueuePerfTest, TestQueuePerf001, TestSize.Level1)
+{
+    MutexQueue mutexQueue(PERF_QUEUE_CAPACITY);
+    long long mutexTime = RunContention(mutexQueue, SINGLE_THREAD, SINGLE_THREAD);
+    ASSERT_GT(mutexTime, 0);
+
+    Queue<int> mpmcQueue(PERF_QUEUE_CAPACITY);
+    long long mpmcTime = RunContention(mpmcQueue, SINGLE_THREAD, SINGLE_THREAD);
+    ASSERT_GT(mpmcTime, 0);
+
+    HILOGI("[Test][QueuePerf]1P1C %d items, mutex[%lld]us, mpmc[%lld]us", ITEMS_PER_PRODUCER, mutexTime, mpmcTime);
+}
+
+/**
+ * @tc.name: TestQueuePerf002
+ * @tc.desc: Compare throughput of lock-free queue with a mutex queue under multiple producers and consumers.
+ * @tc.type: PERF
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(QueuePerfTest, TestQueuePerf002, TestSize.Level1)
+{
+    MutexQueue mutexQueue(PERF_QUEUE_CAPACITY);
+    long long mutexTime = RunContention(mutexQueue, CONTENDED_THREADS, CONTENDED_THREADS);
+    ASSERT_GT(mutexTime, 0);
+
+    Queue<int> mpmcQueue(PERF_QUEUE_CAPACITY);
+    long long mpmcTime = RunContention(mpmcQueue, CONTENDED_THREADS, CONTENDED_THREADS);
+    ASSERT_GT(mpmcTime, 0);
+
+    HILOGI("[Test][QueuePerf]%dP%dC %d items, mutex[%lld]us, mpmc[%lld]us", CONTENDED_THREADS, CONTENDED_THREADS,
+        CONTENDED_THREADS * ITEMS_PER_PRODUCER, mutexTime, mpmcTime);
+}
+
+/**
+ * @tc.name: TestQueuePerf003
+ * @tc.desc: Compare throughput of bulk push and pop with single push and pop under multiple producers and consumers.
+ * @tc.type: PERF
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(QueuePerfTest, TestQueuePerf003, TestSize.Level1)
+{
+    Queue<int> singleQueue(PERF_QUEUE_CAPACITY);
+    long long singleTime = RunContention(singleQueue, CONTENDED_THREADS, CONTENDED_THREADS);
+    ASSERT_GT(singleTime, 0);
+
+    Queue<int> bulkQueue(PERF_QUEUE_CAPACITY);
+    long long bulkTime = RunBulkContention(bulkQueue, CONTENDED_THREADS, CONTENDED_THREADS);
+    ASSERT_GT(bulkTime, 0);
+
+    HILOGI("[Test][QueuePerf]%dP%dC %d items, single[%lld]us, bulk of %zu[%lld]us", CONTENDED_THREADS,
+        CONTENDED_THREADS, CONTENDED_THREADS * ITEMS_PER_PRODUCER, singleTime, PERF_BULK_SIZE, bulkTime);
+}
@@ -13,10 +13,14 @@
  * limitations under the License.
  */
 
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "platform/queuepool/queue.h"
 #include "platform/queuepool/queue_pool.h"
+#include "platform/time/include/time.h"
 #include "protocol/retcode_inner/aie_retcode_inner.h"
 #include "utils/log/aie_log.h"
 
@@ -26,6 +30,14 @@ using namespace testing::ext;
 namespace {
     const int SINGLE_QUEUE_CAPACITY = 3;
     const int TEST_QUEUE_SINGLE_ELEMENT = 0;
+    const int POP_WAIT_TIME_MS = 20;
+    const int PUSH_DELAY_MS = 10;
+    const int WAIT_FOREVER = 0;
+    const size_t BUDGET_QUEUE_COUNT = 32;
+    const size_t PLUGIN_QUEUE_CAPACITY = 8;
+    const int TRIM_ALL_IDLE_QUEUES = 0;
+    const int WRAP_AROUND_ROUNDS = 10;
+    const size_t BULK_SIZE = 2;
 }
 
 class QueuepoolTest : public testing::Test {
@@ -144,7 +156,7 @@ HWTEST_F(QueuepoolTest, TestQueuePool006, TestSize.Level1)
 
 /**
  * @tc.name: TestQueuePool007
- * @tc.desc: Test the capacity of queue pool.
+ * @tc.desc: Test the capacity of queue pool is limited by its memory budget.
  * @tc.type: FUNC
  * @tc.require: AR000F77MS
  */
@@ -152,14 +164,16 @@ HWTEST_F(QueuepoolTest, TestQueuePool007, TestSize.Level1)
 {
     QueuePool<int> *queuePool = QueuePool<int>::GetInstance(SINGLE_QUEUE_CAPACITY);
     ASSERT_NE(queuePool, nullptr);
+    queuePool->SetMemoryBudget(Queue<int>::MemorySize(SINGLE_QUEUE_CAPACITY) * BUDGET_QUEUE_COUNT);
 
-    std::shared_ptr<Queue<int>> queue;
-    for (auto i = 0; i < MAX_QUEUE_COUNT; ++i) {
-        queue = queuePool->Pop();
+    std::vector<std::shared_ptr<Queue<int>>> queues;
+    for (size_t i = 0; i < BUDGET_QUEUE_COUNT; ++i) {
+        std::shared_ptr<Queue<int>> queue = queuePool->Pop();
         ASSERT_NE(queue, nullptr);
+        queues.push_back(queue);
     }
 
-    queue = queuePool->Pop();
+    std::shared_ptr<Queue<int>> queue = queuePool->Pop();
     ASSERT_EQ(queue, nullptr);
 
     QueuePool<int>::ReleaseInstance();
@@ -184,6 +198,86 @@ HWTEST_F(QueuepoolTest, TestQueuePool008, TestSize.Level1)
     QueuePool<int>::ReleaseInstance();
 }
 
+/**
+ * @tc.name: TestQueuePool010
+ * @tc.desc: Pop queues of different capacities and verify idle queues are reused by capacity.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(QueuepoolTest, TestQueuePool010, TestSize.Level1)
+{
+    QueuePool<int> *queuePool = QueuePool<int>::GetInstance(SINGLE_QUEUE_CAPACITY);
+    ASSERT_NE(queuePool, nullptr);
+
+    std::shared_ptr<Queue<int>> queue = queuePool->Pop(PLUGIN_QUEUE_CAPACITY);
+    ASSERT_NE(queue, nullptr);
+    ASSERT_EQ(queue->Capacity(), PLUGIN_QUEUE_CAPACITY);
+    Queue<int> *rawQueue = queue.get();
+    queuePool->Push(queue);
+    ASSERT_EQ(queuePool->IdleQueueNum(), 1);
+
+    std::shared_ptr<Queue<int>> defaultQueue = queuePool->Pop();
+    ASSERT_NE(defaultQueue, nullptr);
+    ASSERT_EQ(defaultQueue->Capacity(), SINGLE_QUEUE_CAPACITY);
+    ASSERT_EQ(queuePool->IdleQueueNum(), 1);
+
+    queue = queuePool->Pop(PLUGIN_QUEUE_CAPACITY);
+    ASSERT_EQ(queue.get(), rawQueue);
+    ASSERT_EQ(queuePool->IdleQueueNum(), 0);
+
+    QueuePool<int>::ReleaseInstance();
+}
+
+/**
+ * @tc.name: TestQueuePool011
+ * @tc.desc: Trim idle queues and verify the memory usage of queue pool is released.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(QueuepoolTest, TestQueuePool011, TestSize.Level1)
+{
+    QueuePool<int> *queuePool = QueuePool<int>::GetInstance(SINGLE_QUEUE_CAPACITY);
+    ASSERT_NE(queuePool, nullptr);
+
+    std::shared_ptr<Queue<int>> busyQueue = queuePool->Pop();
+    ASSERT_NE(busyQueue, nullptr);
+    std::shared_ptr<Queue<int>> idleQueue = queuePool->Pop();
+    ASSERT_NE(idleQueue, nullptr);
+    ASSERT_EQ(queuePool->MemoryUsage(), Queue<int>::MemorySize(SINGLE_QUEUE_CAPACITY) * 2);
+
+    queuePool->Push(idleQueue);
+    ASSERT_EQ(queuePool->Trim(TRIM_ALL_IDLE_QUEUES), 1);
+    ASSERT_EQ(queuePool->IdleQueueNum(), 0);
+    ASSERT_EQ(queuePool->BusyQueueNum(), 1);
+    ASSERT_EQ(queuePool->MemoryUsage(), Queue<int>::MemorySize(SINGLE_QUEUE_CAPACITY));
+
+    QueuePool<int>::ReleaseInstance();
+}
+
+/**
+ * @tc.name: TestQueuePool012
+ * @tc.desc: Exhaust the memory budget and verify idle queues of other capacities are released for a new queue.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(QueuepoolTest, TestQueuePool012, TestSize.Level1)
+{
+    QueuePool<int> *queuePool = QueuePool<int>::GetInstance(SINGLE_QUEUE_CAPACITY);
+    ASSERT_NE(queuePool, nullptr);
+    queuePool->SetMemoryBudget(Queue<int>::MemorySize(PLUGIN_QUEUE_CAPACITY));
+
+    std::shared_ptr<Queue<int>> queue = queuePool->Pop();
+    ASSERT_NE(queue, nullptr);
+    queuePool->Push(queue);
+
+    queue = queuePool->Pop(PLUGIN_QUEUE_CAPACITY);
+    ASSERT_NE(queue, nullptr);
+    ASSERT_EQ(queuePool->IdleQueueNum(), 0);
+    ASSERT_EQ(queuePool->MemoryUsage(), Queue<int>::MemorySize(PLUGIN_QUEUE_CAPACITY));
+
+    QueuePool<int>::ReleaseInstance();
+}
+
 /**
  * @tc.name: TestQueuePool009
  * @tc.desc: Pop a queue and verify it is empty.
@@ -497,3 +591,180 @@ HWTEST_F(QueuepoolTest, TestQueue014, TestSize.Level1)
 
     QueuePool<int>::ReleaseInstance();
 }
+
+/**
+ * @tc.name: TestQueue015
+ * @tc.desc: Block on an empty queue and verify the consumer is woken up by push.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(QueuepoolTest, TestQueue015, TestSize.Level1)
+{
+    QueuePool<int> *queuePool = QueuePool<int>::GetInstance(SINGLE_QUEUE_CAPACITY);
+    ASSERT_NE(queuePool, nullptr);
+    std::shared_ptr<Queue<int>> queue = queuePool->Pop();
+    ASSERT_NE(queue, nullptr);
+
+    std::thread producer([&queue]() {
+        StepSleepMs(PUSH_DELAY_MS);
+        int iv = TEST_QUEUE_SINGLE_ELEMENT;
+        queue->PushBack(iv);
+    });
+    int iv = -1;
+    int result = queue->PopFront(iv, WAIT_FOREVER);
+    producer.join();
+    ASSERT_EQ(result, RETCODE_SUCCESS);
+    ASSERT_EQ(iv, TEST_QUEUE_SINGLE_ELEMENT);
+
+    QueuePool<int>::ReleaseInstance();
+}
+
+/**
+ * @tc.name: TestQueue016
+ * @tc.desc: Block on an empty queue and verify the pop times out.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(QueuepoolTest, TestQueue016, TestSize.Level1)
+{
+    QueuePool<int> *queuePool = QueuePool<int>::GetInstance(SINGLE_QUEUE_CAPACITY);
+    ASSERT_NE(queuePool, nullptr);
+    std::shared_ptr<Queue<int>> queue = queuePool->Pop();
+    ASSERT_NE(queue, nullptr);
+
+    int iv;
+    time_t startTime = GetCurTimeMillSec();
+    int result = queue->PopFront(iv, POP_WAIT_TIME_MS);
+    ASSERT_EQ(result, RETCODE_QUEUE_EMPTY);
+    ASSERT_GE(GetCurTimeMillSec() - startTime, POP_WAIT_TIME_MS);
+
+    QueuePool<int>::ReleaseInstance();
+}
+
+/**
+ * @tc.name: TestQueue017
+ * @tc.desc: Block on an empty queue and verify Wakeup releases the consumer until the queue is reset.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(QueuepoolTest, TestQueue017, TestSize.Level1)
+{
+    QueuePool<int> *queuePool = QueuePool<int>::GetInstance(SINGLE_QUEUE_CAPACITY);
+    ASSERT_NE(queuePool, nullptr);
+    std::shared_ptr<Queue<int>> queue = queuePool->Pop();
+    ASSERT_NE(queue, nullptr);
+
+    std::thread waker([&queue]() {
+        StepSleepMs(PUSH_DELAY_MS);
+        queue->Wakeup();
+    });
+    int iv;
+    int result = queue->PopFront(iv, WAIT_FOREVER);
+    waker.join();
+    ASSERT_EQ(result, RETCODE_QUEUE_EMPTY);
+
+    queue->Reset();
+    time_t startTime = GetCurTimeMillSec();
+    result = queue->PopFront(iv, POP_WAIT_TIME_MS);
+    ASSERT_EQ(result, RETCODE_QUEUE_EMPTY);
+    ASSERT_GE(GetCurTimeMillSec() - startTime, POP_WAIT_TIME_MS);
+
+    QueuePool<int>::ReleaseInstance();
+}
+
+/**
+ * @tc.name: TestQueue018
+ * @tc.desc: Push and pop across several rounds of the ring and verify order, Count, IsFull and IsEmpty.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(QueuepoolTest, TestQueue018, TestSize.Level1)
+{
+    Queue<int> queue(SINGLE_QUEUE_CAPACITY);
+    int next = 0;
+    int expected = 0;
+    for (int round = 0; round < WRAP_AROUND_ROUNDS; ++round) {
+        while (queue.PushBack(next) == RETCODE_SUCCESS) {
+            ++next;
+        }
+        ASSERT_TRUE(queue.IsFull());
+        ASSERT_EQ(queue.Count(), static_cast<size_t>(SINGLE_QUEUE_CAPACITY));
+
+        int iv;
+        while (queue.PopFront(iv) == RETCODE_SUCCESS) {
+            ASSERT_EQ(iv, expected);
+            ++expected;
+        }
+        ASSERT_TRUE(queue.IsEmpty());
+        ASSERT_EQ(queue.Count(), 0U);
+    }
+    ASSERT_EQ(next, SINGLE_QUEUE_CAPACITY * WRAP_AROUND_ROUNDS);
+}
+
+/**
+ * @tc.name: TestQueue019
+ * @tc.desc: Push and pop messages in bulk across several rounds of the ring, partially when full or empty.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(QueuepoolTest, TestQueue019, TestSize.Level1)
+{
+    Queue<int> queue(SINGLE_QUEUE_CAPACITY);
+    int next = 0;
+    int expected = 0;
+    for (int round = 0; round < WRAP_AROUND_ROUNDS; ++round) {
+        int values[BULK_SIZE] = {next, next + 1};
+        size_t pushNum = 0;
+        ASSERT_EQ(queue.PushBulk(values, BULK_SIZE, pushNum), RETCODE_SUCCESS);
+        ASSERT_EQ(pushNum, BULK_SIZE);
+        next += static_cast<int>(pushNum);
+
+        // Only one node is left for the second bulk.
+        int moreValues[BULK_SIZE] = {next, next + 1};
+        ASSERT_EQ(queue.PushBulk(moreValues, BULK_SIZE, pushNum), RETCODE_SUCCESS);
+        ASSERT_EQ(pushNum, static_cast<size_t>(SINGLE_QUEUE_CAPACITY) - BULK_SIZE);
+        next += static_cast<int>(pushNum);
+        ASSERT_EQ(queue.PushBulk(moreValues, BULK_SIZE, pushNum), RETCODE_QUEUE_FULL);
+        ASSERT_EQ(pushNum, 0U);
+
+        int popValues[SINGLE_QUEUE_CAPACITY + 1];
+        size_t popNum = 0;
+        ASSERT_EQ(queue.PopBulk(popValues, SINGLE_QUEUE_CAPACITY + 1, popNum), RETCODE_SUCCESS);
+        ASSERT_EQ(popNum, static_cast<size_t>(SINGLE_QUEUE_CAPACITY));
+        for (size_t i = 0; i < popNum; ++i) {
+            ASSERT_EQ(popValues[i], expected);
+            ++expected;
+        }
+        ASSERT_EQ(queue.PopBulk(popValues, SINGLE_QUEUE_CAPACITY, popNum), RETCODE_QUEUE_EMPTY);
+        ASSERT_EQ(popNum, 0U);
+    }
+    ASSERT_EQ(next, SINGLE_QUEUE_CAPACITY * WRAP_AROUND_ROUNDS);
+}
+
+/**
+ * @tc.name: TestQueue020
+ * @tc.desc: Block in bulk pop on an empty queue until a producer pushes, or until time out.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(QueuepoolTest, TestQueue020, TestSize.Level1)
+{
+    Queue<int> queue(SINGLE_QUEUE_CAPACITY);
+    int popValues[SINGLE_QUEUE_CAPACITY];
+    size_t popNum = 0;
+    time_t startTime = GetCurTimeMillSec();
+    ASSERT_EQ(queue.PopBulk(popValues, SINGLE_QUEUE_CAPACITY, popNum, POP_WAIT_TIME_MS), RETCODE_QUEUE_EMPTY);
+    ASSERT_GE(GetCurTimeMillSec() - startTime, POP_WAIT_TIME_MS);
+
+    std::thread producer([&queue]() {
+        StepSleepMs(PUSH_DELAY_MS);
+        int values[BULK_SIZE] = {TEST_QUEUE_SINGLE_ELEMENT, TEST_QUEUE_SINGLE_ELEMENT + 1};
+        size_t pushNum = 0;
+        queue.PushBulk(values, BULK_SIZE, pushNum);
+    });
+    int result = queue.PopBulk(popValues, SINGLE_QUEUE_CAPACITY, popNum, WAIT_FOREVER);
+    producer.join();
+    ASSERT_EQ(result, RETCODE_SUCCESS);
+    ASSERT_GE(popNum, 1U);
+    ASSERT_EQ(popValues[0], TEST_QUEUE_SINGLE_ELEMENT);
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "platform/queuepool/work_stealing_deque.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "utils/log/aie_log.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const size_t INIT_CAPACITY = 4;
+    const int GROW_ELEMENT_NUM = 100;
+    const int STEAL_ELEMENT_NUM = 100000;
+    const int THIEF_NUM = 3;
+    // The owner pops one element after pushing this many.
+    const int OWNER_POP_INTERVAL = 4;
+}
+
+class WorkStealingDequeTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+/**
+ * @tc.name: TestWorkStealingDeque001
+ * @tc.desc: Test the owner pops the newest element, thieves steal the oldest one, and the deque grows.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(WorkStealingDequeTest, TestWorkStealingDeque001, TestSize.Level0)
+{
+    WorkStealingDeque<int> workDeque(INIT_CAPACITY);
+    int item = 0;
+    ASSERT_TRUE(workDeque.IsEmpty());
+    ASSERT_EQ(workDeque.Pop(item), RETCODE_QUEUE_EMPTY);
+    ASSERT_EQ(workDeque.Steal(item), RETCODE_QUEUE_EMPTY);
+
+    for (int i = 0; i < GROW_ELEMENT_NUM; ++i) {
+        ASSERT_EQ(workDeque.Push(i), RETCODE_SUCCESS);
+    }
+    ASSERT_EQ(workDeque.Count(), static_cast<size_t>(GROW_ELEMENT_NUM));
+
+    ASSERT_EQ(workDeque.Pop(item), RETCODE_SUCCESS);
+    ASSERT_EQ(item, GROW_ELEMENT_NUM - 1);
+    ASSERT_EQ(workDeque.Steal(item), RETCODE_SUCCESS);
+    ASSERT_EQ(item, 0);
+
+    // Elements are kept in order across the grown buffers.
+    for (int i = 1; i < GROW_ELEMENT_NUM - 1; ++i) {
+        ASSERT_EQ(workDeque.Steal(item), RETCODE_SUCCESS);
+        ASSERT_EQ(item, i);
+    }
+    ASSERT_TRUE(workDeque.IsEmpty());
+    ASSERT_EQ(workDeque.Pop(item), RETCODE_QUEUE_EMPTY);
+}
+
+/**
+ * @tc.name: TestWorkStealingDeque002
+ * @tc.desc: Test each element is taken exactly once while the owner pushes and pops and thieves steal.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77MS
+ */
+HWTEST_F(WorkStealingDequeTest, TestWorkStealingDeque002, TestSize.Level0)
+{
+    WorkStealingDeque<int> workDeque(INIT_CAPACITY);
+    std::vector<std::atomic<int>> takenNums(STEAL_ELEMENT_NUM);
+    for (auto &takenNum : takenNums) {
+        takenNum = 0;
+    }
+    std::atomic<bool> isPushing(true);
+    std::atomic<int> stolenNum(0);
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < THIEF_NUM; ++i) {
+        thieves.emplace_back([&] {
+            int item = 0;
+            while (isPushing || !workDeque.IsEmpty()) {
+                if (workDeque.Steal(item) == RETCODE_SUCCESS) {
+                    ++takenNums[item];
+                    ++stolenNum;
+                }
+            }
+        });
+    }
+
+    int item = 0;
+    for (int i = 0; i < STEAL_ELEMENT_NUM; ++i) {
+        ASSERT_EQ(workDeque.Push(i), RETCODE_SUCCESS);
+        if (i % OWNER_POP_INTERVAL == 0 && workDeque.Pop(item) == RETCODE_SUCCESS) {
+            ++takenNums[item];
+        }
+    }
+    while (workDeque.Pop(item) == RETCODE_SUCCESS) {
+        ++takenNums[item];
+    }
+    isPushing = false;
+    for (auto &thief : thieves) {
+        thief.join();
+    }
+
+    for (int i = 0; i < STEAL_ELEMENT_NUM; ++i) {
+        ASSERT_EQ(takenNums[i], 1);
+    }
+    HILOGI("[Test]TestWorkStealingDeque002 stolen %d of %d elements.", stolenNum.load(), STEAL_ELEMENT_NUM);
+}
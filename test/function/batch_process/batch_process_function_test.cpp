@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "client_executor/include/i_aie_client.inl"
+#include "protocol/ipc_interface/ai_service.h"
+#include "service_dead_cb.h"
+#include "utils/log/aie_log.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const char * const INPUT_CHARACTER = "inputData";
+    const char * const CONFIG_DESCRIPTION = "config information";
+    const long long CLIENT_INFO_VERSION = 1;
+    const int CLIENT_ID = -1;
+    const int SESSION_ID = -1;
+    const long long ALGORITHM_INFO_CLIENT_VERSION = 2;
+    const int ALGORITHM_TYPE = 0;
+    const long long ALGORITHM_VERSION = 1;
+    const int OPERATE_ID = 2;
+    const int REQUEST_ID = 3;
+    const int BATCH_NUM = 8;
+}
+
+class BatchProcessFunctionTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+static void TestGetRightInfo(ConfigInfo &configInfo, ClientInfo &clientInfo, AlgorithmInfo &algoInfo)
+{
+    configInfo.description = CONFIG_DESCRIPTION;
+
+    clientInfo.clientVersion = CLIENT_INFO_VERSION;
+    clientInfo.clientId = CLIENT_ID;
+    clientInfo.sessionId = SESSION_ID;
+    clientInfo.serverUid = INVALID_UID;
+    clientInfo.clientUid = INVALID_UID;
+    clientInfo.extendLen = 0;
+    clientInfo.extendMsg = nullptr;
+
+    algoInfo.clientVersion = ALGORITHM_INFO_CLIENT_VERSION;
+    algoInfo.isAsync = false;
+    algoInfo.algorithmType = ALGORITHM_TYPE;
+    algoInfo.algorithmVersion = ALGORITHM_VERSION;
+    algoInfo.isCloud = true;
+    algoInfo.operateId = OPERATE_ID;
+    algoInfo.requestId = REQUEST_ID;
+    algoInfo.extendLen = 0;
+    algoInfo.extendMsg = nullptr;
+}
+
+/**
+ * @tc.name: TestAieClientBatchProcess001
+ * @tc.desc: Test batch process function: several sync inputs are executed in one call, each gets its result.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NQ
+ */
+HWTEST_F(BatchProcessFunctionTest, TestAieClientBatchProcess001, TestSize.Level0)
+{
+    HILOGI("[Test]Begin to testAieClientBatchProcess001");
+    ConfigInfo configInfo;
+    ClientInfo clientInfo;
+    AlgorithmInfo algoInfo;
+    TestGetRightInfo(configInfo, clientInfo, algoInfo);
+
+    DataInfo inputInfo = {
+        .data = reinterpret_cast<unsigned char*>(const_cast<char*>(INPUT_CHARACTER)),
+        .length = static_cast<int>(strlen(INPUT_CHARACTER)) + 1,
+    };
+
+    ServiceDeadCb cb = ServiceDeadCb();
+    int initRetCode = AieClientInit(configInfo, clientInfo, algoInfo, &cb);
+    ASSERT_EQ(initRetCode, RETCODE_SUCCESS);
+
+    DataInfo outputInfo = {
+        .data = nullptr,
+        .length = 0,
+    };
+    int prepareRetCode = AieClientPrepare(clientInfo, algoInfo, inputInfo, outputInfo, nullptr);
+    ASSERT_EQ(prepareRetCode, RETCODE_SUCCESS);
+
+    std::vector<DataInfo> inputInfos(BATCH_NUM, inputInfo);
+    std::vector<DataInfo> outputInfos;
+    std::vector<int> retCodes;
+    int processRetCode = AieClientBatchProcess(clientInfo, algoInfo, inputInfos, outputInfos, retCodes);
+    EXPECT_EQ(processRetCode, RETCODE_SUCCESS);
+    ASSERT_EQ(outputInfos.size(), inputInfos.size());
+    ASSERT_EQ(retCodes.size(), inputInfos.size());
+    for (int i = 0; i < BATCH_NUM; ++i) {
+        EXPECT_EQ(retCodes[i], RETCODE_SUCCESS);
+        free(outputInfos[i].data);
+    }
+
+    AieClientRelease(clientInfo, algoInfo, inputInfo);
+    AieClientDestroy(clientInfo);
+}
+
+/**
+ * @tc.name: TestAieClientBatchProcess002
+ * @tc.desc: Test batch process function: an empty batch and a batch over MAX_BATCH_EXECUTE_NUM are refused.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NQ
+ */
+HWTEST_F(BatchProcessFunctionTest, TestAieClientBatchProcess002, TestSize.Level0)
+{
+    HILOGI("[Test]Begin to testAieClientBatchProcess002");
+    ConfigInfo configInfo;
+    ClientInfo clientInfo;
+    AlgorithmInfo algoInfo;
+    TestGetRightInfo(configInfo, clientInfo, algoInfo);
+
+    DataInfo inputInfo = {
+        .data = reinterpret_cast<unsigned char*>(const_cast<char*>(INPUT_CHARACTER)),
+        .length = static_cast<int>(strlen(INPUT_CHARACTER)) + 1,
+    };
+
+    ServiceDeadCb cb = ServiceDeadCb();
+    int initRetCode = AieClientInit(configInfo, clientInfo, algoInfo, &cb);
+    ASSERT_EQ(initRetCode, RETCODE_SUCCESS);
+
+    DataInfo outputInfo = {
+        .data = nullptr,
+        .length = 0,
+    };
+    int prepareRetCode = AieClientPrepare(clientInfo, algoInfo, inputInfo, outputInfo, nullptr);
+    ASSERT_EQ(prepareRetCode, RETCODE_SUCCESS);
+
+    std::vector<DataInfo> inputInfos;
+    std::vector<DataInfo> outputInfos;
+    std::vector<int> retCodes;
+    int processRetCode = AieClientBatchProcess(clientInfo, algoInfo, inputInfos, outputInfos, retCodes);
+    EXPECT_EQ(processRetCode, RETCODE_INVALID_PARAM);
+
+    inputInfos.assign(MAX_BATCH_EXECUTE_NUM + 1, inputInfo);
+    processRetCode = AieClientBatchProcess(clientInfo, algoInfo, inputInfos, outputInfos, retCodes);
+    EXPECT_EQ(processRetCode, RETCODE_INVALID_PARAM);
+
+    AieClientRelease(clientInfo, algoInfo, inputInfo);
+    AieClientDestroy(clientInfo);
+}
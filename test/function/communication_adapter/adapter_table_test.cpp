@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "communication_adapter/include/adapter_table.h"
+#include "utils/constants/constants.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const size_t SINGLE_CAPACITY = 1;
+    const size_t CAPACITY = 4;
+    // With one slot, client IDs are the generations of the slot: 1, 2, 3, then back to 1.
+    const int MAX_CLIENT_ID = 3;
+    const size_t WRAP_ROUND_NUM = 4;
+}
+
+class AdapterTableTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+/**
+ * @tc.name: TestAdapterTable001
+ * @tc.desc: Test clients get distinct IDs up to the capacity, and the ID of a removed client no longer matches.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NL
+ */
+HWTEST_F(AdapterTableTest, TestAdapterTable001, TestSize.Level0)
+{
+    AdapterTable adapterTable(CAPACITY);
+    std::vector<int> clientIds;
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        int clientId = adapterTable.AddAdapter();
+        ASSERT_NE(clientId, INVALID_CLIENT_ID);
+        for (int otherId : clientIds) {
+            ASSERT_NE(clientId, otherId);
+        }
+        clientIds.push_back(clientId);
+    }
+    ASSERT_EQ(adapterTable.AddAdapter(), INVALID_CLIENT_ID);
+
+    int removedId = clientIds[0];
+    SaServerAdapter *adapter = adapterTable.Acquire(removedId);
+    ASSERT_NE(adapter, nullptr);
+    adapterTable.Release(removedId);
+    ASSERT_TRUE(adapterTable.RemoveAdapter(removedId));
+    ASSERT_FALSE(adapterTable.RemoveAdapter(removedId));
+    ASSERT_EQ(adapterTable.Acquire(removedId), nullptr);
+
+    // The slot is reused under a new generation, the stale ID does not reach the new client.
+    int newId = adapterTable.AddAdapter();
+    ASSERT_NE(newId, INVALID_CLIENT_ID);
+    ASSERT_NE(newId, removedId);
+    ASSERT_EQ(adapterTable.Acquire(removedId), nullptr);
+    ASSERT_FALSE(adapterTable.RemoveAdapter(removedId));
+    ASSERT_EQ(adapterTable.Acquire(INVALID_CLIENT_ID), nullptr);
+}
+
+/**
+ * @tc.name: TestAdapterTable002
+ * @tc.desc: Test a client removed during a call keeps its adapter until the call ends, then its slot is reclaimed.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NL
+ */
+HWTEST_F(AdapterTableTest, TestAdapterTable002, TestSize.Level0)
+{
+    AdapterTable adapterTable(SINGLE_CAPACITY);
+    int clientId = adapterTable.AddAdapter();
+    ASSERT_NE(clientId, INVALID_CLIENT_ID);
+
+    SaServerAdapter *adapter = adapterTable.Acquire(clientId);
+    ASSERT_NE(adapter, nullptr);
+    ASSERT_TRUE(adapterTable.RemoveAdapter(clientId));
+
+    // The call in flight still uses the adapter, so the only slot is not free yet.
+    ASSERT_EQ(adapter->GetAdapterId(), clientId);
+    ASSERT_EQ(adapterTable.AddAdapter(), INVALID_CLIENT_ID);
+    ASSERT_EQ(adapterTable.Acquire(clientId), nullptr);
+
+    // The end of the last call deletes the retired adapter and frees the slot.
+    adapterTable.Release(clientId);
+    int newId = adapterTable.AddAdapter();
+    ASSERT_NE(newId, INVALID_CLIENT_ID);
+    ASSERT_NE(newId, clientId);
+    SaServerAdapter *newAdapter = adapterTable.Acquire(newId);
+    ASSERT_NE(newAdapter, nullptr);
+    ASSERT_EQ(newAdapter->GetAdapterId(), newId);
+    adapterTable.Release(newId);
+}
+
+/**
+ * @tc.name: TestAdapterTable003
+ * @tc.desc: Test the generation of a slot wraps before the client ID exceeds its maximum.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NL
+ */
+HWTEST_F(AdapterTableTest, TestAdapterTable003, TestSize.Level0)
+{
+    AdapterTable adapterTable(SINGLE_CAPACITY, MAX_CLIENT_ID);
+    std::vector<int> clientIds;
+    for (size_t i = 0; i < WRAP_ROUND_NUM; ++i) {
+        int clientId = adapterTable.AddAdapter();
+        ASSERT_NE(clientId, INVALID_CLIENT_ID);
+        ASSERT_LE(clientId, MAX_CLIENT_ID);
+        clientIds.push_back(clientId);
+        ASSERT_TRUE(adapterTable.RemoveAdapter(clientId));
+    }
+    ASSERT_EQ(clientIds, std::vector<int>({1, 2, 3, 1}));
+}
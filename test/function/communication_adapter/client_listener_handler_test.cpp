@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "securec.h"
+
+#include "communication_adapter/include/client_listener_handler.h"
+#include "communication_adapter/include/sa_server_adapter.h"
+#include "platform/os_wrapper/ipc/include/aie_ipc.h"
+#include "protocol/data_channel/include/i_request.h"
+#include "protocol/data_channel/include/i_response.h"
+#include "protocol/ipc_interface/ai_service.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const int ADAPTER_ID = 1;
+    const int CLIENT_ID = 1;
+    const int SESSION_ID = 2;
+    const int REQUEST_ID = 10;
+    const size_t BATCH_NUM = 3;
+    const int RESULT_LENGTH = 16;
+    const size_t IPC_IO_DATA_SIZE = 512;
+    const size_t IPC_IO_OBJECT_NUM = 0;
+
+    /**
+     * Create the response of request REQUEST_ID + index, its result is RESULT_LENGTH bytes of the index.
+     */
+    IResponse *CreateResponse(SaServerAdapter &adapter, int index, int retCode)
+    {
+        IRequest *request = IRequest::Create();
+        if (request == nullptr) {
+            return nullptr;
+        }
+        request->SetRequestId(REQUEST_ID + index);
+        request->SetTransactionId(adapter.GetTransactionId(SESSION_ID));
+        request->SetClientUid(getuid());
+        IResponse *response = IResponse::Create(request);
+        IRequest::Destroy(request);
+        if (response == nullptr) {
+            return nullptr;
+        }
+        response->SetRetCode(retCode);
+        DataInfo result = {
+            .data = reinterpret_cast<unsigned char *>(malloc(RESULT_LENGTH)),
+            .length = RESULT_LENGTH,
+        };
+        if (result.data != nullptr) {
+            (void)memset_s(result.data, RESULT_LENGTH, index, RESULT_LENGTH);
+        }
+        response->SetResult(result);
+        return response;
+    }
+
+    /**
+     * Read one result record of a callback message and check it is the one of CreateResponse.
+     */
+    void CheckResult(IpcIo &reader, int index, int retCode)
+    {
+        int readRetCode = 0;
+        ReadInt32(&reader, &readRetCode);
+        ASSERT_EQ(readRetCode, retCode);
+        int requestId = 0;
+        ReadInt32(&reader, &requestId);
+        ASSERT_EQ(requestId, REQUEST_ID + index);
+        int sessionId = 0;
+        ReadInt32(&reader, &sessionId);
+        ASSERT_EQ(sessionId, SESSION_ID);
+        DataInfo result = {
+            .data = nullptr,
+            .length = 0,
+        };
+        ASSERT_EQ(UnParcelDataInfo(&reader, &result), RETCODE_SUCCESS);
+        ASSERT_EQ(result.length, RESULT_LENGTH);
+        for (int i = 0; i < RESULT_LENGTH; ++i) {
+            ASSERT_EQ(result.data[i], index);
+        }
+        FreeDataInfo(&result);
+    }
+}
+
+class ClientListenerHandlerTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+/**
+ * @tc.name: TestClientListenerHandler001
+ * @tc.desc: Test a single async result is parcelled into the callback message of a single result.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NL
+ */
+HWTEST_F(ClientListenerHandlerTest, TestClientListenerHandler001, TestSize.Level0)
+{
+    SaServerAdapter adapter(ADAPTER_ID);
+    AsyncProcessWorker worker(nullptr, CLIENT_ID, &adapter);
+    std::vector<IResponse *> responses = {CreateResponse(adapter, 0, RETCODE_SUCCESS)};
+    ASSERT_NE(responses[0], nullptr);
+
+    IpcIo io;
+    char buffer[IPC_IO_DATA_SIZE];
+    IpcIoInit(&io, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    ASSERT_EQ(worker.ParcelResponses(responses, io), static_cast<uint32_t>(ON_ASYNC_PROCESS_CODE));
+    IResponse::Destroy(responses[0]);
+
+    IpcIo reader;
+    IpcIoInit(&reader, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    CheckResult(reader, 0, RETCODE_SUCCESS);
+}
+
+/**
+ * @tc.name: TestClientListenerHandler002
+ * @tc.desc: Test several async results are packed into one batch callback message, in the order they are fetched.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NL
+ */
+HWTEST_F(ClientListenerHandlerTest, TestClientListenerHandler002, TestSize.Level0)
+{
+    SaServerAdapter adapter(ADAPTER_ID);
+    AsyncProcessWorker worker(nullptr, CLIENT_ID, &adapter);
+    std::vector<IResponse *> responses;
+    for (size_t i = 0; i < BATCH_NUM; ++i) {
+        // Failed results are packed the same as successful ones.
+        int retCode = (i == 1) ? RETCODE_FAILURE : RETCODE_SUCCESS;
+        responses.push_back(CreateResponse(adapter, static_cast<int>(i), retCode));
+        ASSERT_NE(responses.back(), nullptr);
+    }
+
+    IpcIo io;
+    char buffer[IPC_IO_DATA_SIZE];
+    IpcIoInit(&io, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    ASSERT_EQ(worker.ParcelResponses(responses, io), static_cast<uint32_t>(ON_ASYNC_PROCESS_BATCH_CODE));
+    for (auto &response : responses) {
+        IResponse::Destroy(response);
+    }
+
+    IpcIo reader;
+    IpcIoInit(&reader, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    int num = 0;
+    ReadInt32(&reader, &num);
+    ASSERT_EQ(num, static_cast<int>(BATCH_NUM));
+    for (size_t i = 0; i < BATCH_NUM; ++i) {
+        CheckResult(reader, static_cast<int>(i), (i == 1) ? RETCODE_FAILURE : RETCODE_SUCCESS);
+    }
+}
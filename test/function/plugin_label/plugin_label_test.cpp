@@ -28,6 +28,7 @@ using namespace testing::ext;
 namespace {
     const std::string AID_DEMO_PLUGIN_SYNC = "cv_card_rectification";
     long long AID_DEMO_PLUGIN_VERSION = 20001001;
+    const std::string AID_PLUGIN_UNREGISTERED = "unregistered_plugin";
 }
 
 class PluginLabelTest : public testing::Test {
@@ -69,4 +70,22 @@ static HWTEST_F(PluginLabelTest, TestPluginLabel001, TestSize.Level0)
     HILOGI("[Test]TestPluginLabel001.");
     std::string libPath;
     TestPluginLabel(AID_DEMO_PLUGIN_SYNC, AID_DEMO_PLUGIN_VERSION, libPath);
+}
+
+/**
+ * @tc.name: TestPluginLabel002
+ * @tc.desc: Test a plugin neither in the plugin config nor built in has no algorithm path.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77ON
+ */
+HWTEST_F(PluginLabelTest, TestPluginLabel002, TestSize.Level0)
+{
+    HILOGI("[Test]TestPluginLabel002.");
+    PluginLabel *pluginLabel = PluginLabel::GetInstance();
+    ASSERT_NE(pluginLabel, nullptr) << "pluginLabel test failed.";
+
+    long long version = 1;
+    std::string libPath;
+    ASSERT_NE(pluginLabel->GetLibPath(AID_PLUGIN_UNREGISTERED, version, libPath), RETCODE_SUCCESS);
+    ASSERT_TRUE(libPath.empty());
 }
\ No newline at end of file
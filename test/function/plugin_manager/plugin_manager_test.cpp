@@ -13,13 +13,21 @@
  * limitations under the License.
  */
 
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <thread>
 #include <unistd.h>
+#include <vector>
 
 #include "gtest/gtest.h"
 
 #include "plugin_manager/include/aie_plugin_info.h"
 #include "plugin_manager/include/i_plugin_manager.h"
+#include "plugin_manager/include/plugin_registry.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
 #include "utils/log/aie_log.h"
 
 using namespace OHOS::AI;
@@ -29,7 +37,19 @@ namespace {
     const std::string AID_DEMO_PLUGIN_SYNC = "sample_plugin_1";
     const std::string AID_DEMO_PLUGIN_ASYNC = "sample_plugin_2";
     const std::string AID_PLUGIN_INVALID = "invalid_plugin";
+    const std::string AID_DEMO_PLUGIN_SLOW_LOAD = "sample_plugin_4";
     const int ALGORITHM_VERSION_VALID = 1;
+    // Time sample_plugin_4 takes to be created.
+    const int SLOW_LOAD_TIME_MS = 500;
+    const int LOAD_START_INTERVAL_MS = 50;
+    const int CONCURRENT_LOADER_NUM = 4;
+    using Clock = std::chrono::steady_clock;
+    const char * const SWAP_CONFIG_PATH = "plugin_manager_swap_test.ini";
+    // Points the label of sample_plugin_1 to another library, as a plugin upgrade would.
+    const char * const SWAP_CONFIG = "[sample_plugin_1+1]\n"
+        "AID         = sample_plugin_1\n"
+        "VersionCode = 1\n"
+        "FullPath    = /usr/lib/libsample_plugin_2.so\n";
 }
 
 class PluginManagerTest : public testing::Test {
@@ -148,3 +168,117 @@ HWTEST_F(PluginManagerTest, testPluginManager006, TestSize.Level0)
     HILOGI("[Test]testPluginManager006.");
     TestPluginManagerUnloadPlugin(AID_PLUGIN_INVALID);
 }
+
+/**
+ * @tc.name: testPluginManager007
+ * @tc.desc: Test concurrent requesters of one plugin share a single load.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77ON
+ */
+HWTEST_F(PluginManagerTest, testPluginManager007, TestSize.Level1)
+{
+    HILOGI("[Test]testPluginManager007.");
+    IPluginManager *pluginManager = IPluginManager::GetPluginManager();
+    ASSERT_NE(pluginManager, nullptr) << "GetPluginManager test failed.";
+
+    std::vector<std::shared_ptr<Plugin>> plugins(CONCURRENT_LOADER_NUM);
+    std::vector<std::thread> loaders;
+    auto start = Clock::now();
+    for (int i = 0; i < CONCURRENT_LOADER_NUM; ++i) {
+        loaders.emplace_back([pluginManager, &plugins, i] {
+            pluginManager->GetPlugin(AID_DEMO_PLUGIN_SLOW_LOAD, ALGORITHM_VERSION_VALID, plugins[i]);
+        });
+    }
+    for (auto &loader : loaders) {
+        loader.join();
+    }
+    auto costMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+
+    for (int i = 0; i < CONCURRENT_LOADER_NUM; ++i) {
+        ASSERT_NE(plugins[i], nullptr) << "pluginManager->GetPlugin test failed.";
+        ASSERT_EQ(plugins[0], plugins[i]) << "The plugin is loaded more than once.";
+    }
+    // One slow load is shared by every requester.
+    ASSERT_LT(costMs, SLOW_LOAD_TIME_MS * 2) << "Requesters of the same plugin did not share the load.";
+
+    pluginManager->UnloadPlugin(AID_DEMO_PLUGIN_SLOW_LOAD, ALGORITHM_VERSION_VALID);
+    pluginManager->Destroy();
+}
+
+/**
+ * @tc.name: testPluginManager008
+ * @tc.desc: Test a slow plugin load does not block loading another plugin.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77ON
+ */
+HWTEST_F(PluginManagerTest, testPluginManager008, TestSize.Level1)
+{
+    HILOGI("[Test]testPluginManager008.");
+    IPluginManager *pluginManager = IPluginManager::GetPluginManager();
+    ASSERT_NE(pluginManager, nullptr) << "GetPluginManager test failed.";
+
+    std::shared_ptr<Plugin> slowPlugin = nullptr;
+    Clock::time_point slowEnd;
+    std::thread slowLoader([pluginManager, &slowPlugin, &slowEnd] {
+        pluginManager->GetPlugin(AID_DEMO_PLUGIN_SLOW_LOAD, ALGORITHM_VERSION_VALID, slowPlugin);
+        slowEnd = Clock::now();
+    });
+
+    // Start the second load while the first one is still in progress.
+    std::this_thread::sleep_for(std::chrono::milliseconds(LOAD_START_INTERVAL_MS));
+    std::shared_ptr<Plugin> fastPlugin = nullptr;
+    pluginManager->GetPlugin(AID_DEMO_PLUGIN_ASYNC, ALGORITHM_VERSION_VALID, fastPlugin);
+    Clock::time_point fastEnd = Clock::now();
+    slowLoader.join();
+
+    ASSERT_NE(slowPlugin, nullptr) << "pluginManager->GetPlugin test failed.";
+    ASSERT_NE(fastPlugin, nullptr) << "pluginManager->GetPlugin test failed.";
+    auto overlapMs = std::chrono::duration_cast<std::chrono::milliseconds>(slowEnd - fastEnd).count();
+    HILOGI("[Test]The second load finished %lld ms before the slow one.", static_cast<long long>(overlapMs));
+    ASSERT_GT(overlapMs, 0) << "Loading another plugin waited for the slow load.";
+
+    pluginManager->UnloadPlugin(AID_DEMO_PLUGIN_SLOW_LOAD, ALGORITHM_VERSION_VALID);
+    pluginManager->UnloadPlugin(AID_DEMO_PLUGIN_ASYNC, ALGORITHM_VERSION_VALID);
+    pluginManager->Destroy();
+}
+
+/**
+ * @tc.name: testPluginManager009
+ * @tc.desc: Test a plugin pointed to a new library is reloaded while the old one stays usable.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77ON
+ */
+HWTEST_F(PluginManagerTest, testPluginManager009, TestSize.Level1)
+{
+    HILOGI("[Test]testPluginManager009.");
+    IPluginManager *pluginManager = IPluginManager::GetPluginManager();
+    ASSERT_NE(pluginManager, nullptr) << "GetPluginManager test failed.";
+    PluginRegistry *pluginRegistry = PluginRegistry::GetInstance();
+    ASSERT_NE(pluginRegistry, nullptr);
+
+    std::shared_ptr<Plugin> oldPlugin = nullptr;
+    pluginManager->GetPlugin(AID_DEMO_PLUGIN_SYNC, ALGORITHM_VERSION_VALID, oldPlugin);
+    ASSERT_NE(oldPlugin, nullptr) << "pluginManager->GetPlugin test failed.";
+    ASSERT_FALSE(oldPlugin->IsOutdated());
+
+    {
+        std::ofstream file(SWAP_CONFIG_PATH, std::ios::trunc);
+        file << SWAP_CONFIG;
+    }
+    ASSERT_EQ(pluginRegistry->Load(SWAP_CONFIG_PATH), RETCODE_SUCCESS);
+    ASSERT_TRUE(oldPlugin->IsOutdated());
+
+    std::shared_ptr<Plugin> newPlugin = nullptr;
+    pluginManager->GetPlugin(AID_DEMO_PLUGIN_SYNC, ALGORITHM_VERSION_VALID, newPlugin);
+    ASSERT_NE(newPlugin, nullptr) << "The new library is not loaded.";
+    ASSERT_NE(newPlugin, oldPlugin) << "The outdated plugin is still handed out.";
+    ASSERT_EQ(strcmp(newPlugin->GetPluginAlgorithm()->GetName(), "SAMPLE_PLUGIN_2"), 0);
+    // Transactions started before the upgrade keep running on the old library.
+    ASSERT_EQ(strcmp(oldPlugin->GetPluginAlgorithm()->GetName(), "SAMPLE_PLUGIN_1"), 0);
+
+    oldPlugin = nullptr;
+    pluginManager->UnloadPlugin(AID_DEMO_PLUGIN_SYNC, ALGORITHM_VERSION_VALID);
+    pluginManager->Destroy();
+    PluginRegistry::ReleaseInstance();
+    (void)remove(SWAP_CONFIG_PATH);
+}
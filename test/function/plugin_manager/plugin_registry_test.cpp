@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+#include "plugin_manager/include/plugin_registry.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "utils/log/aie_log.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const char * const CONFIG_PATH = "plugin_registry_test.ini";
+    const std::string AID_IC = "cv_image_classification";
+    const long long VERSION_IC = 20001001;
+    const std::string AID_KWS = "asr_keyword_spotting";
+    const long long VERSION_KWS = 20001002;
+    const std::string CONFIG_IC = "[base]\n"
+        "supported_boards = ALL\n"
+        "related_sessions = cv_image_classification+20001001\n"
+        "\n"
+        "[cv_image_classification+20001001]\n"
+        "; comment line\n"
+        "AID         = cv_image_classification\n"
+        "VersionCode = 20001001\n"
+        "VersionName = 2.00.01.001\n"
+        "XPU         = NNIE\n"
+        "FullPath    = /usr/lib/libcv_image_classification.so\n"
+        "ChkSum      = ''\n"
+        "MaxBatchSize = 4\n"
+        "WorkerNum   = 1\n";
+    const std::string CONFIG_KWS = "[asr_keyword_spotting+20001002]\n"
+        "AID         = asr_keyword_spotting\n"
+        "VersionCode = 20001002\n"
+        "XPU         = NNIE\n"
+        "FullPath    = /usr/lib/libasr_keyword_spotting.so\n";
+    const size_t MAX_BATCH_SIZE_IC = 4;
+    const size_t WORKER_NUM_IC = 1;
+
+    void WriteConfig(const std::string &content)
+    {
+        std::ofstream file(CONFIG_PATH, std::ios::trunc);
+        file << content;
+    }
+}
+
+class PluginRegistryTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case, later tests find the plugins by the installed config again
+    void TearDown()
+    {
+        PluginRegistry::ReleaseInstance();
+        (void)remove(CONFIG_PATH);
+    };
+};
+
+/**
+ * @tc.name: TestPluginRegistry001
+ * @tc.desc: Test plugins and their capabilities are registered from the ini file.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77ON
+ */
+HWTEST_F(PluginRegistryTest, TestPluginRegistry001, TestSize.Level0)
+{
+    HILOGI("[Test]TestPluginRegistry001.");
+    PluginRegistry *pluginRegistry = PluginRegistry::GetInstance();
+    ASSERT_NE(pluginRegistry, nullptr);
+
+    WriteConfig(CONFIG_IC);
+    ASSERT_EQ(pluginRegistry->Load(CONFIG_PATH), RETCODE_SUCCESS);
+    ASSERT_TRUE(pluginRegistry->IsLoaded());
+
+    PluginInfo info;
+    ASSERT_TRUE(pluginRegistry->Find(AID_IC, VERSION_IC, info));
+    ASSERT_EQ(info.aid, AID_IC);
+    ASSERT_EQ(info.version, VERSION_IC);
+    ASSERT_EQ(info.xpu, "NNIE");
+    ASSERT_EQ(info.fullPath, "/usr/lib/libcv_image_classification.so");
+    ASSERT_EQ(info.maxBatchSize, MAX_BATCH_SIZE_IC);
+    ASSERT_EQ(info.workerNum, WORKER_NUM_IC);
+
+    ASSERT_FALSE(pluginRegistry->Find(AID_IC, VERSION_IC + 1, info)) << "Another version is not registered.";
+    ASSERT_FALSE(pluginRegistry->Find(AID_KWS, VERSION_KWS, info)) << "The plugin is not registered.";
+}
+
+/**
+ * @tc.name: TestPluginRegistry002
+ * @tc.desc: Test rescanning replaces the registered plugins.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77ON
+ */
+HWTEST_F(PluginRegistryTest, TestPluginRegistry002, TestSize.Level0)
+{
+    HILOGI("[Test]TestPluginRegistry002.");
+    PluginRegistry *pluginRegistry = PluginRegistry::GetInstance();
+    ASSERT_NE(pluginRegistry, nullptr);
+
+    WriteConfig(CONFIG_IC);
+    ASSERT_EQ(pluginRegistry->Load(CONFIG_PATH), RETCODE_SUCCESS);
+    WriteConfig(CONFIG_KWS);
+    ASSERT_EQ(pluginRegistry->Rescan(), RETCODE_SUCCESS);
+
+    PluginInfo info;
+    ASSERT_TRUE(pluginRegistry->Find(AID_KWS, VERSION_KWS, info));
+    ASSERT_EQ(info.fullPath, "/usr/lib/libasr_keyword_spotting.so");
+    ASSERT_EQ(info.maxBatchSize, 0U);
+    ASSERT_FALSE(pluginRegistry->Find(AID_IC, VERSION_IC, info)) << "The plugin removed from the file is kept.";
+}
+
+/**
+ * @tc.name: TestPluginRegistry003
+ * @tc.desc: Test SIGHUP makes the next lookup rescan the ini file.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77ON
+ */
+HWTEST_F(PluginRegistryTest, TestPluginRegistry003, TestSize.Level0)
+{
+    HILOGI("[Test]TestPluginRegistry003.");
+    PluginRegistry *pluginRegistry = PluginRegistry::GetInstance();
+    ASSERT_NE(pluginRegistry, nullptr);
+
+    WriteConfig(CONFIG_IC);
+    ASSERT_EQ(pluginRegistry->Load(CONFIG_PATH), RETCODE_SUCCESS);
+    PluginInfo info;
+    ASSERT_FALSE(pluginRegistry->Find(AID_KWS, VERSION_KWS, info));
+
+    PluginRegistry::InstallRescanSignal();
+    WriteConfig(CONFIG_IC + CONFIG_KWS);
+    ASSERT_EQ(raise(SIGHUP), 0);
+    ASSERT_TRUE(pluginRegistry->Find(AID_KWS, VERSION_KWS, info)) << "The new plugin is not registered on SIGHUP.";
+    ASSERT_TRUE(pluginRegistry->Find(AID_IC, VERSION_IC, info));
+}
@@ -13,7 +13,9 @@
  * limitations under the License.
  */
 #include <cstring>
+#include <vector>
 #include "gtest/gtest.h"
+#include "securec.h"
 
 #include <unistd.h>
 #include "client_executor/include/i_aie_client.inl"
@@ -37,6 +39,47 @@ namespace {
     const long long ALGORITHM_VERSION = 1;
     const int OPERATE_ID = 2;
     const int REQUEST_ID = 3;
+    const int BATCH_NUM = 3;
+    const int RESULT_LENGTH = 16;
+    const size_t IPC_IO_DATA_SIZE = 512;
+    const size_t IPC_IO_OBJECT_NUM = 0;
+
+    struct AsyncResult {
+        int sessionId;
+        int requestId;
+        int resultCode;
+        std::vector<unsigned char> result;
+    };
+    std::vector<AsyncResult> g_asyncResults;
+
+    void RecordAsyncResult(int sessionId, const DataInfo &result, int resultCode, int requestId)
+    {
+        std::vector<unsigned char> data;
+        if (result.data != nullptr) {
+            data.assign(result.data, result.data + result.length);
+        }
+        g_asyncResults.push_back({sessionId, requestId, resultCode, data});
+    }
+
+    /**
+     * Write a batch callback message as the server packs it, result i is RESULT_LENGTH bytes of i.
+     */
+    void ParcelAsyncResults(IpcIo &io)
+    {
+        WriteInt32(&io, BATCH_NUM);
+        unsigned char data[RESULT_LENGTH];
+        for (int i = 0; i < BATCH_NUM; ++i) {
+            WriteInt32(&io, (i == 1) ? RETCODE_FAILURE : RETCODE_SUCCESS);
+            WriteInt32(&io, REQUEST_ID + i);
+            WriteInt32(&io, SESSION_ID);
+            (void)memset_s(data, RESULT_LENGTH, i, RESULT_LENGTH);
+            DataInfo result = {
+                .data = data,
+                .length = RESULT_LENGTH,
+            };
+            ParcelDataInfo(&io, &result, getuid());
+        }
+    }
 }
 
 class SaClientTest : public testing::Test {
@@ -107,3 +150,45 @@ static HWTEST_F(SaClientTest, TestSaClient001, TestSize.Level0)
     }
     ASSERT_EQ(retCode, RETCODE_SUCCESS);
 }
+
+/**
+ * @tc.name: TestSaClient002
+ * @tc.desc: Test the async results packed in one callback message are all delivered in order,
+ *           and are still read out without a callback.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+static HWTEST_F(SaClientTest, TestSaClient002, TestSize.Level0)
+{
+    HILOGI("[Test]TestSaClient002.");
+    SaClient *client = SaClient::GetInstance();
+    ASSERT_NE(client, nullptr);
+    MessageOption option;
+    MessageOptionInit(&option);
+
+    g_asyncResults.clear();
+    client->RegisterSaClientCb(RecordAsyncResult);
+    IpcIo io;
+    char buffer[IPC_IO_DATA_SIZE];
+    IpcIoInit(&io, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    ParcelAsyncResults(io);
+    IpcIo reader;
+    IpcIoInit(&reader, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    ASSERT_EQ(AsyncCallback(ON_ASYNC_PROCESS_BATCH_CODE, &reader, nullptr, option), RETCODE_SUCCESS);
+
+    ASSERT_EQ(g_asyncResults.size(), static_cast<size_t>(BATCH_NUM));
+    for (int i = 0; i < BATCH_NUM; ++i) {
+        ASSERT_EQ(g_asyncResults[i].sessionId, SESSION_ID);
+        ASSERT_EQ(g_asyncResults[i].requestId, REQUEST_ID + i);
+        ASSERT_EQ(g_asyncResults[i].resultCode, (i == 1) ? RETCODE_FAILURE : RETCODE_SUCCESS);
+        ASSERT_EQ(g_asyncResults[i].result, std::vector<unsigned char>(RESULT_LENGTH, i));
+    }
+
+    g_asyncResults.clear();
+    client->UnRegisterSaClientCb();
+    IpcIoInit(&io, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    ParcelAsyncResults(io);
+    IpcIoInit(&reader, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    ASSERT_EQ(AsyncCallback(ON_ASYNC_PROCESS_BATCH_CODE, &reader, nullptr, option), RETCODE_FAILURE);
+    ASSERT_TRUE(g_asyncResults.empty());
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "protocol/data_channel/include/i_request.h"
+#include "server_executor/include/client_qos.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const size_t QUEUE_CAPACITY = 8;
+    const size_t DEFAULT_DEPTH_LIMIT = QUEUE_CAPACITY / 2;
+    const uid_t FLOODING_UID = 10001;
+    const uid_t QUIET_UID = 10002;
+    const uid_t CONFIGURED_UID = 10003;
+    const uid_t OTHER_CONFIGURED_UID = 10004;
+    const size_t CONFIGURED_WEIGHT = 4;
+    const size_t CONFIGURED_DEPTH_LIMIT = 2;
+
+    IRequest *CreateRequest(uid_t clientUid, long long transactionId)
+    {
+        IRequest *request = IRequest::Create();
+        if (request != nullptr) {
+            request->SetClientUid(clientUid);
+            request->SetTransactionId(transactionId);
+        }
+        return request;
+    }
+}
+
+class ClientQosTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown()
+    {
+        ClientQosConfig::ReleaseInstance();
+    };
+};
+
+/**
+ * @tc.name: TestClientQuota001
+ * @tc.desc: Test the depth limit is shared by all transactions of a client, other clients are not affected.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(ClientQosTest, TestClientQuota001, TestSize.Level0)
+{
+    ClientQuota quota;
+    IRequest *requests[DEFAULT_DEPTH_LIMIT] = {nullptr};
+    for (size_t i = 0; i < DEFAULT_DEPTH_LIMIT; ++i) {
+        // Each request opens a new transaction, which must not earn the client a new quota.
+        requests[i] = CreateRequest(FLOODING_UID, static_cast<long long>(i));
+        ASSERT_NE(requests[i], nullptr);
+        ASSERT_TRUE(quota.Acquire(requests[i], QUEUE_CAPACITY));
+    }
+    IRequest *floodingRequest = CreateRequest(FLOODING_UID, static_cast<long long>(DEFAULT_DEPTH_LIMIT));
+    ASSERT_NE(floodingRequest, nullptr);
+    ASSERT_FALSE(quota.Acquire(floodingRequest, QUEUE_CAPACITY));
+
+    IRequest *quietRequest = CreateRequest(QUIET_UID, 0);
+    ASSERT_NE(quietRequest, nullptr);
+    ASSERT_TRUE(quota.Acquire(quietRequest, QUEUE_CAPACITY));
+
+    quota.Release(FLOODING_UID);
+    ASSERT_TRUE(quota.Acquire(floodingRequest, QUEUE_CAPACITY));
+
+    IRequest::Destroy(floodingRequest);
+    IRequest::Destroy(quietRequest);
+    for (size_t i = 0; i < DEFAULT_DEPTH_LIMIT; ++i) {
+        IRequest::Destroy(requests[i]);
+    }
+}
+
+/**
+ * @tc.name: TestClientQosConfig001
+ * @tc.desc: Test weights and depth limits are loaded from a config list and invalid entries are skipped.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(ClientQosTest, TestClientQosConfig001, TestSize.Level0)
+{
+    ClientQosConfig *config = ClientQosConfig::GetInstance();
+    ASSERT_NE(config, nullptr);
+
+    size_t loadedNum = config->LoadConfig(" 10003:4:2, bad, 10004:0:0,10005:1 ,");
+    ASSERT_EQ(loadedNum, 2U);
+    ASSERT_EQ(config->GetWeight(CONFIGURED_UID), CONFIGURED_WEIGHT);
+    ASSERT_EQ(config->GetDepthLimit(CONFIGURED_UID, QUEUE_CAPACITY), CONFIGURED_DEPTH_LIMIT);
+    ASSERT_EQ(config->GetWeight(OTHER_CONFIGURED_UID), 1U);
+    ASSERT_EQ(config->GetDepthLimit(OTHER_CONFIGURED_UID, QUEUE_CAPACITY), DEFAULT_DEPTH_LIMIT);
+    ASSERT_EQ(config->GetWeight(QUIET_UID), 1U);
+
+    ClientQuota quota;
+    IRequest *request = CreateRequest(CONFIGURED_UID, 0);
+    ASSERT_NE(request, nullptr);
+    for (size_t i = 0; i < CONFIGURED_DEPTH_LIMIT; ++i) {
+        ASSERT_TRUE(quota.Acquire(request, QUEUE_CAPACITY));
+    }
+    ASSERT_FALSE(quota.Acquire(request, QUEUE_CAPACITY));
+    IRequest::Destroy(request);
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "protocol/plugin_config/aie_algorithm_type.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "protocol/struct_definition/aie_info_define.h"
+#include "server_executor/include/engine_manager.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const long long ALGORITHM_VERSION_VALID = 1;
+    const long long LONG_IDLE_TTL_MS = 10000;
+    const long long SHORT_IDLE_TTL_MS = 50;
+    const int EXPIRE_WAIT_MS = 100;
+    const size_t IDLE_MAX_NUM = 2;
+    const size_t SINGLE_IDLE_MAX_NUM = 1;
+
+    struct IdleEngineStats {
+        size_t hitNum;
+        size_t missNum;
+        size_t idleNum;
+    };
+
+    void StartAndStopEngine(EngineManager &engineManager, long long transactionId, int algorithmType)
+    {
+        AlgorithmInfo algoInfo {};
+        algoInfo.algorithmType = algorithmType;
+        algoInfo.algorithmVersion = ALGORITHM_VERSION_VALID;
+        DataInfo inputInfo = {nullptr, 0};
+        DataInfo outputInfo = {nullptr, 0};
+        ASSERT_EQ(engineManager.StartEngine(transactionId, algoInfo, inputInfo, outputInfo), RETCODE_SUCCESS);
+        ASSERT_EQ(engineManager.StopEngine(transactionId, outputInfo), RETCODE_SUCCESS);
+        free(outputInfo.data);
+    }
+
+    IdleEngineStats GetStats(EngineManager &engineManager)
+    {
+        IdleEngineStats stats = {0, 0, 0};
+        engineManager.GetIdleEngineStats(stats.hitNum, stats.missNum, stats.idleNum);
+        return stats;
+    }
+}
+
+class EngineManagerTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+/**
+ * @tc.name: TestEngineManager001
+ * @tc.desc: Test an engine left by its last client is reused by the next one, without loading the plugin.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(EngineManagerTest, TestEngineManager001, TestSize.Level0)
+{
+    EngineManager engineManager(LONG_IDLE_TTL_MS, IDLE_MAX_NUM);
+    ASSERT_EQ(engineManager.Initialize(), RETCODE_SUCCESS);
+
+    StartAndStopEngine(engineManager, 1, ALGORITHM_TYPE_SAMPLE_PLUGIN_1);
+    IdleEngineStats stats = GetStats(engineManager);
+    ASSERT_EQ(stats.hitNum, 0U);
+    ASSERT_EQ(stats.missNum, 1U);
+    ASSERT_EQ(stats.idleNum, 1U);
+
+    StartAndStopEngine(engineManager, 2, ALGORITHM_TYPE_SAMPLE_PLUGIN_1);
+    stats = GetStats(engineManager);
+    ASSERT_EQ(stats.hitNum, 1U);
+    ASSERT_EQ(stats.missNum, 1U);
+    ASSERT_EQ(stats.idleNum, 1U);
+}
+
+/**
+ * @tc.name: TestEngineManager002
+ * @tc.desc: Test the least recently used idle engine is unloaded when there are too many idle engines.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(EngineManagerTest, TestEngineManager002, TestSize.Level0)
+{
+    EngineManager engineManager(LONG_IDLE_TTL_MS, SINGLE_IDLE_MAX_NUM);
+    ASSERT_EQ(engineManager.Initialize(), RETCODE_SUCCESS);
+
+    StartAndStopEngine(engineManager, 1, ALGORITHM_TYPE_SAMPLE_PLUGIN_1);
+    StartAndStopEngine(engineManager, 2, ALGORITHM_TYPE_SAMPLE_PLUGIN_2);
+    IdleEngineStats stats = GetStats(engineManager);
+    ASSERT_EQ(stats.missNum, 2U);
+    ASSERT_EQ(stats.idleNum, SINGLE_IDLE_MAX_NUM);
+
+    // The most recent idle engine is kept, the older one has been unloaded.
+    StartAndStopEngine(engineManager, 3, ALGORITHM_TYPE_SAMPLE_PLUGIN_2);
+    stats = GetStats(engineManager);
+    ASSERT_EQ(stats.hitNum, 1U);
+    ASSERT_EQ(stats.missNum, 2U);
+
+    StartAndStopEngine(engineManager, 4, ALGORITHM_TYPE_SAMPLE_PLUGIN_1);
+    stats = GetStats(engineManager);
+    ASSERT_EQ(stats.hitNum, 1U);
+    ASSERT_EQ(stats.missNum, 3U);
+    ASSERT_EQ(stats.idleNum, SINGLE_IDLE_MAX_NUM);
+}
+
+/**
+ * @tc.name: TestEngineManager003
+ * @tc.desc: Test an idle engine is unloaded once its time to live has passed, and at once with a TTL of 0.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(EngineManagerTest, TestEngineManager003, TestSize.Level0)
+{
+    {
+        EngineManager engineManager(SHORT_IDLE_TTL_MS, IDLE_MAX_NUM);
+        ASSERT_EQ(engineManager.Initialize(), RETCODE_SUCCESS);
+
+        StartAndStopEngine(engineManager, 1, ALGORITHM_TYPE_SAMPLE_PLUGIN_1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(EXPIRE_WAIT_MS));
+        // Expired engines are trimmed when the next engine is acquired.
+        StartAndStopEngine(engineManager, 2, ALGORITHM_TYPE_SAMPLE_PLUGIN_2);
+        IdleEngineStats stats = GetStats(engineManager);
+        ASSERT_EQ(stats.missNum, 2U);
+        ASSERT_EQ(stats.idleNum, 1U);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(EXPIRE_WAIT_MS));
+        StartAndStopEngine(engineManager, 3, ALGORITHM_TYPE_SAMPLE_PLUGIN_1);
+        stats = GetStats(engineManager);
+        ASSERT_EQ(stats.hitNum, 0U);
+        ASSERT_EQ(stats.missNum, 3U);
+    }
+
+    EngineManager engineManager(0, IDLE_MAX_NUM);
+    ASSERT_EQ(engineManager.Initialize(), RETCODE_SUCCESS);
+    StartAndStopEngine(engineManager, 1, ALGORITHM_TYPE_SAMPLE_PLUGIN_1);
+    IdleEngineStats stats = GetStats(engineManager);
+    ASSERT_EQ(stats.missNum, 1U);
+    ASSERT_EQ(stats.idleNum, 0U);
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+
+#include "protocol/plugin_config/aie_algorithm_type.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "protocol/struct_definition/aie_info_define.h"
+#include "server_executor/include/engine_manager.h"
+#include "server_executor/include/engine_preloader.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const long long ALGORITHM_VERSION_VALID = 1;
+    const long long TRANSACTION_ID = 1;
+    // Valid labels of existing and missing plugins, mixed with malformed ones which are skipped.
+    const char * const PRELOAD_LIST =
+        " sample_plugin_3+1, invalid_label,no_version+ ,,unknown_plugin+1,sample_plugin_1+1 ";
+    const size_t VALID_LABEL_NUM = 3;
+    const size_t LOADED_PLUGIN_NUM = 2;
+    // Option of sample_plugin_3 returning the number of prepare calls and of handles not released yet.
+    const int OPTION_GET_HANDLE_STATS = 1001;
+
+    size_t PreloadAll(EnginePreloader &preloader)
+    {
+        size_t actionNum = 1;
+        while (preloader.OneAction()) {
+            ++actionNum;
+        }
+        return actionNum;
+    }
+
+    void CheckHandleStats(EngineManager &engineManager, int expectedPrepareNum, int expectedHandleNum)
+    {
+        AlgorithmInfo algoInfo {};
+        algoInfo.algorithmType = ALGORITHM_TYPE_SAMPLE_PLUGIN_3;
+        algoInfo.algorithmVersion = ALGORITHM_VERSION_VALID;
+        DataInfo inputInfo = {nullptr, 0};
+        DataInfo handleInfo = {nullptr, 0};
+        ASSERT_EQ(engineManager.StartEngine(TRANSACTION_ID, algoInfo, inputInfo, handleInfo), RETCODE_SUCCESS);
+
+        DataInfo statsInfo = {nullptr, 0};
+        ASSERT_EQ(engineManager.GetOption(TRANSACTION_ID, OPTION_GET_HANDLE_STATS, inputInfo, statsInfo),
+            RETCODE_SUCCESS);
+        ASSERT_NE(statsInfo.data, nullptr);
+        const int *stats = reinterpret_cast<const int *>(statsInfo.data);
+        EXPECT_EQ(stats[0], expectedPrepareNum);
+        EXPECT_EQ(stats[1], expectedHandleNum);
+        free(statsInfo.data);
+
+        // The client releases with its own prepare output, as it would through the SDK.
+        ASSERT_EQ(engineManager.StopEngine(TRANSACTION_ID, handleInfo), RETCODE_SUCCESS);
+        free(handleInfo.data);
+    }
+}
+
+class EnginePreloaderTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+/**
+ * @tc.name: TestEnginePreloader001
+ * @tc.desc: Test valid labels are preloaded one per action, and a missing plugin does not stop the others.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(EnginePreloaderTest, TestEnginePreloader001, TestSize.Level0)
+{
+    EngineManager engineManager;
+    ASSERT_EQ(engineManager.Initialize(), RETCODE_SUCCESS);
+
+    EnginePreloader emptyPreloader(engineManager, " , ", false);
+    ASSERT_TRUE(emptyPreloader.IsEmpty());
+
+    EnginePreloader preloader(engineManager, PRELOAD_LIST, false);
+    ASSERT_FALSE(preloader.IsEmpty());
+    ASSERT_EQ(PreloadAll(preloader), VALID_LABEL_NUM);
+
+    size_t hitNum = 0;
+    size_t missNum = 0;
+    size_t idleNum = 0;
+    engineManager.GetIdleEngineStats(hitNum, missNum, idleNum);
+    ASSERT_EQ(missNum, LOADED_PLUGIN_NUM);
+
+    // The first client finds the engine loaded, without preparing it the plugin sees the client prepare only.
+    CheckHandleStats(engineManager, 1, 1);
+    engineManager.GetIdleEngineStats(hitNum, missNum, idleNum);
+    ASSERT_EQ(missNum, LOADED_PLUGIN_NUM);
+}
+
+/**
+ * @tc.name: TestEnginePreloader002
+ * @tc.desc: Test the preload prepare output is taken back by the preload release, leaving no handle behind.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(EnginePreloaderTest, TestEnginePreloader002, TestSize.Level0)
+{
+    EngineManager engineManager;
+    ASSERT_EQ(engineManager.Initialize(), RETCODE_SUCCESS);
+
+    EnginePreloader preloader(engineManager, PRELOAD_LIST, true);
+    ASSERT_EQ(PreloadAll(preloader), VALID_LABEL_NUM);
+
+    // The preload prepared the plugin once and released its handle, only the client handle is alive.
+    CheckHandleStats(engineManager, 2, 1);
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "protocol/data_channel/include/i_request.h"
+#include "server_executor/include/client_qos.h"
+#include "server_executor/include/fair_queue.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const uid_t HEAVY_UID = 10001;
+    const uid_t LIGHT_UID = 10002;
+    const long long HEAVY_TRANSACTION_ID = 1;
+    const long long LIGHT_TRANSACTION_ID = 2;
+    const size_t HEAVY_WEIGHT = 3;
+    const size_t TASK_NUM_PER_CLIENT = 6;
+    const size_t ROUND_TASK_NUM = HEAVY_WEIGHT + 1;
+
+    void PushTasks(FairQueue &queue, uid_t clientUid, long long transactionId, size_t taskNum)
+    {
+        for (size_t i = 0; i < taskNum; ++i) {
+            IRequest *request = IRequest::Create();
+            ASSERT_NE(request, nullptr);
+            request->SetClientUid(clientUid);
+            request->SetTransactionId(transactionId);
+            request->SetRequestId(static_cast<int>(i));
+            queue.Push(Task(nullptr, request, nullptr));
+        }
+    }
+
+    void DestroyTasks(Task *tasks, size_t taskNum)
+    {
+        for (size_t i = 0; i < taskNum; ++i) {
+            IRequest::Destroy(tasks[i].request);
+        }
+    }
+}
+
+class FairQueueTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown()
+    {
+        ClientQosConfig::ReleaseInstance();
+    };
+};
+
+/**
+ * @tc.name: TestFairQueue001
+ * @tc.desc: Test a transaction flooding the queue does not starve a transaction queued after it.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(FairQueueTest, TestFairQueue001, TestSize.Level0)
+{
+    FairQueue queue;
+    PushTasks(queue, HEAVY_UID, HEAVY_TRANSACTION_ID, TASK_NUM_PER_CLIENT);
+    PushTasks(queue, LIGHT_UID, LIGHT_TRANSACTION_ID, TASK_NUM_PER_CLIENT);
+    ASSERT_EQ(queue.Count(), TASK_NUM_PER_CLIENT * 2);
+
+    std::vector<Task> tasks(TASK_NUM_PER_CLIENT * 2);
+    size_t popNum = queue.PopBulk(tasks.data(), tasks.size());
+    ASSERT_EQ(popNum, tasks.size());
+    ASSERT_TRUE(queue.IsEmpty());
+    for (size_t i = 0; i < popNum; ++i) {
+        // Weight 1 each, the transactions take turns and keep their own order.
+        long long expectedId = (i % 2 == 0) ? HEAVY_TRANSACTION_ID : LIGHT_TRANSACTION_ID;
+        ASSERT_EQ(tasks[i].request->GetTransactionId(), expectedId);
+        ASSERT_EQ(tasks[i].request->GetRequestId(), static_cast<int>(i / 2));
+    }
+    DestroyTasks(tasks.data(), popNum);
+}
+
+/**
+ * @tc.name: TestFairQueue002
+ * @tc.desc: Test a client is served in proportion to its weight, and the quantum carries over between calls.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(FairQueueTest, TestFairQueue002, TestSize.Level0)
+{
+    ClientQosConfig *config = ClientQosConfig::GetInstance();
+    ASSERT_NE(config, nullptr);
+    config->SetWeight(HEAVY_UID, HEAVY_WEIGHT);
+
+    FairQueue queue;
+    PushTasks(queue, HEAVY_UID, HEAVY_TRANSACTION_ID, TASK_NUM_PER_CLIENT);
+    PushTasks(queue, LIGHT_UID, LIGHT_TRANSACTION_ID, TASK_NUM_PER_CLIENT);
+
+    // Taken one by one, each call resumes the quantum of the transaction being served.
+    std::vector<Task> tasks(ROUND_TASK_NUM);
+    for (size_t i = 0; i < ROUND_TASK_NUM; ++i) {
+        ASSERT_EQ(queue.PopBulk(&tasks[i], 1), 1U);
+    }
+    for (size_t i = 0; i < HEAVY_WEIGHT; ++i) {
+        ASSERT_EQ(tasks[i].request->GetTransactionId(), HEAVY_TRANSACTION_ID);
+    }
+    ASSERT_EQ(tasks[HEAVY_WEIGHT].request->GetTransactionId(), LIGHT_TRANSACTION_ID);
+    DestroyTasks(tasks.data(), ROUND_TASK_NUM);
+
+    std::vector<Task> restTasks(queue.Count());
+    size_t popNum = queue.PopBulk(restTasks.data(), restTasks.size());
+    ASSERT_EQ(popNum, restTasks.size());
+    ASSERT_TRUE(queue.IsEmpty());
+    DestroyTasks(restTasks.data(), popNum);
+}
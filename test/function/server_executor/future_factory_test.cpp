@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "protocol/data_channel/include/i_request.h"
+#include "protocol/data_channel/include/i_response.h"
+#include "protocol/data_channel/include/request.h"
+#include "protocol/data_channel/include/response.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "server_executor/include/future_factory.h"
+#include "server_executor/include/i_future_listener.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const long long TRANSACTION_ID = 1;
+    const long long UNKNOWN_TRANSACTION_ID = 2;
+
+    class TestFutureListener : public IFutureListener {
+    public:
+        explicit TestFutureListener(long long &replySequenceId) : replySequenceId_(replySequenceId)
+        {
+        }
+
+        ~TestFutureListener() override = default;
+
+        void OnReply(const IFuture *future) override
+        {
+            IResponse *response = future->GetResponse(0);
+            replySequenceId_ = reinterpret_cast<Response *>(response)->GetInnerSequenceId();
+            IResponse::Destroy(response);
+        }
+
+    private:
+        long long &replySequenceId_;
+    };
+
+    IRequest *CreateRequest(long long transactionId)
+    {
+        IRequest *request = IRequest::Create();
+        if (request != nullptr) {
+            request->SetTransactionId(transactionId);
+        }
+        return request;
+    }
+
+    long long GetSequenceId(IRequest *request)
+    {
+        return reinterpret_cast<Request *>(request)->GetInnerSequenceId();
+    }
+}
+
+class FutureFactoryTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown()
+    {
+        FutureFactory::ReleaseInstance();
+    };
+};
+
+/**
+ * @tc.name: TestFutureFactory001
+ * @tc.desc: Test the slot table holds up to the max number of futures, a released slot is reused
+ *           under a new sequence ID and a stale sequence ID does not release it.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(FutureFactoryTest, TestFutureFactory001, TestSize.Level0)
+{
+    FutureFactory *futureFactory = FutureFactory::GetInstance();
+    ASSERT_NE(futureFactory, nullptr);
+
+    std::vector<IRequest *> requests;
+    for (size_t i = 0; i < AIE_MAX_FUTURE_NUM; ++i) {
+        IRequest *request = CreateRequest(TRANSACTION_ID);
+        ASSERT_NE(request, nullptr);
+        requests.push_back(request);
+        ASSERT_EQ(futureFactory->CreateFuture(request), RETCODE_SUCCESS);
+        if (i > 0) {
+            ASSERT_GT(GetSequenceId(request), GetSequenceId(requests[i - 1]));
+        }
+    }
+    IRequest *extraRequest = CreateRequest(TRANSACTION_ID);
+    ASSERT_NE(extraRequest, nullptr);
+    ASSERT_NE(futureFactory->CreateFuture(extraRequest), RETCODE_SUCCESS);
+
+    long long releasedSequenceId = GetSequenceId(requests[0]);
+    futureFactory->Release(releasedSequenceId);
+    ASSERT_EQ(futureFactory->CreateFuture(extraRequest), RETCODE_SUCCESS);
+    long long reusedSequenceId = GetSequenceId(extraRequest);
+    ASSERT_NE(reusedSequenceId, releasedSequenceId);
+    ASSERT_EQ(reusedSequenceId % AIE_MAX_FUTURE_NUM, releasedSequenceId % AIE_MAX_FUTURE_NUM);
+
+    // The stale ID maps to the same slot, the future living there now must survive it.
+    futureFactory->Release(releasedSequenceId);
+    ASSERT_NE(futureFactory->CreateFuture(requests[0]), RETCODE_SUCCESS);
+
+    futureFactory->Release(reusedSequenceId);
+    IRequest::Destroy(extraRequest);
+    for (IRequest *request : requests) {
+        futureFactory->Release(GetSequenceId(request));
+        IRequest::Destroy(request);
+    }
+}
+
+/**
+ * @tc.name: TestFutureFactory002
+ * @tc.desc: Test a response reaches the listener of its transaction once, and fails once the listener is gone.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(FutureFactoryTest, TestFutureFactory002, TestSize.Level0)
+{
+    FutureFactory *futureFactory = FutureFactory::GetInstance();
+    ASSERT_NE(futureFactory, nullptr);
+    long long replySequenceId = 0;
+    futureFactory->RegisterListener(new TestFutureListener(replySequenceId), TRANSACTION_ID);
+
+    IRequest *request = CreateRequest(TRANSACTION_ID);
+    ASSERT_NE(request, nullptr);
+    ASSERT_EQ(futureFactory->CreateFuture(request), RETCODE_SUCCESS);
+    IResponse *response = IResponse::Create(request);
+    ASSERT_NE(response, nullptr);
+    ASSERT_EQ(futureFactory->ProcessResponse(ON_PLUGIN_SUCCEED, response), RETCODE_SUCCESS);
+    ASSERT_EQ(replySequenceId, GetSequenceId(request));
+
+    // The future is taken by the first response, a duplicate finds nothing to answer.
+    IResponse *duplicateResponse = IResponse::Create(request);
+    ASSERT_NE(duplicateResponse, nullptr);
+    ASSERT_NE(futureFactory->ProcessResponse(ON_PLUGIN_SUCCEED, duplicateResponse), RETCODE_SUCCESS);
+    IResponse::Destroy(duplicateResponse);
+
+    IRequest *unknownRequest = CreateRequest(UNKNOWN_TRANSACTION_ID);
+    ASSERT_NE(unknownRequest, nullptr);
+    ASSERT_EQ(futureFactory->CreateFuture(unknownRequest), RETCODE_SUCCESS);
+    IResponse *unknownResponse = IResponse::Create(unknownRequest);
+    ASSERT_NE(unknownResponse, nullptr);
+    ASSERT_EQ(futureFactory->ProcessResponse(ON_PLUGIN_FAIL, unknownResponse), RETCODE_NO_LISTENER_FOUND);
+
+    futureFactory->UnregisterListener(TRANSACTION_ID);
+    ASSERT_EQ(futureFactory->CreateFuture(request), RETCODE_SUCCESS);
+    IResponse *lateResponse = IResponse::Create(request);
+    ASSERT_NE(lateResponse, nullptr);
+    ASSERT_EQ(futureFactory->ProcessResponse(ON_PLUGIN_SUCCEED, lateResponse), RETCODE_NO_LISTENER_FOUND);
+
+    IRequest::Destroy(unknownRequest);
+    IRequest::Destroy(request);
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "server_executor/include/i_handler.h"
+#include "server_executor/include/shared_executor.h"
+#include "utils/log/aie_log.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const size_t THREAD_NUM = 4;
+    const long long TRANSACTION_NUM = 8;
+    const int REQUEST_NUM = 200;
+    const int WAIT_INTERVAL_MS = 1;
+    const int WAIT_TIMES = 5000;
+    // The blocking transaction is kept busy until the others are finished.
+    const long long BLOCKING_TRANSACTION_ID = 0;
+
+    class TestHandler : public IHandler {
+    public:
+        explicit TestHandler(bool isReentrant) : isReentrant_(isReentrant), activeNum_(0), maxActiveNum_(0),
+            isBlocking_(false)
+        {
+        }
+
+        ~TestHandler() override = default;
+
+        int Process(const Task &task) override
+        {
+            int activeNum = ++activeNum_;
+            int maxActiveNum = maxActiveNum_;
+            while (activeNum > maxActiveNum && !maxActiveNum_.compare_exchange_weak(maxActiveNum, activeNum)) {
+            }
+
+            long long transactionId = task.request->GetTransactionId();
+            while (isBlocking_ && transactionId == BLOCKING_TRANSACTION_ID) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_INTERVAL_MS));
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                requestIds_[transactionId].push_back(task.request->GetRequestId());
+            }
+            --activeNum_;
+
+            IRequest *request = task.request;
+            IRequest::Destroy(request);
+            return RETCODE_SUCCESS;
+        }
+
+        void Reject(const Task &task, int retCode) override
+        {
+            IRequest *request = task.request;
+            IRequest::Destroy(request);
+        }
+
+        bool IsReentrant() const override
+        {
+            return isReentrant_;
+        }
+
+        void SetPluginAlgorithm(IPlugin *pluginAlgorithm) override
+        {
+        }
+
+        void SetBlocking(bool isBlocking)
+        {
+            isBlocking_ = isBlocking;
+        }
+
+        int GetMaxActiveNum() const
+        {
+            return maxActiveNum_;
+        }
+
+        size_t GetProcessedNum(long long transactionId)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return requestIds_[transactionId].size();
+        }
+
+        bool IsInOrder()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &item : requestIds_) {
+                for (size_t i = 1; i < item.second.size(); ++i) {
+                    if (item.second[i] < item.second[i - 1]) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+    private:
+        bool isReentrant_;
+        std::atomic<int> activeNum_;
+        std::atomic<int> maxActiveNum_;
+        std::atomic<bool> isBlocking_;
+        std::mutex mutex_;
+        std::map<long long, std::vector<int>> requestIds_;
+    };
+
+    int SubmitRequest(SharedExecutor *executor, TestHandler &handler, long long transactionId, int requestId)
+    {
+        IRequest *request = IRequest::Create();
+        if (request == nullptr) {
+            return RETCODE_OUT_OF_MEMORY;
+        }
+        request->SetTransactionId(transactionId);
+        request->SetRequestId(requestId);
+        int retCode = executor->Submit(Task(&handler, request, nullptr));
+        if (retCode != RETCODE_SUCCESS) {
+            IRequest::Destroy(request);
+        }
+        return retCode;
+    }
+
+    bool WaitFinished(SharedExecutor *executor, TestHandler &handler)
+    {
+        for (int i = 0; i < WAIT_TIMES && executor->Count(&handler) > 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_INTERVAL_MS));
+        }
+        return executor->Count(&handler) == 0;
+    }
+}
+
+class SharedExecutorTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp()
+    {
+        executor_ = SharedExecutor::GetInstance();
+        ASSERT_NE(executor_, nullptr);
+        ASSERT_EQ(executor_->Initialize(THREAD_NUM), RETCODE_SUCCESS);
+    };
+
+    // TearDown:Execute after each test case
+    void TearDown()
+    {
+        SharedExecutor::ReleaseInstance();
+    };
+
+protected:
+    SharedExecutor *executor_ = nullptr;
+};
+
+/**
+ * @tc.name: TestSharedExecutor001
+ * @tc.desc: Test tasks of one transaction of a reentrant handler run in submission order,
+ *           while different transactions run in parallel.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(SharedExecutorTest, TestSharedExecutor001, TestSize.Level0)
+{
+    TestHandler handler(true);
+    for (int i = 0; i < REQUEST_NUM; ++i) {
+        for (long long transactionId = 0; transactionId < TRANSACTION_NUM; ++transactionId) {
+            ASSERT_EQ(SubmitRequest(executor_, handler, transactionId, i), RETCODE_SUCCESS);
+        }
+    }
+    ASSERT_TRUE(WaitFinished(executor_, handler));
+
+    for (long long transactionId = 0; transactionId < TRANSACTION_NUM; ++transactionId) {
+        ASSERT_EQ(handler.GetProcessedNum(transactionId), static_cast<size_t>(REQUEST_NUM));
+    }
+    ASSERT_TRUE(handler.IsInOrder());
+    HILOGI("[Test]TestSharedExecutor001 at most %d tasks run at once.", handler.GetMaxActiveNum());
+}
+
+/**
+ * @tc.name: TestSharedExecutor002
+ * @tc.desc: Test all tasks of a non-reentrant handler run one by one in submission order.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(SharedExecutorTest, TestSharedExecutor002, TestSize.Level0)
+{
+    TestHandler handler(false);
+    for (int i = 0; i < REQUEST_NUM; ++i) {
+        for (long long transactionId = 0; transactionId < TRANSACTION_NUM; ++transactionId) {
+            ASSERT_EQ(SubmitRequest(executor_, handler, transactionId, i), RETCODE_SUCCESS);
+        }
+    }
+    ASSERT_TRUE(WaitFinished(executor_, handler));
+
+    for (long long transactionId = 0; transactionId < TRANSACTION_NUM; ++transactionId) {
+        ASSERT_EQ(handler.GetProcessedNum(transactionId), static_cast<size_t>(REQUEST_NUM));
+    }
+    ASSERT_TRUE(handler.IsInOrder());
+    ASSERT_EQ(handler.GetMaxActiveNum(), 1);
+}
+
+/**
+ * @tc.name: TestSharedExecutor003
+ * @tc.desc: Test strands queued on a worker busy with a long task are stolen and run by the other workers.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(SharedExecutorTest, TestSharedExecutor003, TestSize.Level0)
+{
+    TestHandler handler(true);
+    handler.SetBlocking(true);
+    ASSERT_EQ(SubmitRequest(executor_, handler, BLOCKING_TRANSACTION_ID, 0), RETCODE_SUCCESS);
+
+    // Strands are spread over the inboxes of all workers, including the blocked one.
+    for (int i = 0; i < REQUEST_NUM; ++i) {
+        for (long long transactionId = 1; transactionId < TRANSACTION_NUM; ++transactionId) {
+            ASSERT_EQ(SubmitRequest(executor_, handler, transactionId, i), RETCODE_SUCCESS);
+        }
+    }
+    for (int i = 0; i < WAIT_TIMES && executor_->Count(&handler) > 1; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_INTERVAL_MS));
+    }
+    ASSERT_EQ(executor_->Count(&handler), 1U);
+    ASSERT_EQ(handler.GetProcessedNum(BLOCKING_TRANSACTION_ID), 0U);
+
+    handler.SetBlocking(false);
+    ASSERT_TRUE(WaitFinished(executor_, handler));
+    ASSERT_EQ(handler.GetProcessedNum(BLOCKING_TRANSACTION_ID), 1U);
+    ASSERT_TRUE(handler.IsInOrder());
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "platform/queuepool/queue.h"
+#include "platform/semaphore/include/simple_event_notifier.h"
+#include "platform/time/include/time.h"
+#include "plugin/i_plugin.h"
+#include "protocol/data_channel/include/i_request.h"
+#include "protocol/data_channel/include/i_response.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "server_executor/include/sync_msg_handler.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    // A queue of 2 leaves each client a depth limit of 1.
+    const size_t QUEUE_CAPACITY = 2;
+    const uid_t BUSY_UID = 10001;
+    const uid_t IDLE_UID = 10002;
+    const long long PAST_DEADLINE_MS = 1;
+
+    class CountingPlugin : public IPlugin {
+    public:
+        CountingPlugin() = default;
+        ~CountingPlugin() override = default;
+
+        const long long GetVersion() const override
+        {
+            return 0;
+        }
+
+        const char *GetName() const override
+        {
+            return "CountingPlugin";
+        }
+
+        const char *GetInferMode() const override
+        {
+            return "SYNC";
+        }
+
+        int SyncProcess(IRequest *request, IResponse *&response) override
+        {
+            ++processNum;
+            response = IResponse::Create(request);
+            return (response == nullptr) ? RETCODE_OUT_OF_MEMORY : RETCODE_SUCCESS;
+        }
+
+        int AsyncProcess(IRequest *request, IPluginCallback *callback) override
+        {
+            return RETCODE_FAILURE;
+        }
+
+        int Prepare(long long transactionId, const DataInfo &inputInfo, DataInfo &outputInfo) override
+        {
+            return RETCODE_SUCCESS;
+        }
+
+        int Release(bool isFullUnload, long long transactionId, const DataInfo &inputInfo) override
+        {
+            return RETCODE_SUCCESS;
+        }
+
+        int SetOption(int optionType, const DataInfo &inputInfo) override
+        {
+            return RETCODE_FAILURE;
+        }
+
+        int GetOption(int optionType, const DataInfo &inputInfo, DataInfo &outputInfo) override
+        {
+            return RETCODE_FAILURE;
+        }
+
+        int processNum = 0;
+    };
+
+    IRequest *CreateRequest(uid_t clientUid, long long deadline)
+    {
+        IRequest *request = IRequest::Create();
+        if (request != nullptr) {
+            request->SetClientUid(clientUid);
+            request->SetDeadline(deadline);
+        }
+        return request;
+    }
+}
+
+class SyncMsgHandlerTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+/**
+ * @tc.name: TestSyncMsgHandler001
+ * @tc.desc: Test a request run on the caller counts against the quota of its client like a queued one.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(SyncMsgHandlerTest, TestSyncMsgHandler001, TestSize.Level0)
+{
+    Queue<Task> queue(QUEUE_CAPACITY);
+    CountingPlugin plugin;
+    SyncMsgHandler handler(queue, &plugin);
+    SimpleEventNotifier<IResponse> notifier(IResponse::Destroy);
+
+    IRequest *queuedRequest = CreateRequest(BUSY_UID, 0);
+    ASSERT_NE(queuedRequest, nullptr);
+    ASSERT_EQ(handler.SendRequest(queuedRequest, notifier), RETCODE_SUCCESS);
+
+    IRequest *busyRequest = CreateRequest(BUSY_UID, 0);
+    ASSERT_NE(busyRequest, nullptr);
+    IResponse *response = nullptr;
+    ASSERT_EQ(handler.ExecuteOnCaller(busyRequest, response), RETCODE_QUEUE_FULL);
+    ASSERT_EQ(response, nullptr);
+    ASSERT_EQ(plugin.processNum, 0);
+
+    IRequest *idleRequest = CreateRequest(IDLE_UID, 0);
+    ASSERT_NE(idleRequest, nullptr);
+    ASSERT_EQ(handler.ExecuteOnCaller(idleRequest, response), RETCODE_SUCCESS);
+    ASSERT_NE(response, nullptr);
+    ASSERT_EQ(response->GetRetCode(), RETCODE_SUCCESS);
+    ASSERT_EQ(plugin.processNum, 1);
+    IResponse::Destroy(response);
+
+    // Processing the queued request gives the busy client its quota back.
+    Task task;
+    ASSERT_EQ(queue.PopFront(task), RETCODE_SUCCESS);
+    ASSERT_EQ(handler.Process(task), RETCODE_SUCCESS);
+    response = nullptr;
+    ASSERT_EQ(handler.ExecuteOnCaller(busyRequest, response), RETCODE_SUCCESS);
+    ASSERT_NE(response, nullptr);
+    IResponse::Destroy(response);
+
+    IRequest::Destroy(queuedRequest);
+    IRequest::Destroy(busyRequest);
+    IRequest::Destroy(idleRequest);
+}
+
+/**
+ * @tc.name: TestSyncMsgHandler002
+ * @tc.desc: Test a request run on the caller past its deadline is answered with a timeout, not processed.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(SyncMsgHandlerTest, TestSyncMsgHandler002, TestSize.Level0)
+{
+    Queue<Task> queue(QUEUE_CAPACITY);
+    CountingPlugin plugin;
+    SyncMsgHandler handler(queue, &plugin);
+
+    IRequest *request = CreateRequest(IDLE_UID, GetSteadyTimeMillSec() - PAST_DEADLINE_MS);
+    ASSERT_NE(request, nullptr);
+    IResponse *response = nullptr;
+    ASSERT_EQ(handler.ExecuteOnCaller(request, response), RETCODE_SYNC_MSG_TIMEOUT);
+    ASSERT_NE(response, nullptr);
+    ASSERT_EQ(response->GetRetCode(), RETCODE_SYNC_MSG_TIMEOUT);
+    ASSERT_EQ(plugin.processNum, 0);
+    IResponse::Destroy(response);
+
+    // The rejected request gave its quota back.
+    request->SetDeadline(0);
+    ASSERT_EQ(handler.ExecuteOnCaller(request, response), RETCODE_SUCCESS);
+    ASSERT_EQ(plugin.processNum, 1);
+    IResponse::Destroy(response);
+    IRequest::Destroy(request);
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "platform/time/include/time.h"
+#include "protocol/data_channel/include/i_request.h"
+#include "protocol/struct_definition/aie_info_define.h"
+#include "server_executor/include/task_scheduler.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const long long NO_DEADLINE = 0;
+    const long long NEAR_DEADLINE_MS = 100;
+    const long long FAR_DEADLINE_MS = 200;
+    const long long PAST_DEADLINE_MS = 1;
+
+    Task CreateTask(int requestId, int priority, long long deadline)
+    {
+        IRequest *request = IRequest::Create();
+        if (request != nullptr) {
+            request->SetRequestId(requestId);
+            request->SetPriority(priority);
+            request->SetDeadline(deadline);
+        }
+        return Task(nullptr, request, nullptr);
+    }
+
+    int PopRequestId(TaskScheduler &scheduler, int minPriority)
+    {
+        Task task;
+        if (!scheduler.Pop(task, minPriority)) {
+            return -1;
+        }
+        int requestId = task.request->GetRequestId();
+        IRequest::Destroy(task.request);
+        return requestId;
+    }
+}
+
+class TaskSchedulerTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+/**
+ * @tc.name: TestTaskScheduler001
+ * @tc.desc: Test tasks are taken by priority class, then earliest deadline first, then in arrival order.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(TaskSchedulerTest, TestTaskScheduler001, TestSize.Level0)
+{
+    long long now = GetSteadyTimeMillSec();
+    TaskScheduler scheduler;
+    ASSERT_TRUE(scheduler.IsEmpty());
+
+    // Pushed in the reverse of the expected order.
+    std::vector<Task> tasks = {
+        CreateTask(0, ALGORITHM_PRIORITY_BACKGROUND, now + NEAR_DEADLINE_MS),
+        CreateTask(1, ALGORITHM_PRIORITY_NORMAL, NO_DEADLINE),
+        CreateTask(2, ALGORITHM_PRIORITY_NORMAL, NO_DEADLINE),
+        CreateTask(3, ALGORITHM_PRIORITY_NORMAL, now + FAR_DEADLINE_MS),
+        CreateTask(4, ALGORITHM_PRIORITY_NORMAL, now + NEAR_DEADLINE_MS),
+        CreateTask(5, ALGORITHM_PRIORITY_REALTIME, NO_DEADLINE),
+        CreateTask(6, ALGORITHM_PRIORITY_REALTIME, now + FAR_DEADLINE_MS),
+    };
+    for (const Task &task : tasks) {
+        ASSERT_NE(task.request, nullptr);
+        scheduler.Push(task);
+    }
+
+    const int expectedIds[] = {6, 5, 4, 3, 1, 2, 0};
+    for (int expectedId : expectedIds) {
+        ASSERT_EQ(PopRequestId(scheduler, ALGORITHM_PRIORITY_BACKGROUND), expectedId);
+    }
+    ASSERT_TRUE(scheduler.IsEmpty());
+    ASSERT_EQ(PopRequestId(scheduler, ALGORITHM_PRIORITY_BACKGROUND), -1);
+}
+
+/**
+ * @tc.name: TestTaskScheduler002
+ * @tc.desc: Test tasks below the minimum priority class stay queued, and the scheduled and expired checks.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NK
+ */
+HWTEST_F(TaskSchedulerTest, TestTaskScheduler002, TestSize.Level0)
+{
+    long long now = GetSteadyTimeMillSec();
+    TaskScheduler scheduler;
+    Task backgroundTask = CreateTask(0, ALGORITHM_PRIORITY_BACKGROUND, NO_DEADLINE);
+    ASSERT_NE(backgroundTask.request, nullptr);
+    ASSERT_TRUE(TaskScheduler::IsScheduled(backgroundTask));
+    ASSERT_FALSE(TaskScheduler::IsExpired(backgroundTask, now));
+    scheduler.Push(backgroundTask);
+    ASSERT_EQ(PopRequestId(scheduler, ALGORITHM_PRIORITY_NORMAL), -1);
+    ASSERT_FALSE(scheduler.IsEmpty());
+    ASSERT_EQ(PopRequestId(scheduler, ALGORITHM_PRIORITY_BACKGROUND), 0);
+
+    Task normalTask = CreateTask(1, ALGORITHM_PRIORITY_NORMAL, NO_DEADLINE);
+    ASSERT_NE(normalTask.request, nullptr);
+    ASSERT_FALSE(TaskScheduler::IsScheduled(normalTask));
+    IRequest::Destroy(normalTask.request);
+
+    Task expiredTask = CreateTask(2, ALGORITHM_PRIORITY_NORMAL, now - PAST_DEADLINE_MS);
+    ASSERT_NE(expiredTask.request, nullptr);
+    ASSERT_TRUE(TaskScheduler::IsScheduled(expiredTask));
+    ASSERT_TRUE(TaskScheduler::IsExpired(expiredTask, now));
+    ASSERT_FALSE(TaskScheduler::IsExpired(expiredTask, now - PAST_DEADLINE_MS));
+    IRequest::Destroy(expiredTask.request);
+}
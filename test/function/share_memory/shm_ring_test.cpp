@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <sys/shm.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "securec.h"
+
+#include "platform/os_wrapper/ipc/include/aie_ipc.h"
+#include "platform/os_wrapper/ipc/include/aie_shm_ring.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "utils/log/aie_log.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+constexpr int SLOT_SIZE = 16 * 1024; // size of one slot of the ring.
+constexpr int SLOT_NUM = 64; // number of slots of the ring.
+constexpr int KWS_FRAME_LENGTH = 8000; // length of a keyword spotting frame, it takes one slot.
+constexpr int IMAGE_LENGTH = 3 * 1024 * 1024; // length of an image larger than the ring.
+constexpr size_t IPC_IO_DATA_SIZE = 256;
+constexpr size_t IPC_IO_OBJECT_NUM = 0;
+constexpr char DUMP_CONTENT = 'r'; // randomly chosen to stuff the payload.
+constexpr int CLIENT_ID = 1; // client the rings of the process are registered for.
+constexpr int SHM_RING_TAG = -2; // written by the sender in place of the shmId of ring data.
+constexpr size_t RING_REQUEST_DATA_SIZE = 2048; // enough for the positions of a ring full of payloads.
+
+/**
+ * Create the ring of the process and register it, as a client and the server do at initialization.
+ */
+int CreateRegisteredShmRing()
+{
+    int retCode = CreateShmRing(getuid());
+    if (retCode != RETCODE_SUCCESS) {
+        return retCode;
+    }
+    AddShmRingClient(CLIENT_ID, getuid());
+    return RegisterShmRing(CLIENT_ID, getuid(), GetShmRingId());
+}
+}
+
+class ShmRingTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+/**
+ * @tc.name: TestShmRing001
+ * @tc.desc: Test payloads written into the ring are read back by an attached receiver, and their slots reused.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NL
+ */
+HWTEST_F(ShmRingTest, TestShmRing001, TestSize.Level0)
+{
+    ShmRing *sender = ShmRing::Create(getuid());
+    ASSERT_NE(sender, nullptr);
+    ShmRing *receiver = ShmRing::Attach(sender->GetShmId(), getuid());
+    ASSERT_NE(receiver, nullptr);
+
+    unsigned char frame[KWS_FRAME_LENGTH];
+    // Several rounds over the whole ring, each frame is released before the next one is written.
+    for (int i = 0; i < SLOT_NUM * 3; ++i) {
+        ASSERT_EQ(memset_s(frame, sizeof(frame), i, sizeof(frame)), EOK);
+        uint32_t offset = 0;
+        ASSERT_TRUE(sender->Write(frame, KWS_FRAME_LENGTH, offset));
+
+        unsigned char *data = nullptr;
+        ASSERT_EQ(receiver->Read(offset, KWS_FRAME_LENGTH, data), RETCODE_SUCCESS);
+        ASSERT_NE(data, nullptr);
+        ASSERT_EQ(memcmp(data, frame, KWS_FRAME_LENGTH), 0);
+        free(data);
+    }
+
+    ASSERT_FALSE(receiver->IsClosed());
+    delete sender;
+    ASSERT_TRUE(receiver->IsClosed());
+    delete receiver;
+}
+
+/**
+ * @tc.name: TestShmRing002
+ * @tc.desc: Test the ring refuses payloads while its slots are taken, and payloads larger than the ring.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NL
+ */
+HWTEST_F(ShmRingTest, TestShmRing002, TestSize.Level0)
+{
+    ShmRing *sender = ShmRing::Create(getuid());
+    ASSERT_NE(sender, nullptr);
+    ShmRing *receiver = ShmRing::Attach(sender->GetShmId(), getuid());
+    ASSERT_NE(receiver, nullptr);
+
+    int length = SLOT_SIZE * SLOT_NUM;
+    unsigned char *payload = reinterpret_cast<unsigned char *>(malloc(length + 1));
+    ASSERT_NE(payload, nullptr);
+    ASSERT_EQ(memset_s(payload, length + 1, DUMP_CONTENT, length + 1), EOK);
+    uint32_t offset = 0;
+    ASSERT_FALSE(sender->Write(payload, length + 1, offset));
+
+    // Fill the ring with unread frames.
+    uint32_t offsets[SLOT_NUM];
+    for (int i = 0; i < SLOT_NUM; ++i) {
+        ASSERT_TRUE(sender->Write(payload, KWS_FRAME_LENGTH, offsets[i]));
+    }
+    ASSERT_FALSE(sender->Write(payload, KWS_FRAME_LENGTH, offset));
+
+    // A frame released out of order does not free the tail, releasing the oldest one does.
+    unsigned char *data = nullptr;
+    ASSERT_EQ(receiver->Read(offsets[1], KWS_FRAME_LENGTH, data), RETCODE_SUCCESS);
+    free(data);
+    ASSERT_FALSE(sender->Write(payload, KWS_FRAME_LENGTH, offset));
+    ASSERT_EQ(receiver->Read(offsets[0], KWS_FRAME_LENGTH, data), RETCODE_SUCCESS);
+    free(data);
+    ASSERT_TRUE(sender->Write(payload, KWS_FRAME_LENGTH, offset));
+    ASSERT_TRUE(sender->Write(payload, KWS_FRAME_LENGTH, offset));
+    ASSERT_FALSE(sender->Write(payload, KWS_FRAME_LENGTH, offset));
+
+    // Out of range positions are refused.
+    ASSERT_NE(receiver->Read(1, KWS_FRAME_LENGTH, data), RETCODE_SUCCESS);
+    ASSERT_NE(receiver->Read(SLOT_SIZE * (SLOT_NUM - 1), SLOT_SIZE + 1, data), RETCODE_SUCCESS);
+
+    free(payload);
+    delete receiver;
+    delete sender;
+}
+
+/**
+ * @tc.name: TestShmRing003
+ * @tc.desc: Test data parceled with the ring of the process is unparceled, and falls back without the ring.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NL
+ */
+HWTEST_F(ShmRingTest, TestShmRing003, TestSize.Level0)
+{
+    unsigned char frame[KWS_FRAME_LENGTH];
+    ASSERT_EQ(memset_s(frame, sizeof(frame), DUMP_CONTENT, sizeof(frame)), EOK);
+    DataInfo inputInfo = {
+        .data = frame,
+        .length = KWS_FRAME_LENGTH,
+    };
+
+    for (int round = 0; round < 2; ++round) {
+        bool isRing = (round == 0);
+        if (isRing) {
+            ASSERT_EQ(CreateRegisteredShmRing(), RETCODE_SUCCESS);
+        } else {
+            DestroyShmRing();
+            RemoveShmRingClient(CLIENT_ID);
+        }
+
+        IpcIo io;
+        char buffer[IPC_IO_DATA_SIZE];
+        IpcIoInit(&io, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+        ParcelDataInfo(&io, &inputInfo, getuid());
+
+        IpcIo reader;
+        IpcIoInit(&reader, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+        DataInfo outputInfo = {
+            .data = nullptr,
+            .length = 0,
+        };
+        ASSERT_EQ(UnParcelClientDataInfo(&reader, &outputInfo, CLIENT_ID, getuid()), RETCODE_SUCCESS);
+        ASSERT_EQ(outputInfo.length, KWS_FRAME_LENGTH);
+        ASSERT_EQ(memcmp(outputInfo.data, frame, KWS_FRAME_LENGTH), 0);
+        FreeDataInfo(&outputInfo);
+        HILOGI("[Test]TestShmRing003 unparceled with ring[%d].", isRing);
+    }
+}
+
+/**
+ * @tc.name: TestShmRing004
+ * @tc.desc: Test payloads lent in place keep their slots until released, and outlive the ring of their sender.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NL
+ */
+HWTEST_F(ShmRingTest, TestShmRing004, TestSize.Level0)
+{
+    ShmRing *sender = ShmRing::Create(getuid());
+    ASSERT_NE(sender, nullptr);
+    ShmRing *receiver = ShmRing::Attach(sender->GetShmId(), getuid());
+    ASSERT_NE(receiver, nullptr);
+
+    unsigned char frame[KWS_FRAME_LENGTH];
+    ASSERT_EQ(memset_s(frame, sizeof(frame), DUMP_CONTENT, sizeof(frame)), EOK);
+    uint32_t offsets[SLOT_NUM];
+    for (int i = 0; i < SLOT_NUM; ++i) {
+        ASSERT_TRUE(sender->Write(frame, KWS_FRAME_LENGTH, offsets[i]));
+        unsigned char *data = nullptr;
+        ASSERT_EQ(receiver->Lend(offsets[i], KWS_FRAME_LENGTH, data), RETCODE_SUCCESS);
+        ASSERT_EQ(memcmp(data, frame, KWS_FRAME_LENGTH), 0);
+    }
+    uint32_t offset = 0;
+    ASSERT_FALSE(sender->Write(frame, KWS_FRAME_LENGTH, offset));
+    receiver->Release(offsets[0], KWS_FRAME_LENGTH);
+    ASSERT_TRUE(sender->Write(frame, KWS_FRAME_LENGTH, offset));
+    delete receiver;
+    delete sender;
+
+    // Data unparceled in place stays readable after the sender destroys its ring and the receiver detaches it.
+    ASSERT_EQ(CreateRegisteredShmRing(), RETCODE_SUCCESS);
+    IpcIo io;
+    char buffer[IPC_IO_DATA_SIZE];
+    IpcIoInit(&io, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    DataInfo inputInfo = {
+        .data = frame,
+        .length = KWS_FRAME_LENGTH,
+    };
+    ParcelDataInfo(&io, &inputInfo, getuid());
+
+    IpcIo reader;
+    IpcIoInit(&reader, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    DataInfo outputInfo = {
+        .data = nullptr,
+        .length = 0,
+    };
+    LentPayload *lent = nullptr;
+    ASSERT_EQ(UnParcelDataInfoInPlace(&reader, &outputInfo, CLIENT_ID, getuid(), &lent), RETCODE_SUCCESS);
+    ASSERT_NE(lent, nullptr);
+    DestroyShmRing();
+    RemoveShmRingClient(CLIENT_ID);
+    ASSERT_EQ(outputInfo.length, KWS_FRAME_LENGTH);
+    ASSERT_EQ(memcmp(outputInfo.data, frame, KWS_FRAME_LENGTH), 0);
+    FreeLentDataInfo(&outputInfo, lent);
+    ASSERT_EQ(outputInfo.data, nullptr);
+}
+
+/**
+ * @tc.name: TestShmRing005
+ * @tc.desc: Test data larger than the ring is transferred at once, and data beyond the transfer limit is refused.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NL
+ */
+HWTEST_F(ShmRingTest, TestShmRing005, TestSize.Level0)
+{
+    ASSERT_EQ(CreateRegisteredShmRing(), RETCODE_SUCCESS);
+    unsigned char *image = reinterpret_cast<unsigned char *>(malloc(AIE_MAX_TRANSFER_SIZE + 1));
+    ASSERT_NE(image, nullptr);
+    ASSERT_EQ(memset_s(image, AIE_MAX_TRANSFER_SIZE + 1, DUMP_CONTENT, AIE_MAX_TRANSFER_SIZE + 1), EOK);
+
+    for (int round = 0; round < 3; ++round) {
+        bool isInPlace = (round == 1);
+        bool isOverLimit = (round == 2);
+        DataInfo inputInfo = {
+            .data = image,
+            .length = isOverLimit ? (AIE_MAX_TRANSFER_SIZE + 1) : IMAGE_LENGTH,
+        };
+        IpcIo io;
+        char buffer[IPC_IO_DATA_SIZE];
+        IpcIoInit(&io, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+        ParcelDataInfo(&io, &inputInfo, getuid());
+
+        IpcIo reader;
+        IpcIoInit(&reader, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+        DataInfo outputInfo = {
+            .data = nullptr,
+            .length = 0,
+        };
+        LentPayload *lent = nullptr;
+        int retCode = isInPlace ? UnParcelDataInfoInPlace(&reader, &outputInfo, CLIENT_ID, getuid(), &lent) :
+            UnParcelClientDataInfo(&reader, &outputInfo, CLIENT_ID, getuid());
+        if (isOverLimit) {
+            ASSERT_NE(retCode, RETCODE_SUCCESS);
+            ASSERT_EQ(lent, nullptr);
+            FreeDataInfo(&outputInfo);
+            continue;
+        }
+        ASSERT_EQ(retCode, RETCODE_SUCCESS);
+        ASSERT_EQ(lent != nullptr, isInPlace);
+        ASSERT_EQ(outputInfo.length, IMAGE_LENGTH);
+        ASSERT_EQ(memcmp(outputInfo.data, image, IMAGE_LENGTH), 0);
+        FreeLentDataInfo(&outputInfo, lent);
+    }
+    free(image);
+    DestroyShmRing();
+    RemoveShmRingClient(CLIENT_ID);
+}
+
+/**
+ * @tc.name: TestShmRing006
+ * @tc.desc: Test ring data is only read from the ring registered once by the uid of its client, and the segment goes
+ *           away once both sides detach it.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NL
+ */
+HWTEST_F(ShmRingTest, TestShmRing006, TestSize.Level0)
+{
+    ShmRing *sender = ShmRing::Create(getuid());
+    ASSERT_NE(sender, nullptr);
+    ASSERT_EQ(ShmRing::Attach(sender->GetShmId(), getuid() + 1), nullptr);
+    delete sender;
+
+    ASSERT_EQ(CreateShmRing(getuid()), RETCODE_SUCCESS);
+    int shmId = GetShmRingId();
+    ASSERT_NE(RegisterShmRing(CLIENT_ID, getuid(), shmId), RETCODE_SUCCESS);
+    AddShmRingClient(CLIENT_ID, getuid());
+    ASSERT_NE(RegisterShmRing(CLIENT_ID, getuid() + 1, shmId), RETCODE_SUCCESS);
+    ASSERT_EQ(RegisterShmRing(CLIENT_ID, getuid(), shmId), RETCODE_SUCCESS);
+    ASSERT_NE(RegisterShmRing(CLIENT_ID, getuid(), shmId), RETCODE_SUCCESS);
+
+    unsigned char frame[KWS_FRAME_LENGTH];
+    ASSERT_EQ(memset_s(frame, sizeof(frame), DUMP_CONTENT, sizeof(frame)), EOK);
+    DataInfo inputInfo = {
+        .data = frame,
+        .length = KWS_FRAME_LENGTH,
+    };
+    // Data of the ring is refused unless the request comes from the client and uid the ring is registered for.
+    for (int round = 0; round < 3; ++round) {
+        IpcIo io;
+        char buffer[IPC_IO_DATA_SIZE];
+        IpcIoInit(&io, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+        ParcelDataInfo(&io, &inputInfo, getuid());
+
+        IpcIo reader;
+        IpcIoInit(&reader, buffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+        DataInfo outputInfo = {
+            .data = nullptr,
+            .length = 0,
+        };
+        int retCode = RETCODE_SUCCESS;
+        if (round == 0) {
+            retCode = UnParcelDataInfo(&reader, &outputInfo);
+        } else if (round == 1) {
+            retCode = UnParcelClientDataInfo(&reader, &outputInfo, CLIENT_ID + 1, getuid());
+        } else {
+            retCode = UnParcelClientDataInfo(&reader, &outputInfo, CLIENT_ID, getuid() + 1);
+        }
+        ASSERT_NE(retCode, RETCODE_SUCCESS);
+        FreeDataInfo(&outputInfo);
+    }
+
+    RemoveShmRingClient(CLIENT_ID);
+    DestroyShmRing();
+    struct shmid_ds shmidDs {};
+    ASSERT_EQ(shmctl(shmId, IPC_STAT, &shmidDs), -1);
+}
+
+/**
+ * @tc.name: TestShmRing007
+ * @tc.desc: Test the slots of ring data are given back when its request fails on either side.
+ * @tc.type: FUNC
+ * @tc.require: AR000F77NL
+ */
+HWTEST_F(ShmRingTest, TestShmRing007, TestSize.Level0)
+{
+    ASSERT_EQ(CreateRegisteredShmRing(), RETCODE_SUCCESS);
+    unsigned char frame[KWS_FRAME_LENGTH];
+    ASSERT_EQ(memset_s(frame, sizeof(frame), DUMP_CONTENT, sizeof(frame)), EOK);
+    DataInfo inputInfo = {
+        .data = frame,
+        .length = KWS_FRAME_LENGTH,
+    };
+
+    // The sender gets back the slots of a request which does not reach the receiver.
+    char buffer[RING_REQUEST_DATA_SIZE];
+    for (int round = 0; round < 2; ++round) {
+        IpcIo io;
+        IpcIoInit(&io, buffer, RING_REQUEST_DATA_SIZE, IPC_IO_OBJECT_NUM);
+        RingPayloads payloads {};
+        for (int i = 0; i < SLOT_NUM; ++i) {
+            ParcelRequestDataInfo(&io, &inputInfo, getuid(), &payloads);
+        }
+        ASSERT_EQ(payloads.num, SLOT_NUM);
+        ReleaseRingPayloads(&payloads);
+        ASSERT_EQ(payloads.num, 0);
+    }
+
+    // The receiver gives back the slots of ring data it refuses.
+    IpcIo io;
+    IpcIoInit(&io, buffer, RING_REQUEST_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    RingPayloads payloads {};
+    for (int i = 0; i < SLOT_NUM; ++i) {
+        ParcelRequestDataInfo(&io, &inputInfo, getuid(), &payloads);
+    }
+    ASSERT_EQ(payloads.num, SLOT_NUM);
+    char invalidBuffer[IPC_IO_DATA_SIZE];
+    IpcIoInit(&io, invalidBuffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    WriteInt32(&io, KWS_FRAME_LENGTH + 1);
+    WriteInt32(&io, SHM_RING_TAG);
+    WriteUint32(&io, payloads.offsets[0]);
+    WriteInt32(&io, KWS_FRAME_LENGTH);
+    IpcIo reader;
+    IpcIoInit(&reader, invalidBuffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    DataInfo outputInfo = {
+        .data = nullptr,
+        .length = 0,
+    };
+    LentPayload *lent = nullptr;
+    ASSERT_NE(UnParcelDataInfoInPlace(&reader, &outputInfo, CLIENT_ID, getuid(), &lent), RETCODE_SUCCESS);
+    ASSERT_EQ(lent, nullptr);
+
+    IpcIoInit(&io, invalidBuffer, IPC_IO_DATA_SIZE, IPC_IO_OBJECT_NUM);
+    RingPayloads nextPayloads {};
+    ParcelRequestDataInfo(&io, &inputInfo, getuid(), &nextPayloads);
+    ASSERT_EQ(nextPayloads.num, 1);
+
+    ReleaseRingPayloads(&payloads);
+    ReleaseRingPayloads(&nextPayloads);
+    DestroyShmRing();
+    RemoveShmRingClient(CLIENT_ID);
+}
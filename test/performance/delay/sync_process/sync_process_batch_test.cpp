@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "client_executor/include/i_aie_client.inl"
+#include "platform/time/include/time_elapser.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "service_dead_cb.h"
+#include "utils/aie_macros.h"
+#include "utils/log/aie_log.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const int REQUEST_ID = 1;
+    const int OPERATE_ID = 2;
+    const long long CLIENT_INFO_VERSION = 1;
+    const int SESSION_ID = -1;
+    const long long ALGORITHM_INFO_CLIENT_VERSION = 1;
+    // sample_plugin_3 advertises batches of 8 and pays a fixed cost per model invocation.
+    const int ALGORITHM_BATCH_TYPE = 5;
+    const long long ALGORITHM_VERSION = 1;
+    const int EXECUTE_TIMES_PER_CLIENT = 200;
+    const int PERCENT_50 = 50;
+    const int PERCENT_99 = 99;
+    const int PERCENT_ALL = 100;
+    const long long MICROSECONDS_PER_SECOND = 1000000;
+    const int CONCURRENT_CLIENT_NUMS[] = {1, 4, 16};
+    const char * const PREPARE_INPUT_SYNC = "Sync prepare inputData";
+    const char * const CONFIG_DESCRIPTION = "Sync batch test";
+    // Coalescing may delay a request by the batch wait time, it must not blow up the tail latency.
+    const long long EXPECTED_SYNC_PROCESS_P99_US = 50000;
+}
+
+class SyncProcessBatchTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+static long long Percentile(std::vector<long long> &samples, int percent)
+{
+    if (samples.empty()) {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t index = samples.size() * percent / PERCENT_ALL;
+    if (index >= samples.size()) {
+        index = samples.size() - 1;
+    }
+    return samples[index];
+}
+
+/**
+ * One client sends sync requests in a loop, and collects the latency of each of them.
+ *
+ * @return Number of failed calls.
+ */
+static int RunClient(std::vector<long long> &latencies)
+{
+    const char *str = PREPARE_INPUT_SYNC;
+    char *inputData = const_cast<char*>(str);
+    int len = strlen(str) + 1;
+
+    ConfigInfo configInfo {.description = CONFIG_DESCRIPTION};
+    ClientInfo clientInfo = {
+        .clientVersion = CLIENT_INFO_VERSION,
+        .clientId = INVALID_CLIENT_ID,
+        .sessionId = SESSION_ID,
+        .serverUid = INVALID_UID,
+        .clientUid = INVALID_UID,
+        .extendLen = len,
+        .extendMsg = reinterpret_cast<unsigned char*>(inputData),
+    };
+
+    AlgorithmInfo algoInfo = {
+        .clientVersion = ALGORITHM_INFO_CLIENT_VERSION,
+        .isAsync = false,
+        .algorithmType = ALGORITHM_BATCH_TYPE,
+        .algorithmVersion = ALGORITHM_VERSION,
+        .isCloud = true,
+        .operateId = OPERATE_ID,
+        .requestId = REQUEST_ID,
+        .extendLen = len,
+        .extendMsg = reinterpret_cast<unsigned char*>(inputData),
+    };
+
+    ServiceDeadCb cb;
+    int resultCode = AieClientInit(configInfo, clientInfo, algoInfo, &cb);
+    if (resultCode != RETCODE_SUCCESS) {
+        return EXECUTE_TIMES_PER_CLIENT;
+    }
+
+    DataInfo inputInfo = {
+        .data = reinterpret_cast<unsigned char*>(inputData),
+        .length = len,
+    };
+    // The prepare output is the handle of the client in the plugin, it is handed back on release.
+    DataInfo handleInfo = {
+        .data = nullptr,
+        .length = 0
+    };
+    resultCode = AieClientPrepare(clientInfo, algoInfo, inputInfo, handleInfo, nullptr);
+    if (resultCode != RETCODE_SUCCESS) {
+        (void)AieClientDestroy(clientInfo);
+        return EXECUTE_TIMES_PER_CLIENT;
+    }
+
+    int failedNum = 0;
+    for (int i = 0; i < EXECUTE_TIMES_PER_CLIENT; ++i) {
+        DataInfo outputInfo = {
+            .data = nullptr,
+            .length = 0
+        };
+        TimeElapser elapser;
+        resultCode = AieClientSyncProcess(clientInfo, algoInfo, inputInfo, outputInfo);
+        latencies.push_back(elapser.ElapseMicro());
+        if (resultCode != RETCODE_SUCCESS) {
+            ++failedNum;
+        }
+        if (outputInfo.data != nullptr) {
+            free(outputInfo.data);
+            outputInfo.data = nullptr;
+        }
+    }
+
+    (void)AieClientRelease(clientInfo, algoInfo, handleInfo);
+    if (handleInfo.data != nullptr) {
+        free(handleInfo.data);
+        handleInfo.data = nullptr;
+    }
+    (void)AieClientDestroy(clientInfo);
+    return failedNum;
+}
+
+/**
+ * @tc.name: TestSyncBatch001
+ * @tc.desc: Test throughput and p50/p99 latency of Sync Process Interface with growing number of concurrent
+ *           clients, so that sync requests of the batched sample plugin are coalesced.
+ * @tc.type: PERF
+ * @tc.require: AR000F77MI
+ */
+HWTEST_F(SyncProcessBatchTest, TestSyncBatch001, TestSize.Level0)
+{
+    HILOGI("[Test]SyncProcessBatchTest001.");
+    for (int clientNum : CONCURRENT_CLIENT_NUMS) {
+        std::mutex latencyMutex;
+        std::vector<long long> latencies;
+        std::atomic<int> failedNum(0);
+
+        TimeElapser elapser;
+        std::vector<std::thread> clients;
+        for (int i = 0; i < clientNum; ++i) {
+            clients.emplace_back([&latencyMutex, &latencies, &failedNum]() {
+                std::vector<long long> clientLatencies;
+                clientLatencies.reserve(EXECUTE_TIMES_PER_CLIENT);
+                failedNum += RunClient(clientLatencies);
+                std::lock_guard<std::mutex> lock(latencyMutex);
+                latencies.insert(latencies.end(), clientLatencies.begin(), clientLatencies.end());
+            });
+        }
+        for (auto &client : clients) {
+            client.join();
+        }
+        long long elapsed = elapser.ElapseMicro();
+
+        ASSERT_EQ(failedNum, 0);
+        ASSERT_GT(elapsed, 0);
+        long long throughput = static_cast<long long>(latencies.size()) * MICROSECONDS_PER_SECOND / elapsed;
+        long long p50 = Percentile(latencies, PERCENT_50);
+        long long p99 = Percentile(latencies, PERCENT_99);
+        HILOGI("[Test][CheckBatchSyncProcess][%d]clients, throughput[%lld]/s, p50[%lld]us, p99[%lld]us",
+            clientNum, throughput, p50, p99);
+        ASSERT_TRUE(p99 <= EXPECTED_SYNC_PROCESS_P99_US);
+    }
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "client_executor/include/i_aie_client.inl"
+#include "platform/time/include/time_elapser.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "service_dead_cb.h"
+#include "utils/aie_macros.h"
+#include "utils/log/aie_log.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const int REQUEST_ID = 1;
+    const int OPERATE_ID = 2;
+    const long long CLIENT_INFO_VERSION = 1;
+    const int SESSION_ID = -1;
+    const long long ALGORITHM_INFO_CLIENT_VERSION = 1;
+    const int ALGORITHM_SYNC_TYPE = 0;
+    const long long ALGORITHM_VERSION = 1;
+    const int EXECUTE_TIMES = 1000;
+    const int PERCENT_50 = 50;
+    const int PERCENT_99 = 99;
+    const int PERCENT_ALL = 100;
+    const char * const PREPARE_INPUT_SYNC = "Sync prepare inputData";
+    const char * const CONFIG_DESCRIPTION = "Sync caller runs test";
+    const long long EXPECTED_SYNC_PROCESS_P50_US = 5000;
+    const long long EXPECTED_SYNC_PROCESS_P99_US = 30000;
+}
+
+class SyncProcessCallerRunsTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+static long long Percentile(std::vector<long long> &samples, int percent)
+{
+    if (samples.empty()) {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t index = samples.size() * percent / PERCENT_ALL;
+    if (index >= samples.size()) {
+        index = samples.size() - 1;
+    }
+    return samples[index];
+}
+
+class SyncClient {
+public:
+    SyncClient()
+    {
+        const char *str = PREPARE_INPUT_SYNC;
+        inputData_ = const_cast<char*>(str);
+        int len = strlen(str) + 1;
+        clientInfo_ = {
+            .clientVersion = CLIENT_INFO_VERSION,
+            .clientId = INVALID_CLIENT_ID,
+            .sessionId = SESSION_ID,
+            .serverUid = INVALID_UID,
+            .clientUid = INVALID_UID,
+            .extendLen = len,
+            .extendMsg = reinterpret_cast<unsigned char*>(inputData_),
+        };
+        algoInfo_ = {
+            .clientVersion = ALGORITHM_INFO_CLIENT_VERSION,
+            .isAsync = false,
+            .algorithmType = ALGORITHM_SYNC_TYPE,
+            .algorithmVersion = ALGORITHM_VERSION,
+            .isCloud = true,
+            .operateId = OPERATE_ID,
+            .requestId = REQUEST_ID,
+            .extendLen = len,
+            .extendMsg = reinterpret_cast<unsigned char*>(inputData_),
+        };
+        inputInfo_ = {
+            .data = reinterpret_cast<unsigned char*>(inputData_),
+            .length = len,
+        };
+    }
+
+    ~SyncClient() = default;
+
+    int Start()
+    {
+        ConfigInfo configInfo {.description = CONFIG_DESCRIPTION};
+        int resultCode = AieClientInit(configInfo, clientInfo_, algoInfo_, &cb_);
+        CHK_RET(resultCode != RETCODE_SUCCESS, resultCode);
+
+        DataInfo outputInfo = {
+            .data = nullptr,
+            .length = 0
+        };
+        resultCode = AieClientPrepare(clientInfo_, algoInfo_, inputInfo_, outputInfo, nullptr);
+        FreeOutput(outputInfo);
+        if (resultCode != RETCODE_SUCCESS) {
+            (void)AieClientDestroy(clientInfo_);
+        }
+        return resultCode;
+    }
+
+    int Process()
+    {
+        DataInfo outputInfo = {
+            .data = nullptr,
+            .length = 0
+        };
+        int resultCode = AieClientSyncProcess(clientInfo_, algoInfo_, inputInfo_, outputInfo);
+        FreeOutput(outputInfo);
+        return resultCode;
+    }
+
+    void Stop()
+    {
+        (void)AieClientRelease(clientInfo_, algoInfo_, inputInfo_);
+        (void)AieClientDestroy(clientInfo_);
+    }
+
+private:
+    static void FreeOutput(DataInfo &outputInfo)
+    {
+        if (outputInfo.data != nullptr) {
+            free(outputInfo.data);
+            outputInfo.data = nullptr;
+        }
+    }
+
+    char *inputData_;
+    ClientInfo clientInfo_;
+    AlgorithmInfo algoInfo_;
+    DataInfo inputInfo_;
+    ServiceDeadCb cb_;
+};
+
+static int MeasureLatency(SyncClient &client, std::vector<long long> &latencies)
+{
+    int failedNum = 0;
+    latencies.clear();
+    latencies.reserve(EXECUTE_TIMES);
+    for (int i = 0; i < EXECUTE_TIMES; ++i) {
+        TimeElapser elapser;
+        int resultCode = client.Process();
+        latencies.push_back(elapser.ElapseMicro());
+        if (resultCode != RETCODE_SUCCESS) {
+            ++failedNum;
+        }
+    }
+    return failedNum;
+}
+
+/**
+ * @tc.name: TestSyncCallerRuns001
+ * @tc.desc: Test p50/p99 latency of Sync Process Interface on the sample plugin, first on an idle engine where
+ *           the request may run on the calling thread, then with another client keeping the engine busy so that
+ *           requests go through the engine queue.
+ * @tc.type: PERF
+ * @tc.require: AR000F77MI
+ */
+HWTEST_F(SyncProcessCallerRunsTest, TestSyncCallerRuns001, TestSize.Level0)
+{
+    HILOGI("[Test]SyncProcessCallerRunsTest001.");
+    SyncClient client;
+    ASSERT_EQ(client.Start(), RETCODE_SUCCESS);
+
+    std::vector<long long> latencies;
+    int failedNum = MeasureLatency(client, latencies);
+    long long idleP50 = Percentile(latencies, PERCENT_50);
+    long long idleP99 = Percentile(latencies, PERCENT_99);
+
+    SyncClient busyClient;
+    ASSERT_EQ(busyClient.Start(), RETCODE_SUCCESS);
+    std::atomic<bool> stopped(false);
+    std::thread busyThread([&busyClient, &stopped]() {
+        while (!stopped) {
+            (void)busyClient.Process();
+        }
+    });
+    failedNum += MeasureLatency(client, latencies);
+    stopped = true;
+    busyThread.join();
+    long long busyP50 = Percentile(latencies, PERCENT_50);
+    long long busyP99 = Percentile(latencies, PERCENT_99);
+
+    busyClient.Stop();
+    client.Stop();
+
+    HILOGI("[Test][CheckCallerRunsSyncProcess]idle p50[%lld]us p99[%lld]us, busy p50[%lld]us p99[%lld]us",
+        idleP50, idleP99, busyP50, busyP99);
+    ASSERT_EQ(failedNum, 0);
+    ASSERT_TRUE((idleP50 > 0) && (idleP50 <= EXPECTED_SYNC_PROCESS_P50_US));
+    ASSERT_TRUE(idleP99 <= EXPECTED_SYNC_PROCESS_P99_US);
+    ASSERT_TRUE(busyP99 <= EXPECTED_SYNC_PROCESS_P99_US);
+}
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "client_executor/include/i_aie_client.inl"
+#include "platform/queuepool/queue.h"
+#include "platform/time/include/time.h"
+#include "platform/time/include/time_elapser.h"
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "service_dead_cb.h"
+#include "utils/aie_macros.h"
+#include "utils/log/aie_log.h"
+
+using namespace OHOS::AI;
+using namespace testing::ext;
+
+namespace {
+    const int REQUEST_ID = 1;
+    const int OPERATE_ID = 2;
+    const long long CLIENT_INFO_VERSION = 1;
+    const int SESSION_ID = -1;
+    const long long ALGORITHM_INFO_CLIENT_VERSION = 1;
+    const int ALGORITHM_SYNC_TYPE = 0;
+    const long long ALGORITHM_VERSION = 1;
+    const int EXECUTE_TIMES = 1000;
+    const int PERCENT_50 = 50;
+    const int PERCENT_90 = 90;
+    const int PERCENT_99 = 99;
+    const int PERCENT_ALL = 100;
+    const int IDLE_TIME_MS = 3000;
+    const char * const PREPARE_INPUT_SYNC = "Sync prepare inputData";
+    const char * const CONFIG_DESCRIPTION = "Sync latency test";
+    const char * const SERVER_PROCESS_NAME = "ai_server";
+    const char * const PROC_DIR = "/proc";
+    const int PROC_STAT_UTIME_INDEX = 13;
+    const int PROC_STAT_STIME_INDEX = 14;
+    const long long EXPECTED_SYNC_PROCESS_P50_US = 5000;
+    const long long EXPECTED_SYNC_PROCESS_P99_US = 30000;
+    // The engine worker used to poll every 1 ms, an idle server must now stay well below one tick per 100 ms.
+    const long long EXPECTED_IDLE_CPU_TICKS = IDLE_TIME_MS / 100;
+    const long long INVALID_CPU_TICKS = -1;
+    const int WAKEUP_TIMES = 500;
+    const int WAKEUP_QUEUE_SIZE = 16;
+    const int WAKEUP_TIME_OUT_MS = 1000;
+    const int WAKEUP_PUSH_INTERVAL_MS = 2;
+    // Polling every 1 ms finds a task half a tick after it is pushed at the median, and a full tick at worst.
+    // A consumer woken up on push must stay well below both.
+    const long long EXPECTED_WAKEUP_P50_US = 200;
+    const long long EXPECTED_WAKEUP_P90_US = 500;
+}
+
+class SyncProcessLatencyTest : public testing::Test {
+public:
+    // SetUpTestCase:The preset action of the test suite is executed before the first TestCase
+    static void SetUpTestCase() {};
+
+    // TearDownTestCase:The test suite cleanup action is executed after the last TestCase
+    static void TearDownTestCase() {};
+
+    // SetUp:Execute before each test case
+    void SetUp() {};
+
+    // TearDown:Execute after each test case
+    void TearDown() {};
+};
+
+static long long Percentile(std::vector<long long> &samples, int percent)
+{
+    if (samples.empty()) {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t index = samples.size() * percent / PERCENT_ALL;
+    if (index >= samples.size()) {
+        index = samples.size() - 1;
+    }
+    return samples[index];
+}
+
+static long long GetSteadyTimeMicro()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static long long GetServerCpuTicks()
+{
+    DIR *dir = opendir(PROC_DIR);
+    if (dir == nullptr) {
+        return INVALID_CPU_TICKS;
+    }
+    long long cpuTicks = INVALID_CPU_TICKS;
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        std::string pid = entry->d_name;
+        if (pid.empty() || !std::all_of(pid.begin(), pid.end(), ::isdigit)) {
+            continue;
+        }
+        std::ifstream commFile(std::string(PROC_DIR) + "/" + pid + "/comm");
+        std::string comm;
+        if (!std::getline(commFile, comm) || comm != SERVER_PROCESS_NAME) {
+            continue;
+        }
+        std::ifstream statFile(std::string(PROC_DIR) + "/" + pid + "/stat");
+        std::string stat;
+        std::getline(statFile, stat);
+        // Fields after the command name, which is wrapped in parentheses and may contain spaces.
+        size_t pos = stat.rfind(')');
+        if (pos == std::string::npos) {
+            break;
+        }
+        std::istringstream fields(stat.substr(pos + 1));
+        std::string field;
+        long long utime = 0;
+        long long stime = 0;
+        // The first field after the command name is the third field of stat.
+        for (int i = 2; fields >> field; ++i) {
+            if (i == PROC_STAT_UTIME_INDEX) {
+                utime = std::stoll(field);
+            } else if (i == PROC_STAT_STIME_INDEX) {
+                stime = std::stoll(field);
+                break;
+            }
+        }
+        cpuTicks = utime + stime;
+        break;
+    }
+    (void)closedir(dir);
+    return cpuTicks;
+}
+
+/**
+ * @tc.name: TestSyncLatency001
+ * @tc.desc: Test p50/p99 latency of Sync Process Interface and idle CPU of AI server with a loaded engine.
+ * @tc.type: PERF
+ * @tc.require: AR000F77MI
+ */
+HWTEST_F(SyncProcessLatencyTest, TestSyncLatency001, TestSize.Level0)
+{
+    HILOGI("[Test]SyncProcessLatencyTest001.");
+    const char *str = PREPARE_INPUT_SYNC;
+    char *inputData = const_cast<char*>(str);
+    int len = strlen(str) + 1;
+
+    ConfigInfo configInfo {.description = CONFIG_DESCRIPTION};
+    ClientInfo clientInfo = {
+        .clientVersion = CLIENT_INFO_VERSION,
+        .clientId = INVALID_CLIENT_ID,
+        .sessionId = SESSION_ID,
+        .serverUid = INVALID_UID,
+        .clientUid = INVALID_UID,
+        .extendLen = len,
+        .extendMsg = reinterpret_cast<unsigned char*>(inputData),
+    };
+
+    AlgorithmInfo algoInfo = {
+        .clientVersion = ALGORITHM_INFO_CLIENT_VERSION,
+        .isAsync = false,
+        .algorithmType = ALGORITHM_SYNC_TYPE,
+        .algorithmVersion = ALGORITHM_VERSION,
+        .isCloud = true,
+        .operateId = OPERATE_ID,
+        .requestId = REQUEST_ID,
+        .extendLen = len,
+        .extendMsg = reinterpret_cast<unsigned char*>(inputData),
+    };
+
+    ServiceDeadCb *cb = nullptr;
+    AIE_NEW(cb, ServiceDeadCb());
+    ASSERT_NE(cb, nullptr);
+    int resultCode = AieClientInit(configInfo, clientInfo, algoInfo, cb);
+    ASSERT_EQ(resultCode, RETCODE_SUCCESS);
+
+    DataInfo inputInfo = {
+        .data = reinterpret_cast<unsigned char*>(inputData),
+        .length = len,
+    };
+    DataInfo outputInfo;
+    resultCode = AieClientPrepare(clientInfo, algoInfo, inputInfo, outputInfo, nullptr);
+    ASSERT_EQ(resultCode, RETCODE_SUCCESS);
+
+    std::vector<long long> latencies;
+    latencies.reserve(EXECUTE_TIMES);
+    for (int i = 0; i < EXECUTE_TIMES; ++i) {
+        outputInfo = {
+            .data = nullptr,
+            .length = 0
+        };
+        TimeElapser elapser;
+        resultCode = AieClientSyncProcess(clientInfo, algoInfo, inputInfo, outputInfo);
+        latencies.push_back(elapser.ElapseMicro());
+        ASSERT_EQ(resultCode, RETCODE_SUCCESS);
+        if (outputInfo.data != nullptr) {
+            free(outputInfo.data);
+            outputInfo.data = nullptr;
+        }
+    }
+    long long p50 = Percentile(latencies, PERCENT_50);
+    long long p99 = Percentile(latencies, PERCENT_99);
+    HILOGI("[Test][CheckLatencySyncProcess]p50[%lld]us, p99[%lld]us", p50, p99);
+
+    // The engine stays loaded while the client is idle, so its worker thread must not spin.
+    long long idleStartTicks = GetServerCpuTicks();
+    StepSleepMs(IDLE_TIME_MS);
+    long long idleEndTicks = GetServerCpuTicks();
+
+    resultCode = AieClientRelease(clientInfo, algoInfo, inputInfo);
+    ASSERT_EQ(resultCode, RETCODE_SUCCESS);
+    resultCode = AieClientDestroy(clientInfo);
+    ASSERT_EQ(resultCode, RETCODE_SUCCESS);
+    AIE_DELETE(cb);
+
+    ASSERT_TRUE((p50 > 0) && (p50 <= EXPECTED_SYNC_PROCESS_P50_US));
+    ASSERT_TRUE(p99 <= EXPECTED_SYNC_PROCESS_P99_US);
+    if (idleStartTicks == INVALID_CPU_TICKS || idleEndTicks == INVALID_CPU_TICKS) {
+        HILOGW("[Test]Process %s is not found, skip idle CPU check.", SERVER_PROCESS_NAME);
+        return;
+    }
+    HILOGI("[Test][CheckIdleCpu][%lld]ticks in %dms", idleEndTicks - idleStartTicks, IDLE_TIME_MS);
+    ASSERT_TRUE(idleEndTicks - idleStartTicks <= EXPECTED_IDLE_CPU_TICKS);
+}
+
+/**
+ * @tc.name: TestSyncLatency002
+ * @tc.desc: Test wakeup latency of the engine task queue: a consumer blocked on the empty queue must get a pushed
+ *           task well within the time a 1 ms sleep-polling consumer would take.
+ * @tc.type: PERF
+ * @tc.require: AR000F77MI
+ */
+HWTEST_F(SyncProcessLatencyTest, TestSyncLatency002, TestSize.Level0)
+{
+    HILOGI("[Test]SyncProcessLatencyTest002.");
+    Queue<long long> queue(WAKEUP_QUEUE_SIZE);
+    std::vector<long long> latencies;
+    latencies.reserve(WAKEUP_TIMES);
+    std::thread consumer([&queue, &latencies]() {
+        for (int i = 0; i < WAKEUP_TIMES; ++i) {
+            long long pushTime = 0;
+            if (queue.PopFront(pushTime, WAKEUP_TIME_OUT_MS) != RETCODE_SUCCESS) {
+                continue;
+            }
+            latencies.push_back(GetSteadyTimeMicro() - pushTime);
+        }
+    });
+    for (int i = 0; i < WAKEUP_TIMES; ++i) {
+        // Give the consumer time to block on the empty queue before every push.
+        StepSleepMs(WAKEUP_PUSH_INTERVAL_MS);
+        long long pushTime = GetSteadyTimeMicro();
+        ASSERT_EQ(queue.PushBack(pushTime), RETCODE_SUCCESS);
+    }
+    consumer.join();
+
+    ASSERT_EQ(latencies.size(), static_cast<size_t>(WAKEUP_TIMES));
+    long long p50 = Percentile(latencies, PERCENT_50);
+    long long p90 = Percentile(latencies, PERCENT_90);
+    HILOGI("[Test][CheckWakeupLatency]p50[%lld]us, p90[%lld]us", p50, p90);
+    ASSERT_TRUE(p50 <= EXPECTED_WAKEUP_P50_US);
+    ASSERT_TRUE(p90 <= EXPECTED_WAKEUP_P90_US);
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sample/include/sample_plugin_3.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "securec.h"
+
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "utils/log/aie_log.h"
+
+namespace OHOS {
+namespace AI {
+namespace {
+constexpr long long ALG_VERSION = 1;
+const char *ALG_NAME = "SAMPLE_PLUGIN_3";
+const char * const PLUGIN_INFER_MODEL = "SYNC";
+const char * const DEFAULT_PROCESS_STRING = "sample_plugin_3 SyncProcess default data";
+const size_t MAX_BATCH_SIZE = 8;
+// The model holds no per-request state, so requests may be processed concurrently.
+const size_t WORKER_NUM = 2;
+// Fixed cost of one model invocation whatever its batch size, as launching an inference on an NPU.
+const int INVOKE_OVERHEAD_US = 500;
+// Get the number of prepare calls and of handles not released yet, as two ints.
+const int OPTION_GET_HANDLE_STATS = 1001;
+
+void FreeDataInfo(DataInfo *dataInfo)
+{
+    if (dataInfo != nullptr && dataInfo->data != nullptr) {
+        free(dataInfo->data);
+        dataInfo->data = nullptr;
+        dataInfo->length = 0;
+    }
+}
+
+DataInfo GetModelInput(IRequest *request)
+{
+    DataInfo inputInfo = request->GetMsg();
+    if (inputInfo.data == nullptr) {
+        inputInfo.data = reinterpret_cast<unsigned char*>(const_cast<char*>(DEFAULT_PROCESS_STRING));
+        inputInfo.length = strlen(DEFAULT_PROCESS_STRING) + 1;
+    }
+    return inputInfo;
+}
+
+bool IsValidInput(IRequest *request)
+{
+    DataInfo inputInfo = request->GetMsg();
+    return inputInfo.data == nullptr || inputInfo.length > 0;
+}
+
+/**
+ * Run the model on a batch of inputs packed one after another, it echoes them as the outputs.
+ */
+void InvokeModel(unsigned char *batchData, size_t batchLength)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(INVOKE_OVERHEAD_US));
+}
+
+/**
+ * Set the output of the request from its slice of the batch output.
+ */
+int SetResponseResult(IResponse *response, const unsigned char *batchData, const DataInfo &inputInfo)
+{
+    DataInfo outputInfo = {
+        .data = reinterpret_cast<unsigned char*>(malloc(inputInfo.length)),
+        .length = inputInfo.length,
+    };
+    if (outputInfo.data == nullptr) {
+        HILOGE("[SamplePlugin3]malloc failed.");
+        return RETCODE_FAILURE;
+    }
+    errno_t retCode = memcpy_s(outputInfo.data, outputInfo.length, batchData, inputInfo.length);
+    if (retCode != EOK) {
+        HILOGE("[SamplePlugin3]memcpy_s failed[%d].", retCode);
+        FreeDataInfo(&outputInfo);
+        return RETCODE_FAILURE;
+    }
+    response->SetResult(outputInfo);
+    return RETCODE_SUCCESS;
+}
+} // anonymous namespace
+
+SamplePlugin3::SamplePlugin3() : prepareNum_(0)
+{
+}
+
+SamplePlugin3::~SamplePlugin3() = default;
+
+const long long SamplePlugin3::GetVersion() const
+{
+    return ALG_VERSION;
+}
+
+const char *SamplePlugin3::GetName() const
+{
+    return ALG_NAME;
+}
+
+const char *SamplePlugin3::GetInferMode() const
+{
+    return PLUGIN_INFER_MODEL;
+}
+
+int SamplePlugin3::SyncProcess(IRequest *request, IResponse *&response)
+{
+    IResponse *responses[] = {nullptr};
+    int retCode = SyncProcessBatch(&request, 1, responses);
+    response = responses[0];
+    return retCode;
+}
+
+size_t SamplePlugin3::GetWorkerNum() const
+{
+    return WORKER_NUM;
+}
+
+size_t SamplePlugin3::GetMaxBatchSize() const
+{
+    return MAX_BATCH_SIZE;
+}
+
+int SamplePlugin3::SyncProcessBatch(IRequest **requests, size_t num, IResponse **responses)
+{
+    CHK_RET(requests == nullptr || responses == nullptr, RETCODE_FAILURE);
+    if (num == 0 || num > MAX_BATCH_SIZE) {
+        HILOGE("[SamplePlugin3]Batch size[%zu] is invalid.", num);
+        return RETCODE_FAILURE;
+    }
+
+    // Each request gets its own response, an invalid one does not fail the others.
+    int retCode = RETCODE_SUCCESS;
+    size_t batchLength = 0;
+    for (size_t i = 0; i < num; ++i) {
+        responses[i] = IResponse::Create(requests[i]);
+        CHK_RET(responses[i] == nullptr, RETCODE_FAILURE);
+        if (!IsValidInput(requests[i])) {
+            HILOGE("[SamplePlugin3]inputInfo data is invalid.");
+            responses[i]->SetRetCode(RETCODE_FAILURE);
+            retCode = RETCODE_FAILURE;
+            continue;
+        }
+        batchLength += GetModelInput(requests[i]).length;
+    }
+    CHK_RET(batchLength == 0, retCode);
+
+    // Pack the valid inputs into one buffer, so that the model runs once for the whole batch.
+    unsigned char *batchData = reinterpret_cast<unsigned char*>(malloc(batchLength));
+    CHK_RET(batchData == nullptr, RETCODE_FAILURE);
+    size_t offset = 0;
+    for (size_t i = 0; i < num; ++i) {
+        if (!IsValidInput(requests[i])) {
+            continue;
+        }
+        DataInfo inputInfo = GetModelInput(requests[i]);
+        if (memcpy_s(batchData + offset, batchLength - offset, inputInfo.data, inputInfo.length) != EOK) {
+            HILOGE("[SamplePlugin3]Failed to pack the batch.");
+            free(batchData);
+            return RETCODE_FAILURE;
+        }
+        offset += inputInfo.length;
+    }
+
+    InvokeModel(batchData, batchLength);
+
+    offset = 0;
+    for (size_t i = 0; i < num; ++i) {
+        if (!IsValidInput(requests[i])) {
+            continue;
+        }
+        DataInfo inputInfo = GetModelInput(requests[i]);
+        int resultRetCode = SetResponseResult(responses[i], batchData + offset, inputInfo);
+        responses[i]->SetRetCode(resultRetCode);
+        if (resultRetCode != RETCODE_SUCCESS) {
+            retCode = resultRetCode;
+        }
+        offset += inputInfo.length;
+    }
+    free(batchData);
+    return retCode;
+}
+
+int SamplePlugin3::AsyncProcess(IRequest *request, IPluginCallback *callback)
+{
+    HILOGE("[SamplePlugin3]Sync plugin, can't run AsyncProcess.");
+    return RETCODE_FAILURE;
+}
+
+int SamplePlugin3::Prepare(long long transactionId, const DataInfo &inputInfo, DataInfo &outputInfo)
+{
+    // The output is a handle, as a real plugin returns its model handle, which release takes back.
+    outputInfo.data = reinterpret_cast<unsigned char*>(malloc(sizeof(int)));
+    if (outputInfo.data == nullptr) {
+        HILOGE("[SamplePlugin3]malloc failed.");
+        outputInfo.length = 0;
+        return RETCODE_FAILURE;
+    }
+    outputInfo.length = sizeof(int);
+    std::lock_guard<std::mutex> lock(mutex_);
+    int handle = ++prepareNum_;
+    (void)memcpy_s(outputInfo.data, outputInfo.length, &handle, sizeof(handle));
+    handles_.insert(handle);
+    return RETCODE_SUCCESS;
+}
+
+int SamplePlugin3::Release(bool isFullUnload, long long transactionId, const DataInfo &inputInfo)
+{
+    if (inputInfo.data == nullptr || inputInfo.length != static_cast<int>(sizeof(int))) {
+        HILOGE("[SamplePlugin3]Release input is not a prepare output.");
+        return RETCODE_FAILURE;
+    }
+    int handle = 0;
+    (void)memcpy_s(&handle, sizeof(handle), inputInfo.data, inputInfo.length);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (handles_.erase(handle) == 0) {
+        HILOGE("[SamplePlugin3]Unknown handle %d.", handle);
+        return RETCODE_FAILURE;
+    }
+    return RETCODE_SUCCESS;
+}
+
+int SamplePlugin3::SetOption(int optionType, const DataInfo &inputInfo)
+{
+    HILOGE("[SamplePlugin3]No option is supported.");
+    return RETCODE_FAILURE;
+}
+
+int SamplePlugin3::GetOption(int optionType, const DataInfo &inputInfo, DataInfo &outputInfo)
+{
+    if (optionType != OPTION_GET_HANDLE_STATS) {
+        HILOGE("[SamplePlugin3]Option %d is not supported.", optionType);
+        return RETCODE_FAILURE;
+    }
+    const size_t statNum = 2;
+    outputInfo.data = reinterpret_cast<unsigned char*>(malloc(sizeof(int) * statNum));
+    if (outputInfo.data == nullptr) {
+        HILOGE("[SamplePlugin3]malloc failed.");
+        outputInfo.length = 0;
+        return RETCODE_FAILURE;
+    }
+    outputInfo.length = sizeof(int) * statNum;
+    std::lock_guard<std::mutex> lock(mutex_);
+    int stats[statNum] = {prepareNum_, static_cast<int>(handles_.size())};
+    (void)memcpy_s(outputInfo.data, outputInfo.length, stats, sizeof(stats));
+    return RETCODE_SUCCESS;
+}
+
+bool SamplePlugin3::IsPreloadPrepareSupported() const
+{
+    return true;
+}
+
+PLUGIN_INTERFACE_IMPL(SamplePlugin3);
+}
+}
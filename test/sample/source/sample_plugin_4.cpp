@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sample/include/sample_plugin_4.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "securec.h"
+
+#include "protocol/retcode_inner/aie_retcode_inner.h"
+#include "utils/log/aie_log.h"
+
+namespace OHOS {
+namespace AI {
+namespace {
+constexpr long long ALG_VERSION = 1;
+const char *ALG_NAME = "SAMPLE_PLUGIN_4";
+const char * const PLUGIN_INFER_MODEL = "SYNC";
+// Simulates a plugin loading a large model when it is created.
+const int LOAD_TIME_MS = 500;
+
+int CopyData(const DataInfo &inputInfo, DataInfo &outputInfo)
+{
+    if (inputInfo.data == nullptr || inputInfo.length <= 0) {
+        outputInfo = {};
+        return RETCODE_SUCCESS;
+    }
+    outputInfo.length = inputInfo.length;
+    outputInfo.data = reinterpret_cast<unsigned char*>(malloc(inputInfo.length));
+    if (outputInfo.data == nullptr) {
+        HILOGE("[SamplePlugin4]malloc failed.");
+        return RETCODE_FAILURE;
+    }
+    errno_t retCode = memcpy_s(outputInfo.data, outputInfo.length, inputInfo.data, inputInfo.length);
+    if (retCode != EOK) {
+        HILOGE("[SamplePlugin4]memcpy_s failed[%d].", retCode);
+        free(outputInfo.data);
+        outputInfo = {};
+        return RETCODE_FAILURE;
+    }
+    return RETCODE_SUCCESS;
+}
+} // anonymous namespace
+
+SamplePlugin4::SamplePlugin4()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(LOAD_TIME_MS));
+}
+
+SamplePlugin4::~SamplePlugin4() = default;
+
+const long long SamplePlugin4::GetVersion() const
+{
+    return ALG_VERSION;
+}
+
+const char *SamplePlugin4::GetName() const
+{
+    return ALG_NAME;
+}
+
+const char *SamplePlugin4::GetInferMode() const
+{
+    return PLUGIN_INFER_MODEL;
+}
+
+int SamplePlugin4::SyncProcess(IRequest *request, IResponse *&response)
+{
+    response = IResponse::Create(request);
+    CHK_RET(response == nullptr, RETCODE_FAILURE);
+
+    DataInfo outputInfo {};
+    int retCode = CopyData(request->GetMsg(), outputInfo);
+    response->SetResult(outputInfo);
+    response->SetRetCode(retCode);
+    return retCode;
+}
+
+int SamplePlugin4::AsyncProcess(IRequest *request, IPluginCallback *callback)
+{
+    HILOGE("[SamplePlugin4]Sync plugin, can't run AsyncProcess.");
+    return RETCODE_FAILURE;
+}
+
+int SamplePlugin4::Prepare(long long transactionId, const DataInfo &inputInfo, DataInfo &outputInfo)
+{
+    return CopyData(inputInfo, outputInfo);
+}
+
+int SamplePlugin4::Release(bool isFullUnload, long long transactionId, const DataInfo &inputInfo)
+{
+    return RETCODE_SUCCESS;
+}
+
+int SamplePlugin4::SetOption(int optionType, const DataInfo &inputInfo)
+{
+    return RETCODE_SUCCESS;
+}
+
+int SamplePlugin4::GetOption(int optionType, const DataInfo &inputInfo, DataInfo &outputInfo)
+{
+    outputInfo = {};
+    return RETCODE_SUCCESS;
+}
+
+PLUGIN_INTERFACE_IMPL(SamplePlugin4);
+}
+}